@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# Decodes the binary log written by src/logger/binary_log.cpp into the same text format as cout.log.
+# Usage: decode_binary_log.py cout.ylog [-o cout.txt]
+
+import argparse
+import datetime
+import struct
+import sys
+
+MAGIC = 0x00474F4C4D4959
+VERSION = 1
+
+HEADER = struct.Struct("<QIIIIQQQq")
+STRING = struct.Struct("<IBBHI")
+RECORD = struct.Struct("<IHBBqII")
+
+KIND_LOCATION = 1
+KIND_STREAM = 2
+
+RECORD_PADDING = 0
+RECORD_MESSAGE = 1
+
+LEVELS = ["DEBUG", "INFO", "WARN", "FATAL"]
+
+
+def read_strings(data, offset, used):
+    locations = {}
+    streams = {}
+
+    end = offset + used
+    while offset + STRING.size <= end:
+        string_id, kind, _, length, line = STRING.unpack_from(data, offset)
+        text = data[offset + STRING.size:offset + STRING.size + length].decode("utf-8", "replace")
+        if kind == KIND_LOCATION:
+            locations[string_id] = f"{text}:{line}"
+        elif kind == KIND_STREAM:
+            streams[string_id] = text
+        offset += (STRING.size + length + 3) & ~3
+
+    return locations, streams
+
+
+def format_timestamp(ns):
+    seconds, remainder = divmod(ns, 1_000_000_000)
+    time = datetime.datetime.fromtimestamp(seconds, datetime.timezone.utc)
+    return f"{time:%H:%M:%S}.{remainder // 100:07}"
+
+
+def decode(data, out):
+    magic, version, header_size, string_table_size, string_table_used, ring_size, head, tail, _ = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("not a YimMenu binary log")
+    if version != VERSION:
+        raise ValueError(f"unsupported binary log version {version}")
+
+    locations, streams = read_strings(data, header_size, string_table_used)
+    ring = header_size + string_table_size
+
+    position = tail
+    while position < head:
+        offset = ring + position % ring_size
+        size, record_type, level, stream, timestamp, location, length = RECORD.unpack_from(data, offset)
+        if size == 0:
+            raise ValueError(f"corrupt record at ring offset {position}")
+        position += size
+
+        if record_type != RECORD_MESSAGE:
+            continue
+
+        message = data[offset + RECORD.size:offset + RECORD.size + length].decode("utf-8", "replace")
+        level_name = LEVELS[level] if level < len(LEVELS) else str(level)
+        prefix = f"[{format_timestamp(timestamp)}]"
+        if stream:
+            prefix += f"[{streams.get(stream, stream)}]"
+        out.write(f"{prefix}[{level_name}/{locations.get(location, '?')}] {message}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a YimMenu binary log (cout.ylog).")
+    parser.add_argument("file")
+    parser.add_argument("-o", "--output", help="write to this file instead of stdout")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as out:
+            decode(data, out)
+    else:
+        decode(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
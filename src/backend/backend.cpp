@@ -4,6 +4,7 @@
 #include "looped_command.hpp"
 #include "script.hpp"
 #include "script_patches.hpp"
+#include "script_profiler.hpp"
 #include "services/context_menu/context_menu_service.hpp"
 #include "services/custom_teleport/custom_teleport_service.hpp"
 #include "services/orbital_drone/orbital_drone.hpp"
@@ -42,7 +43,10 @@ namespace big
 
 			for (auto command : g_looped_commands)
 				if (command->is_enabled())
+				{
+					script_profiler::scope profile(command, profiled_kind::LOOPED_COMMAND, command->get_name());
 					command->on_tick();
+				}
 
 			script::get_current()->yield();
 		}
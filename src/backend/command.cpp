@@ -70,9 +70,11 @@ namespace big
 
 		args.reset_idx();
 		if (m_fiber_pool)
-			g_fiber_pool->queue_job([this, args, ctx] {
-				execute(args, ctx);
-			});
+			g_fiber_pool->queue_job(
+			    [this, args, ctx] {
+				    execute(args, ctx);
+			    },
+			    fiber_job_priority::HIGH);
 		else
 			execute(args, ctx);
 	}
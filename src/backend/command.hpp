@@ -63,14 +63,9 @@ namespace big
 			return std::nullopt;
 		};
 
-		inline std::optional<int> get_argument_proxy_value(const std::string proxy)
+		inline std::optional<int> get_argument_proxy_value(std::string_view proxy)
 		{
-			std::string local_player_name_lower = g_player_service->get_self()->get_name();
-			std::string proxy_lower             = proxy;
-			string::operations::to_lower(local_player_name_lower);
-			string::operations::to_lower(proxy_lower);
-
-			switch (proxy_lower[0])
+			switch (proxy.empty() ? '\0' : proxy[0])
 			{
 			case '@': return g_player_service->get_selected()->id();
 			case '!': return g_player_service->get_closest(true)->id();
@@ -96,7 +91,9 @@ namespace big
 				break;
 			}
 
-			if (proxy_lower == "me" || proxy_lower == "self" || local_player_name_lower.find(proxy_lower) != std::string::npos)
+			std::array<char, 64> self_name;
+			if (string::operations::iequals("me", proxy) || string::operations::iequals("self", proxy)
+			    || string::operations::ifind(g_player_service->get_self()->get_lower_name(self_name), proxy) != std::string_view::npos)
 			{
 				return g_player_service->get_self()->id();
 			}
@@ -44,7 +44,7 @@ namespace big
 			{
 				for (auto& item : g_gta_data_service.vehicles())
 				{
-					suggestions.push_back(item.second.m_name);
+					suggestions.push_back(item.m_name);
 				}
 				return suggestions;
 			}
@@ -94,11 +94,11 @@ namespace big
 			string::operations::to_lower(args_lower);
 			for (auto& item : g_gta_data_service.vehicles())
 			{
-				item_name_lower = item.second.m_name;
+				item_name_lower = item.m_name;
 				string::operations::to_lower(item_name_lower);
 				if (item_name_lower.find(args_lower) != std::string::npos)
 				{
-					result.push(rage::joaat(item.first));
+					result.push(item.m_hash);
 					return result;
 				}
 			}
@@ -15,7 +15,7 @@ namespace big
 
 		virtual void execute(player_ptr player, const command_arguments& _args, const std::shared_ptr<command_context> ctx) override
 		{
-			for (auto& [_, weapon] : g_gta_data_service.weapons())
+			for (const auto& weapon : g_gta_data_service.weapons())
 				WEAPON::REMOVE_WEAPON_FROM_PED(PLAYER::GET_PLAYER_PED_SCRIPT_INDEX(player->id()), weapon.m_hash);
 		}
 	};
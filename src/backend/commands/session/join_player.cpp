@@ -25,8 +25,9 @@ namespace big
 					}
 				}
 
-				for (const auto& player : g_player_database_service->get_sorted_players() | std::ranges::views::keys)
-					suggestions.push_back(player);
+				const auto snapshot = g_player_database_service->get_snapshot();
+				for (uint32_t i = 0; i < snapshot->size(); i++)
+					suggestions.push_back(snapshot->get_lower_name(i));
 
 				return suggestions;
 			}
@@ -53,9 +54,9 @@ namespace big
 			// If not a friend, check if the player is in the database
 			if (rid == 0)
 			{
-				for (const auto& [name, player] : g_player_database_service->get_sorted_players())
-					if (name == args[0])
-						rid = player->rockstar_id;
+				const auto snapshot = g_player_database_service->get_snapshot();
+				if (const auto player = snapshot->get_player_by_name(args[0]))
+					rid = player->m_rockstar_id;
 			}
 
 			// If the player is not a friend or in the database, fetch rid from the API
@@ -19,7 +19,7 @@ namespace big
 				std::vector<std::string> suggestions;
 				for (auto& item : g_gta_data_service.vehicles())
 				{
-					suggestions.push_back(item.second.m_name);
+					suggestions.push_back(item.m_name);
 				}
 				return suggestions;
 			}
@@ -40,13 +40,13 @@ namespace big
 			for (auto& item : g_gta_data_service.vehicles())
 			{
 				std::string item_name_lower, args_lower;
-				item_name_lower = item.second.m_name;
+				item_name_lower = item.m_name;
 				args_lower      = args[0];
 				string::operations::to_lower(item_name_lower);
 				string::operations::to_lower(args_lower);
 				if (item_name_lower.find(args_lower) != std::string::npos)
 				{
-					result.push(rage::joaat(item.first));
+					result.push(item.m_hash);
 					return result;
 				}
 			}
@@ -0,0 +1,23 @@
+#include "backend/command.hpp"
+#include "script_profiler.hpp"
+
+namespace big
+{
+	class dump_script_profile : command
+	{
+		using command::command;
+
+		virtual void execute(const command_arguments&, const std::shared_ptr<command_context> ctx) override
+		{
+			if (!g_script_profiler.is_enabled())
+			{
+				ctx->report_error("The script profiler is disabled, enable it in the debug window first.");
+				return;
+			}
+
+			g_script_profiler.dump();
+		}
+	};
+
+	dump_script_profile g_dump_script_profile("dumpscriptprofile", "BACKEND_DUMP_SCRIPT_PROFILE", "BACKEND_DUMP_SCRIPT_PROFILE_DESC", 0, false);
+}
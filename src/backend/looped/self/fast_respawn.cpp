@@ -8,20 +8,23 @@ namespace big
 	{
 		using looped_command::looped_command;
 
+		script_global_ref<bool> m_disable_wasted_sound{scr_globals::disable_wasted_sound};
+		script_global_ref<int> m_respawn_flags{scr_globals::freemode_properties.at(1761).at(756)};
+
 		virtual void on_tick() override
 		{
 			// disable wasted sound cause it's annoying
-			*scr_globals::disable_wasted_sound.as<bool*>() = true;
+			*m_disable_wasted_sound = true;
 
 			// triggers respawn instantly upon death, has no effect if not respawning so no need to check if the player's dead
-			misc::set_bit(&(*scr_globals::freemode_properties.at(1761).at(756).as<int*>()), 1); // Update: freemode -> KILL_STRIP_H -> Above that = "!IS_BIT_SET(global, 2)"
+			misc::set_bit(m_respawn_flags.get(), 1); // Update: freemode -> KILL_STRIP_H -> Above that = "!IS_BIT_SET(global, 2)"
 		}
 
 		virtual void on_disable() override
 		{
-			*scr_globals::disable_wasted_sound.as<bool*>() = false;
+			*m_disable_wasted_sound = false;
 
-			misc::clear_bit(&(*scr_globals::freemode_properties.at(1761).at(756).as<int*>()), 1); 
+			misc::clear_bit(m_respawn_flags.get(), 1);
 		}
 	};
 
@@ -7,9 +7,11 @@ namespace big
 	{
 		using looped_command::looped_command;
 
+		script_global_ref<int> m_interaction_menu_access{scr_globals::interaction_menu_access};
+
 		virtual void on_tick() override
 		{
-			*scr_globals::interaction_menu_access.as<int*>() = 1; // sets itself to the original value every frame while you're in the interaction menu, so no need for a reset
+			*m_interaction_menu_access = 1; // sets itself to the original value every frame while you're in the interaction menu, so no need for a reset
 		}
 	};
 
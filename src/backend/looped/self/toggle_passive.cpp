@@ -12,6 +12,7 @@ namespace big
 	{
 		using looped_command::looped_command;
 
+		script_global_ref<BOOL> m_passive{scr_globals::passive};
 
 		virtual void on_tick() override
 		{
@@ -23,12 +24,12 @@ namespace big
 				return;
 			}
 			*g_tunables_service->get_tunable<int*>("VC_PASSIVE_TIME_AFTER_DISABLE"_J) = 0; // End Passive Time = 0s
-			*scr_globals::passive.as<PBOOL>() = TRUE;
+			*m_passive = TRUE;
 		}
 
 		virtual void on_disable() override
 		{
-			*scr_globals::passive.as<PBOOL>() = FALSE;
+			*m_passive = FALSE;
 			NETWORK::SET_LOCAL_PLAYER_AS_GHOST(false, false);
 			*g_tunables_service->get_tunable<int*>("VC_PASSIVE_TIME_AFTER_DISABLE"_J) = 30000;
 			PED::SET_PED_CONFIG_FLAG(self::ped, 342, false); // Disable NotAllowedToJackAnyPlayers
@@ -8,14 +8,16 @@ namespace big
 	{
 		using looped_command::looped_command;
 
+		script_global_ref<BOOL> m_disable_phone{scr_globals::disable_phone};
+
 		virtual void on_tick() override
 		{
-			*scr_globals::disable_phone.as<PBOOL>() = TRUE;
+			*m_disable_phone = TRUE;
 		}
 
 		virtual void on_disable() override
 		{
-			*scr_globals::disable_phone.as<PBOOL>() = FALSE;
+			*m_disable_phone = FALSE;
 		}
 	};
 
@@ -12,31 +12,29 @@ namespace big
 		std::array<int, 8> m_restore;
 		bool m_backed_up;
 
-		const std::vector<Hash> m_tunable_hashes = {"IDLEKICK_WARNING1"_J, "IDLEKICK_WARNING2"_J, "IDLEKICK_WARNING3"_J, "IDLEKICK_KICK"_J, "ConstrainedKick_Warning1"_J, "ConstrainedKick_Warning2"_J, "ConstrainedKick_Warning3"_J, "ConstrainedKick_Kick"_J};
+		const std::array<rage::joaat_t, 8> m_tunable_hashes = {"IDLEKICK_WARNING1"_J, "IDLEKICK_WARNING2"_J, "IDLEKICK_WARNING3"_J, "IDLEKICK_KICK"_J, "ConstrainedKick_Warning1"_J, "ConstrainedKick_Warning2"_J, "ConstrainedKick_Warning3"_J, "ConstrainedKick_Kick"_J};
 
 		virtual void on_tick() override
 		{
+			std::array<int*, 8> tunables;
+			const auto found = g_tunables_service->get_tunables<int*>(m_tunable_hashes, tunables);
+
 			if (!m_backed_up) [[unlikely]]
 			{
-				bool did_fail = false;
 				for (int i = 0; i < m_restore.size(); i++)
 				{
-					if (auto tunable = g_tunables_service->get_tunable<int*>(m_tunable_hashes[i]))
-					{
-						m_restore[i] = *tunable;
-					}
-					else
+					if (tunables[i])
 					{
-						did_fail = true;
+						m_restore[i] = *tunables[i];
 					}
 				}
-				m_backed_up = !did_fail;
+				m_backed_up = found == tunables.size();
 			}
 			else
 			{
-				for (Hash hash_iter : m_tunable_hashes)
+				for (auto tunable_ptr : tunables)
 				{
-					if (auto tunable_ptr = g_tunables_service->get_tunable<int*>(hash_iter))
+					if (tunable_ptr)
 					{
 						*tunable_ptr = INT_MAX;
 					}
@@ -48,13 +48,10 @@ namespace big
 				return;
 			}
 
-			for (auto& plyr : g_player_service->players())
+			if (auto plyr = g_player_service->get_by_id(args.get<uint8_t>(0)))
 			{
-				if (plyr.second->id() == args.get<uint8_t>(0))
-				{
-					execute(plyr.second, new_args, ctx);
-					return;
-				}
+				execute(plyr, new_args, ctx);
+				return;
 			}
 
 			ctx->report_error(std::format("Tried to execute command {}, but a player with index {} was not found", m_name, args.get<int>(0)));
@@ -76,14 +73,8 @@ namespace big
 		{
 			int plyr_id = -1;
 
-			for (auto& plyr : g_player_service->players())
-			{
-				if (stricmp(plyr.second->get_name(), args[0].c_str()) == 0)
-				{
-					plyr_id = plyr.second->id();
-					break;
-				}
-			}
+			if (auto plyr = g_player_service->get_by_name(args[0]))
+				plyr_id = plyr->id();
 
 			if (ctx->get_access_level() != CommandAccessLevel::ADMIN && (get_access_level() == CommandAccessLevel::TOXIC || get_access_level() == CommandAccessLevel::AGGRESSIVE) && plyr_id == self::id)
 			{
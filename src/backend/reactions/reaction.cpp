@@ -22,9 +22,11 @@ namespace big
 
 			if (block_joins)
 			{
-				entry->block_join = true;
-				entry->block_join_reason = block_join_reason;
-				g_player_database_service->save();
+				g_player_database_service->update_player(entry, [this](persistent_player& stored) {
+					stored.block_join        = true;
+					stored.block_join_reason = block_join_reason;
+				});
+				g_player_database_service->save(entry);
 			}
 		}
 
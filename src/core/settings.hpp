@@ -123,6 +123,10 @@ namespace big
 				bool http_start_request_logs{};
 				bool script_hook_logs{};
 
+				// both take effect on the next injection
+				bool text_file_log   = true;
+				bool binary_file_log = false;
+
 				struct script_event
 				{
 					bool logs = false;
@@ -135,7 +139,7 @@ namespace big
 					NLOHMANN_DEFINE_TYPE_INTRUSIVE(script_event, logs, filter_player, player_id)
 				} script_event{};
 
-				NLOHMANN_DEFINE_TYPE_INTRUSIVE(logs, metric_logs, packet_logs, http_start_request_logs, script_hook_logs, script_event)
+				NLOHMANN_DEFINE_TYPE_INTRUSIVE(logs, metric_logs, packet_logs, http_start_request_logs, script_hook_logs, text_file_log, binary_file_log, script_event)
 			} logs{};
 
 			struct fuzzer
@@ -151,6 +155,7 @@ namespace big
 			bool window_hook      = false;
 			bool block_all_metrics = false;
 			bool battleye_server   = false;
+			bool script_profiler   = false; //should not save
 
 			NLOHMANN_DEFINE_TYPE_INTRUSIVE(debug, logs, external_console, window_hook, block_all_metrics, battleye_server)
 		} debug{};
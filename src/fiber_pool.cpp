@@ -7,8 +7,13 @@
 namespace big
 {
 	fiber_pool::fiber_pool(std::size_t num_fibers) :
-	    m_num_fibers(num_fibers)
+	    m_reset_requested(false),
+	    m_num_fibers(num_fibers),
+	    m_wait_sample_count(0)
 	{
+		for (auto& sample : m_wait_samples_us)
+			sample.store(0, std::memory_order_relaxed);
+
 		for (std::size_t i = 0; i < num_fibers; ++i)
 		{
 			g_script_mgr.add_script(std::make_unique<script>(&fiber_func));
@@ -22,16 +27,23 @@ namespace big
 		g_fiber_pool = nullptr;
 	}
 
-	void fiber_pool::queue_job(std::function<void()> func)
+	void fiber_pool::queue_job(std::function<void()> func, fiber_job_priority priority)
 	{
 		if (func)
 		{
-			std::lock_guard lock(m_mutex);
-			m_jobs.push(std::move(func));
+			auto& lane = m_lanes[static_cast<std::size_t>(priority)];
+			job entry{std::move(func), std::chrono::steady_clock::now()};
+
+			// jobs only spill over when the ring is full, which is a bug somewhere else anyway
+			if (lane.m_overflow_size.load(std::memory_order_relaxed) == 0 && lane.m_ring.try_push(std::move(entry)))
+				return;
+
+			std::lock_guard lock(lane.m_overflow_mutex);
+			lane.m_overflow.push_back(std::move(entry));
+			++lane.m_overflow_size;
 		}
 	}
 
-	
 	void fiber_pool::execute_on_game_thread(std::function<void()> func)
 	{
 		if (func)
@@ -43,17 +55,56 @@ namespace big
 		}
 	}
 
-	void fiber_pool::fiber_tick()
+	std::optional<fiber_pool::job> fiber_pool::pop_job()
 	{
-		std::unique_lock lock(m_mutex);
-		if (!m_jobs.empty())
+		for (auto& lane : m_lanes)
 		{
-			auto job = std::move(m_jobs.top());
-			m_jobs.pop();
-			lock.unlock();
+			if (auto entry = lane.m_ring.try_pop())
+				return entry;
+
+			if (lane.m_overflow_size.load(std::memory_order_relaxed))
+			{
+				std::lock_guard lock(lane.m_overflow_mutex);
+				if (!lane.m_overflow.empty())
+				{
+					auto entry = std::move(lane.m_overflow.front());
+					lane.m_overflow.pop_front();
+					--lane.m_overflow_size;
+					return entry;
+				}
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	void fiber_pool::record_wait_time(std::chrono::steady_clock::duration wait_time)
+	{
+		const auto idx = m_wait_sample_count.fetch_add(1, std::memory_order_relaxed) % WAIT_SAMPLE_COUNT;
+		const auto us  = std::chrono::duration_cast<std::chrono::microseconds>(wait_time).count();
+		m_wait_samples_us[idx].store(static_cast<uint32_t>(std::min<int64_t>(us, UINT32_MAX)), std::memory_order_relaxed);
+	}
 
-			std::invoke(std::move(job));
+	void fiber_pool::fiber_tick()
+	{
+		// all fibers run on the game thread, so this is the only consumer of the lanes
+		if (m_reset_requested.exchange(false))
+		{
+			while (pop_job())
+				;
 		}
+
+		const auto tick_start = std::chrono::steady_clock::now();
+		do
+		{
+			auto job = pop_job();
+			if (!job)
+				break;
+
+			record_wait_time(std::chrono::steady_clock::now() - job->m_queued_at);
+
+			std::invoke(std::move(job->m_func));
+		} while (std::chrono::steady_clock::now() - tick_start < TICK_BUDGET);
 	}
 
 	void fiber_pool::fiber_func()
@@ -72,14 +123,43 @@ namespace big
 
 	int fiber_pool::get_used_fibers()
 	{
-		return m_jobs.size();
+		std::size_t depth = 0;
+		for (auto& lane : m_lanes)
+			depth += lane.m_ring.size() + lane.m_overflow_size.load(std::memory_order_relaxed);
+
+		return static_cast<int>(depth);
 	}
 
-	void fiber_pool::reset()
+	fiber_pool_stats fiber_pool::get_stats()
 	{
-		std::lock_guard lock(m_mutex);
+		fiber_pool_stats stats{};
+		for (std::size_t i = 0; i < m_lanes.size(); ++i)
+			stats.m_queue_depth[i] = m_lanes[i].m_ring.size() + m_lanes[i].m_overflow_size.load(std::memory_order_relaxed);
+
+		const auto sample_count = std::min(m_wait_sample_count.load(std::memory_order_relaxed), WAIT_SAMPLE_COUNT);
+		if (sample_count == 0)
+			return stats;
 
-		while (!m_jobs.empty())
-			m_jobs.pop();
+		std::array<uint32_t, WAIT_SAMPLE_COUNT> samples;
+		for (std::size_t i = 0; i < sample_count; ++i)
+			samples[i] = m_wait_samples_us[i].load(std::memory_order_relaxed);
+
+		const auto percentile = [&](std::size_t percent) {
+			const auto nth = samples.begin() + (sample_count - 1) * percent / 100;
+			std::nth_element(samples.begin(), nth, samples.begin() + sample_count);
+			return std::chrono::microseconds(*nth);
+		};
+
+		stats.m_wait_p50 = percentile(50);
+		stats.m_wait_p90 = percentile(90);
+		stats.m_wait_p99 = percentile(99);
+
+		return stats;
+	}
+
+	void fiber_pool::reset()
+	{
+		// the lanes can only be drained by their consumer, let the next fiber tick do it
+		m_reset_requested = true;
 	}
-}
\ No newline at end of file
+}
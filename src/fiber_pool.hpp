@@ -1,28 +1,80 @@
 #pragma once
+#include "util/mpsc_ring.hpp"
+
+#include <array>
+#include <deque>
 
 namespace big
 {
+	enum class fiber_job_priority
+	{
+		// work triggered by the user, hotkeys, commands, GUI callbacks
+		HIGH,
+		NORMAL,
+		// housekeeping that can wait a few frames, like the player database
+		LOW,
+
+		COUNT
+	};
+
+	struct fiber_pool_stats
+	{
+		std::size_t m_queue_depth[static_cast<std::size_t>(fiber_job_priority::COUNT)];
+		std::chrono::microseconds m_wait_p50;
+		std::chrono::microseconds m_wait_p90;
+		std::chrono::microseconds m_wait_p99;
+	};
+
 	class fiber_pool
 	{
+		// a fiber keeps taking jobs until it has spent this long in a single tick
+		static constexpr auto TICK_BUDGET = 500us;
+		static constexpr std::size_t LANE_CAPACITY = 4096;
+		static constexpr std::size_t WAIT_SAMPLE_COUNT = 256;
+
+		struct job
+		{
+			std::function<void()> m_func;
+			std::chrono::steady_clock::time_point m_queued_at;
+		};
+
+		struct lane
+		{
+			mpsc_ring<job, LANE_CAPACITY> m_ring;
+
+			// only used when the ring is full
+			std::mutex m_overflow_mutex;
+			std::deque<job> m_overflow;
+			std::atomic<std::size_t> m_overflow_size;
+		};
+
 	public:
 		explicit fiber_pool(std::size_t num_fibers);
 		~fiber_pool();
 
-		void queue_job(std::function<void()> func);
+		void queue_job(std::function<void()> func, fiber_job_priority priority = fiber_job_priority::NORMAL);
 		void execute_on_game_thread(std::function<void()> func);
 
 		void fiber_tick();
 		static void fiber_func();
 
 		int get_total_fibers();
+		// amount of jobs waiting to be picked up by a fiber
 		int get_used_fibers();
+		fiber_pool_stats get_stats();
 
 		void reset();
 
 	private:
-		std::recursive_mutex m_mutex;
-		std::stack<std::function<void()>> m_jobs;
+		std::optional<job> pop_job();
+		void record_wait_time(std::chrono::steady_clock::duration wait_time);
+
+		std::array<lane, static_cast<std::size_t>(fiber_job_priority::COUNT)> m_lanes;
+		std::atomic<bool> m_reset_requested;
 		int m_num_fibers;
+
+		std::array<std::atomic<uint32_t>, WAIT_SAMPLE_COUNT> m_wait_samples_us;
+		std::atomic<std::size_t> m_wait_sample_count;
 	};
 
 	inline fiber_pool* g_fiber_pool{};
@@ -162,7 +162,7 @@ namespace big
 		{
 			if (button<size, color>(text))
 			{
-				g_fiber_pool->queue_job(cb);
+				g_fiber_pool->queue_job(cb, fiber_job_priority::HIGH);
 			}
 		}
 
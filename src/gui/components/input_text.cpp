@@ -11,7 +11,7 @@ namespace big
 		if (ImGui::InputText(label.data(), buf, buf_size, flag))
 		{
 			if (cb)
-				g_fiber_pool->queue_job(std::move(cb));
+				g_fiber_pool->queue_job(std::move(cb), fiber_job_priority::HIGH);
 			retval = true;
 		}
 
@@ -38,7 +38,7 @@ namespace big
 		if (ImGui::InputText(label.data(), &buf, flag))
 		{
 			if (cb)
-				g_fiber_pool->queue_job(std::move(cb));
+				g_fiber_pool->queue_job(std::move(cb), fiber_job_priority::HIGH);
 			retval = true;
 		}
 
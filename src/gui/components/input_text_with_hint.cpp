@@ -9,7 +9,7 @@ namespace big
 	{
 		bool returned = false;
 		if (returned = ImGui::InputTextWithHint(label.data(), hint.data(), buf, buf_size, flag); returned && cb)
-			g_fiber_pool->queue_job(std::move(cb));
+			g_fiber_pool->queue_job(std::move(cb), fiber_job_priority::HIGH);
 
 		if (ImGui::IsItemActive())
 		{
@@ -32,7 +32,7 @@ namespace big
 	{
 		bool returned = false;
 		if (returned = ImGui::InputTextWithHint(label.data(), hint.data(), &buf, flag, callback); returned && cb)
-			g_fiber_pool->queue_job(std::move(cb));
+			g_fiber_pool->queue_job(std::move(cb), fiber_job_priority::HIGH);
 
 		if (ImGui::IsItemActive())
 		{
@@ -16,14 +16,14 @@ namespace big
 	void components::selectable(const std::string_view text, bool selected, std::function<void()> cb)
 	{
 		if (components::selectable(text, selected))
-			g_fiber_pool->queue_job(std::move(cb));
+			g_fiber_pool->queue_job(std::move(cb), fiber_job_priority::HIGH);
 	}
 
 	void components::selectable(const std::string_view text, bool selected, ImGuiSelectableFlags flag, std::function<void()> cb)
 	{
 		if (components::selectable(text, selected, flag))
 		{
-			g_fiber_pool->queue_job(std::move(cb));
+			g_fiber_pool->queue_job(std::move(cb), fiber_job_priority::HIGH);
 		}
 	}
 }
\ No newline at end of file
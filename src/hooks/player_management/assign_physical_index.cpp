@@ -95,20 +95,22 @@ namespace big
 					{
 						if (auto entry = g_player_database_service->get_player_by_rockstar_id(rockstar_id))
 						{
-							plyr->is_trusted = entry->is_trusted;
+							const auto stored = g_player_database_service->get_player_copy(entry);
+
+							plyr->is_trusted = stored.is_trusted;
 							if (!(plyr->is_friend() && g.session.trust_friends))
 							{
-								plyr->is_modder         = entry->is_modder;
-								plyr->block_join        = entry->block_join;
-								plyr->block_join_reason = entry->block_join_reason;
+								plyr->is_modder         = stored.is_modder;
+								plyr->block_join        = stored.block_join;
+								plyr->block_join_reason = stored.block_join_reason;
 							}
 
-							if (strcmp(plyr->get_name(), entry->name.data()))
+							if (strcmp(plyr->get_name(), stored.name.data()))
 							{
 								g_notification_service.push("PLAYERS"_T.data(),
-									std::format("{} {}: {}", entry->name, "PLAYER_CHANGED_NAME"_T, plyr->get_name()));
-								entry->name = plyr->get_name();
-								g_player_database_service->save();
+									std::format("{} {}: {}", stored.name, "PLAYER_CHANGED_NAME"_T, plyr->get_name()));
+								g_player_database_service->set_name(entry, plyr->get_name());
+								g_player_database_service->save(entry);
 							}
 						}
 					}
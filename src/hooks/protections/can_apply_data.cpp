@@ -206,25 +206,13 @@ namespace big
 
 		if (info->get_model_type() == eModelType::Vehicle)
 		{
-			for (auto& [name, data] : g_gta_data_service.vehicles())
-			{
-				if (data.m_hash == model)
-				{
-					model_str = name.data();
-					break;
-				}
-			}
+			if (const auto& data = g_gta_data_service.vehicle_by_hash(model); data.m_hash)
+				model_str = data.m_name;
 		}
 		else if (info->get_model_type() == eModelType::Ped)
 		{
-			for (auto& [name, data] : g_gta_data_service.peds())
-			{
-				if (data.m_hash == model)
-				{
-					model_str = name.data();
-					break;
-				}
-			}
+			if (const auto& data = g_gta_data_service.ped_by_hash(model); data.m_hash)
+				model_str = data.m_name;
 		}
 
 		if (!model_str)
@@ -415,7 +415,7 @@ namespace big
 			}
 			else
 			{
-				static rate_limiter unk_player_radio_requests{1s, 5};
+				static rate_limiter unk_player_radio_requests{1s, 5, rate_limited_event::RADIO_REQUEST};
 
 				if (unk_player_radio_requests.process())
 				{
@@ -632,13 +632,10 @@ namespace big
 				return true;
 			}
 
-			for (auto& player : g_player_service->players())
+			if (auto player = g_player_service->get_by_id(player_id)) [[unlikely]]
 			{
-				if (player.second->id() == player_id) [[unlikely]]
-				{
-					LOGF(stream::net_messages, VERBOSE, "{} sent MsgNonPhysicalData, but are trying to replace {}", peer->m_info.name, player.second->get_name());
-					return true;
-				}
+				LOGF(stream::net_messages, VERBOSE, "{} sent MsgNonPhysicalData, but are trying to replace {}", peer->m_info.name, player->get_name());
+				return true;
 			}
 
 			break;
@@ -1,5 +1,6 @@
 #include "hooking/hooking.hpp"
 #include "native_hooks/native_hooks.hpp"
+#include "script_global.hpp"
 #include "services/script_patcher/script_patcher_service.hpp"
 
 namespace big
@@ -8,6 +9,9 @@ namespace big
 	{
 		bool ret = g_hooking->get_original<hooks::init_native_tables>()(program);
 
+		// the script may have brought its own block of globals, cached global addresses have to be resolved again
+		g_script_global_generation.fetch_add(1, std::memory_order_relaxed);
+
 		if (program->m_code_size && program->m_code_blocks) // ensure that we aren't hooking SHV threads
 		{
 			g_script_patcher_service->on_script_load(program);
@@ -22,7 +22,7 @@ namespace big
 		{
 			m_orig_bytecode = program->m_code_blocks;
 	
-			if (auto bytecode = g_script_patcher_service->get_script_bytecode(program->m_name_hash))
+			if (auto bytecode = g_script_patcher_service->get_script_bytecode(program))
 				program->m_code_blocks = bytecode;
 
 			if (g_pointers->m_gta.m_script_globals[0xA])
@@ -0,0 +1,202 @@
+#include "binary_log.hpp"
+
+namespace big
+{
+	constexpr auto BINARY_LOG_FLUSH_INTERVAL = std::chrono::seconds(1);
+	// keeps a single message from evicting most of the ring
+	constexpr uint32_t BINARY_LOG_MAX_MESSAGE = 64 * 1024;
+
+	static constexpr uint32_t align_up(uint32_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	binary_log_sink::~binary_log_sink()
+	{
+		close();
+	}
+
+	bool binary_log_sink::open(const std::filesystem::path& path)
+	{
+		close();
+
+		const uint64_t total_size = BINARY_LOG_HEADER_SIZE + BINARY_LOG_STRING_TABLE_SIZE + BINARY_LOG_RING_SIZE;
+
+		m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE)
+			return false;
+
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(total_size >> 32), static_cast<DWORD>(total_size), nullptr);
+		if (!m_mapping)
+		{
+			close();
+			return false;
+		}
+
+		m_view = static_cast<uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, 0));
+		if (!m_view)
+		{
+			close();
+			return false;
+		}
+
+		m_header       = reinterpret_cast<binary_log_header*>(m_view);
+		m_string_table = m_view + BINARY_LOG_HEADER_SIZE;
+		m_ring         = m_string_table + BINARY_LOG_STRING_TABLE_SIZE;
+
+		m_header->m_version           = BINARY_LOG_VERSION;
+		m_header->m_header_size       = BINARY_LOG_HEADER_SIZE;
+		m_header->m_string_table_size = BINARY_LOG_STRING_TABLE_SIZE;
+		m_header->m_string_table_used = 0;
+		m_header->m_ring_size         = BINARY_LOG_RING_SIZE;
+		m_header->m_head              = 0;
+		m_header->m_tail              = 0;
+		m_header->m_start_time =
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		// written last so a decoder never sees a half initialized header
+		m_header->m_magic = BINARY_LOG_MAGIC;
+
+		m_locations.clear();
+		m_streams.clear();
+		m_next_string_id = 1;
+		m_last_flush     = std::chrono::steady_clock::now();
+
+		return true;
+	}
+
+	void binary_log_sink::close()
+	{
+		if (m_view)
+		{
+			FlushViewOfFile(m_view, 0);
+			UnmapViewOfFile(m_view);
+		}
+		if (m_mapping)
+			CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE)
+		{
+			FlushFileBuffers(m_file);
+			CloseHandle(m_file);
+		}
+
+		m_view         = nullptr;
+		m_mapping      = nullptr;
+		m_file         = INVALID_HANDLE_VALUE;
+		m_header       = nullptr;
+		m_string_table = nullptr;
+		m_ring         = nullptr;
+	}
+
+	void binary_log_sink::write(const al::LogMessagePtr& msg)
+	{
+		if (!m_view)
+			return;
+
+		const auto& message  = msg->Message();
+		const auto length    = static_cast<uint32_t>(std::min<size_t>(message.size(), BINARY_LOG_MAX_MESSAGE));
+		const auto size      = align_up(sizeof(binary_log_record) + length, 8);
+		const auto stream    = msg->Stream();
+		const auto stream_id = stream ? intern_stream(stream->get()->Name()) : uint8_t(0);
+		const auto location  = intern_location(msg->Location());
+
+		const auto target = reserve(size);
+
+		binary_log_record record{};
+		record.m_size      = size;
+		record.m_type      = binary_log_record_type::MESSAGE;
+		record.m_level     = static_cast<uint8_t>(msg->Level());
+		record.m_stream    = stream_id;
+		record.m_timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(msg->Timestamp().time_since_epoch()).count();
+		record.m_location  = location;
+		record.m_length    = length;
+
+		memcpy(target, &record, sizeof(record));
+		memcpy(target + sizeof(record), message.data(), length);
+
+		// publish the record only after its contents are in place
+		std::atomic_thread_fence(std::memory_order_release);
+		m_header->m_head += size;
+
+		if (const auto now = std::chrono::steady_clock::now(); msg->Level() == al::eLogLevel::FATAL || now - m_last_flush >= BINARY_LOG_FLUSH_INTERVAL)
+		{
+			FlushViewOfFile(m_view, 0);
+			m_last_flush = now;
+		}
+	}
+
+	uint8_t* binary_log_sink::reserve(uint32_t size)
+	{
+		const auto make_room = [this](uint64_t needed) {
+			while (m_header->m_head + needed - m_header->m_tail > BINARY_LOG_RING_SIZE)
+			{
+				const auto oldest = reinterpret_cast<const binary_log_record*>(m_ring + m_header->m_tail % BINARY_LOG_RING_SIZE);
+				m_header->m_tail += oldest->m_size;
+			}
+		};
+
+		// records never wrap, pad out the end of the ring instead
+		const auto position  = m_header->m_head % BINARY_LOG_RING_SIZE;
+		const auto remaining = static_cast<uint32_t>(BINARY_LOG_RING_SIZE - position);
+		if (remaining < size)
+		{
+			make_room(remaining);
+
+			const auto padding = reinterpret_cast<binary_log_record*>(m_ring + position);
+			padding->m_size    = remaining;
+			padding->m_type    = binary_log_record_type::PADDING;
+			m_header->m_head += remaining;
+		}
+
+		make_room(size);
+		return m_ring + m_header->m_head % BINARY_LOG_RING_SIZE;
+	}
+
+	uint32_t binary_log_sink::intern_location(const std::source_location& location)
+	{
+		auto& lines = m_locations[location.file_name()];
+		if (const auto it = lines.find(location.line()); it != lines.end())
+			return it->second;
+
+		const auto file = std::filesystem::path(location.file_name()).filename().string();
+		const auto id   = m_next_string_id;
+		if (!append_string(id, binary_log_string_kind::LOCATION, file, location.line()))
+			return lines[location.line()] = 0;
+
+		++m_next_string_id;
+		return lines[location.line()] = id;
+	}
+
+	uint8_t binary_log_sink::intern_stream(const std::string& name)
+	{
+		if (const auto it = m_streams.find(name); it != m_streams.end())
+			return it->second;
+
+		const auto id = static_cast<uint8_t>(m_streams.size() + 1);
+		if (m_streams.size() >= UINT8_MAX || !append_string(id, binary_log_string_kind::STREAM, name, 0))
+			return m_streams[name] = 0;
+
+		return m_streams[name] = id;
+	}
+
+	bool binary_log_sink::append_string(uint32_t id, binary_log_string_kind kind, std::string_view text, uint32_t line)
+	{
+		const auto length = static_cast<uint16_t>(std::min<size_t>(text.size(), UINT16_MAX));
+		const auto size   = align_up(sizeof(binary_log_string) + length, 4);
+		const auto used   = m_header->m_string_table_used;
+		if (used + size > BINARY_LOG_STRING_TABLE_SIZE)
+			return false;
+
+		binary_log_string entry{};
+		entry.m_id     = id;
+		entry.m_kind   = kind;
+		entry.m_length = length;
+		entry.m_line   = line;
+
+		memcpy(m_string_table + used, &entry, sizeof(entry));
+		memcpy(m_string_table + used + sizeof(entry), text.data(), length);
+
+		std::atomic_thread_fence(std::memory_order_release);
+		m_header->m_string_table_used = used + size;
+		return true;
+	}
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <AsyncLogger/Logger.hpp>
+
+namespace big
+{
+	/**
+	 * @brief On disk layout of the binary log, scripts/decode_binary_log.py has to be kept in sync with these structs.
+	 *
+	 * [binary_log_header | padding to BINARY_LOG_HEADER_SIZE][string table][ring]
+	 * All integers are little endian.
+	 */
+	constexpr uint64_t BINARY_LOG_MAGIC             = 0x00474F4C4D4959; // "YIMLOG\0\0"
+	constexpr uint32_t BINARY_LOG_VERSION           = 1;
+	constexpr uint32_t BINARY_LOG_HEADER_SIZE       = 0x1000;
+	constexpr uint32_t BINARY_LOG_STRING_TABLE_SIZE = 1 << 20;
+	constexpr uint64_t BINARY_LOG_RING_SIZE         = 32 << 20;
+
+	enum class binary_log_string_kind : uint8_t
+	{
+		LOCATION = 1,
+		STREAM   = 2
+	};
+
+	enum class binary_log_record_type : uint16_t
+	{
+		// fills the end of the ring when the next record doesn't fit, only m_size and m_type are valid
+		PADDING = 0,
+		MESSAGE = 1
+	};
+
+#pragma pack(push, 1)
+	struct binary_log_header
+	{
+		uint64_t m_magic;
+		uint32_t m_version;
+		uint32_t m_header_size;
+		uint32_t m_string_table_size;
+		// bytes of the string table that hold complete entries
+		uint32_t m_string_table_used;
+		uint64_t m_ring_size;
+		// monotonic byte counters, the ring holds the records in [m_tail, m_head)
+		uint64_t m_head;
+		uint64_t m_tail;
+		int64_t m_start_time;
+	};
+	static_assert(sizeof(binary_log_header) == 56);
+
+	struct binary_log_string
+	{
+		uint32_t m_id;
+		binary_log_string_kind m_kind;
+		uint8_t m_reserved;
+		uint16_t m_length;
+		uint32_t m_line;
+		// followed by m_length bytes of text, padded to 4 bytes
+	};
+	static_assert(sizeof(binary_log_string) == 12);
+
+	struct binary_log_record
+	{
+		// size of the whole record including payload and padding, always a multiple of 8
+		uint32_t m_size;
+		binary_log_record_type m_type;
+		uint8_t m_level;
+		uint8_t m_stream;
+		// nanoseconds since the unix epoch
+		int64_t m_timestamp;
+		uint32_t m_location;
+		uint32_t m_length;
+		// followed by m_length bytes of message text
+	};
+	static_assert(sizeof(binary_log_record) == 24);
+#pragma pack(pop)
+
+	/**
+	 * @brief Log sink that copies records into a memory mapped ring file instead of formatting them.
+	 *
+	 * Source locations and stream names are interned once into the string table, every record only carries their ids.
+	 * Timestamps, levels and locations are turned into text by the decoder, the message body is stored as the LOG call produced it.
+	 * Pages are flushed to disk in batches: once a second, on fatal messages and when the sink is closed.
+	 */
+	class binary_log_sink final
+	{
+	public:
+		binary_log_sink() = default;
+		~binary_log_sink();
+
+		binary_log_sink(const binary_log_sink&)            = delete;
+		binary_log_sink& operator=(const binary_log_sink&) = delete;
+
+		bool open(const std::filesystem::path& path);
+		void close();
+
+		bool is_open() const
+		{
+			return m_view != nullptr;
+		}
+
+		void write(const al::LogMessagePtr& msg);
+
+	private:
+		uint32_t intern_location(const std::source_location& location);
+		uint8_t intern_stream(const std::string& name);
+		bool append_string(uint32_t id, binary_log_string_kind kind, std::string_view text, uint32_t line);
+
+		// makes room for size bytes at the head, dropping the oldest records if needed
+		uint8_t* reserve(uint32_t size);
+
+	private:
+		HANDLE m_file    = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+		uint8_t* m_view  = nullptr;
+
+		binary_log_header* m_header = nullptr;
+		uint8_t* m_string_table     = nullptr;
+		uint8_t* m_ring             = nullptr;
+
+		std::unordered_map<const char*, std::unordered_map<uint32_t, uint32_t>> m_locations;
+		std::unordered_map<std::string, uint8_t> m_streams;
+		uint32_t m_next_string_id = 1;
+
+		std::chrono::steady_clock::time_point m_last_flush;
+	};
+}
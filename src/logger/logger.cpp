@@ -12,7 +12,7 @@ namespace big
 		return system_clock::to_time_t(sctp);
 	}
 
-	void logger::initialize(const std::string_view console_title, file file, bool attach_console)
+	void logger::initialize(const std::string_view console_title, file file, bool attach_console, std::optional<big::file> binary_file, bool text_file)
 	{
 		m_console_title = console_title;
 		m_file          = file;
@@ -22,16 +22,37 @@ namespace big
 			m_console_logger = &logger::format_console_simple;
 		}
 
-		create_backup();
-		m_file_out.open(m_file.get_path(), std::ios_base::out | std::ios_base::trunc);
+		if (text_file)
+		{
+			create_backup(m_file);
+			m_file_out.open(m_file.get_path(), std::ios_base::out | std::ios_base::trunc);
+		}
+
+		if (binary_file)
+		{
+			m_binary_file = *binary_file;
+			create_backup(m_binary_file);
+			prune_backups(m_binary_file, MAX_BINARY_LOG_BACKUPS);
+			if (!m_binary_log.open(m_binary_file.get_path()))
+				LOG(WARNING) << "Failed to map binary log file, error " << GetLastError();
+		}
 
 		Logger::Init();
 		Logger::AddSink([this](LogMessagePtr msg) {
 			(this->*m_console_logger)(std::move(msg));
 		});
-		Logger::AddSink([this](LogMessagePtr msg) {
-			format_file(std::move(msg));
-		});
+		if (m_file_out.is_open())
+		{
+			Logger::AddSink([this](LogMessagePtr msg) {
+				format_file(std::move(msg));
+			});
+		}
+		if (m_binary_log.is_open())
+		{
+			Logger::AddSink([this](LogMessagePtr msg) {
+				m_binary_log.write(msg);
+			});
+		}
 
 		toggle_external_console(attach_console);
 	}
@@ -40,6 +61,7 @@ namespace big
 	{
 		Logger::Destroy();
 		m_file_out.close();
+		m_binary_log.close();
 		toggle_external_console(false);
 	}
 
@@ -82,25 +104,47 @@ namespace big
 		}
 	}
 
-	void logger::create_backup()
+	void logger::create_backup(file& file)
 	{
-		if (m_file.exists())
+		if (file.exists())
 		{
-			auto file_time  = std::filesystem::last_write_time(m_file.get_path());
+			auto file_time  = std::filesystem::last_write_time(file.get_path());
 			auto time_t     = to_time_t(file_time);
 			auto local_time = std::localtime(&time_t);
 
-			m_file.move(std::format("./backup/{:0>2}-{:0>2}-{}-{:0>2}-{:0>2}-{:0>2}_{}",
+			file.move(std::format("./backup/{:0>2}-{:0>2}-{}-{:0>2}-{:0>2}-{:0>2}_{}",
 			    local_time->tm_mon + 1,
 			    local_time->tm_mday,
 			    local_time->tm_year + 1900,
 			    local_time->tm_hour,
 			    local_time->tm_min,
 			    local_time->tm_sec,
-			    m_file.get_path().filename().string().c_str()));
+			    file.get_path().filename().string().c_str()));
 		}
 	}
 
+	void logger::prune_backups(const file& file, std::size_t max_backups)
+	{
+		const auto backup_folder = file.get_path().parent_path() / "backup";
+		const auto suffix        = "_" + file.get_path().filename().string();
+
+		std::error_code ec;
+		std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> backups;
+		for (const auto& entry : std::filesystem::directory_iterator(backup_folder, ec))
+		{
+			if (const auto name = entry.path().filename().string(); name.ends_with(suffix))
+				backups.emplace_back(entry.last_write_time(ec), entry.path());
+		}
+
+		if (backups.size() <= max_backups)
+			return;
+
+		// newest first, the backup names start with the month so they don't sort by age
+		std::sort(backups.begin(), backups.end(), std::greater{});
+		for (auto it = backups.begin() + max_backups; it != backups.end(); ++it)
+			std::filesystem::remove(it->second, ec);
+	}
+
 	const LogColor get_color(const eLogLevel level)
 	{
 		switch (level)
@@ -120,6 +164,33 @@ namespace big
 		return levelStrings[level];
 	}
 
+	const std::string& text_prefix_cache::location(const LogMessagePtr& msg)
+	{
+		const auto& location = msg->Location();
+		const auto level     = msg->Level();
+
+		auto& entry = m_locations[location.file_name()][(location.line() << 2) | (static_cast<uint32_t>(level) & 3)];
+		if (entry.empty())
+		{
+			const auto file = std::filesystem::path(location.file_name()).filename().string();
+			entry           = std::format("[{}/{}:{}] ", get_level_string(level), file, location.line());
+		}
+		return entry;
+	}
+
+	std::string text_prefix_cache::timestamp(const LogMessagePtr& msg)
+	{
+		using namespace std::chrono;
+
+		const auto since_epoch = msg->Timestamp().time_since_epoch();
+		if (const auto minute = duration_cast<minutes>(since_epoch).count(); minute != m_minute)
+		{
+			m_minute        = minute;
+			m_minute_prefix = std::format("{0:%H:%M:}", floor<minutes>(msg->Timestamp()));
+		}
+		return m_minute_prefix + std::format("{0:%S}", since_epoch % 1min);
+	}
+
 	void logger::format_console(const LogMessagePtr msg)
 	{
 		if (!m_is_console_open)
@@ -129,19 +200,15 @@ namespace big
 
 		const auto color = get_color(msg->Level());
 
-		const auto timestamp = std::format("{0:%H:%M:%S}", msg->Timestamp());
-		const auto& location = msg->Location();
-		const auto level     = msg->Level();
+		const auto timestamp = m_console_cache.timestamp(msg);
+		const auto& prefix   = m_console_cache.location(msg);
 		const auto stream    = msg->Stream();
 
-		const auto file = std::filesystem::path(location.file_name()).filename().string();
-
 		if (stream)
-			m_console_out << "[" << timestamp << "][" << stream->get()->Name() << "]" << ADD_COLOR_TO_STREAM(color) << "[" << get_level_string(level) << "/" << file << ":"
-			              << location.line() << "] " << RESET_STREAM_COLOR << msg->Message() << std::flush;
+			m_console_out << "[" << timestamp << "][" << stream->get()->Name() << "]" << ADD_COLOR_TO_STREAM(color) << prefix << RESET_STREAM_COLOR
+			              << msg->Message() << std::flush;
 		else
-			m_console_out << "[" << timestamp << "]" << ADD_COLOR_TO_STREAM(color) << "[" << get_level_string(level) << "/" << file << ":"
-				          << location.line() << "] " << RESET_STREAM_COLOR << msg->Message() << std::flush;
+			m_console_out << "[" << timestamp << "]" << ADD_COLOR_TO_STREAM(color) << prefix << RESET_STREAM_COLOR << msg->Message() << std::flush;
 	}
 
 	void logger::format_console_simple(const LogMessagePtr msg)
@@ -151,21 +218,14 @@ namespace big
 			return;
 		}
 
-		const auto color = get_color(msg->Level());
-
-		const auto timestamp = std::format("{0:%H:%M:%S}", msg->Timestamp());
-		const auto& location = msg->Location();
-		const auto level     = msg->Level();
+		const auto timestamp = m_console_cache.timestamp(msg);
+		const auto& prefix   = m_console_cache.location(msg);
 		const auto stream    = msg->Stream();
 
-		const auto file = std::filesystem::path(location.file_name()).filename().string();
-
 		if (stream)
-			m_console_out << "[" << timestamp << "][" << stream->get()->Name() << "]"
-			                 "[" << get_level_string(level) << "/" << file << ":" << location.line() << "] " << msg->Message() << std::flush;
+			m_console_out << "[" << timestamp << "][" << stream->get()->Name() << "]" << prefix << msg->Message() << std::flush;
 		else
-			m_console_out << "[" << timestamp << "]"
-					         "[" << get_level_string(level) << "/" << file << ":" << location.line() << "] " << msg->Message() << std::flush;
+			m_console_out << "[" << timestamp << "]" << prefix << msg->Message() << std::flush;
 	}
 
 	void logger::format_file(const LogMessagePtr msg)
@@ -173,18 +233,14 @@ namespace big
 		if (!m_file_out.is_open())
 			return;
 
-		const auto timestamp = std::format("{0:%H:%M:%S}", msg->Timestamp());
-		const auto& location = msg->Location();
-		const auto level     = msg->Level();
+		const auto timestamp = m_file_cache.timestamp(msg);
+		const auto& prefix   = m_file_cache.location(msg);
 		const auto stream    = msg->Stream();
 
-		const auto file = std::filesystem::path(location.file_name()).filename().string();
-
+		// the file sink is what's left of a crash, keep flushing per message
 		if (stream)
-			m_file_out << "[" << timestamp << "][" << stream->get()->Name() << "]"
-			              "[" << get_level_string(level) << "/" << file << ":" << location.line() << "] " << msg->Message() << std::flush;
+			m_file_out << "[" << timestamp << "][" << stream->get()->Name() << "]" << prefix << msg->Message() << std::flush;
 		else
-			m_file_out << "[" << timestamp << "]"
-					      "[" << get_level_string(level) << "/" << file << ":" << location.line() << "] " << msg->Message() << std::flush;
+			m_file_out << "[" << timestamp << "]" << prefix << msg->Message() << std::flush;
 	}
 }
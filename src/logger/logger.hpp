@@ -1,5 +1,7 @@
 #pragma once
+#include "binary_log.hpp"
 #include "file_manager.hpp"
+
 #include <AsyncLogger/Logger.hpp>
 using namespace al;
 
@@ -30,6 +32,24 @@ namespace big
 		BLACK   = 30
 	};
 
+	// binary logs have a fixed size of 33 MB, only the last few runs are worth keeping
+	constexpr std::size_t MAX_BINARY_LOG_BACKUPS = 3;
+
+	// text that only depends on the call site or the current minute, one instance per sink so sinks never share state
+	class text_prefix_cache
+	{
+	public:
+		// "[LEVEL/file.cpp:line] "
+		const std::string& location(const LogMessagePtr& msg);
+		// "HH:MM:SS.fffffff"
+		std::string timestamp(const LogMessagePtr& msg);
+
+	private:
+		std::unordered_map<const char*, std::unordered_map<uint32_t, std::string>> m_locations;
+		int64_t m_minute = -1;
+		std::string m_minute_prefix;
+	};
+
 	class logger final
 	{
 	private:
@@ -47,23 +67,33 @@ namespace big
 		std::ofstream m_file_out;
 
 		file m_file;
+		file m_binary_file;
+		binary_log_sink m_binary_log;
+
+		text_prefix_cache m_console_cache;
+		text_prefix_cache m_file_cache;
 
 	public:
 		logger() = default;
 		virtual ~logger() = default;
 
-		void initialize(const std::string_view console_title, file file, bool attach_console = true);
+		/**
+		 * @param file Text log, skipped if text_file is false.
+		 * @param binary_file Memory mapped binary log, see scripts/decode_binary_log.py.
+		 */
+		void initialize(const std::string_view console_title, file file, bool attach_console = true, std::optional<big::file> binary_file = std::nullopt, bool text_file = true);
 		void destroy();
 
 		void toggle_external_console(bool toggle);
 
 	private:
-		void create_backup();
+		void create_backup(file& file);
+		// removes all but the newest max_backups backups of file
+		void prune_backups(const file& file, std::size_t max_backups);
 
 		void format_console(const LogMessagePtr msg);
 		void format_console_simple(const LogMessagePtr msg);
 		void format_file(const LogMessagePtr msg);
-
 	};
 
 	inline logger g_log{};
@@ -171,7 +171,8 @@ namespace lua::network
 	{
 		if (auto player = big::g_player_service->get_by_id(player_idx))
 		{
-			return big::g_player_database_service->get_or_create_player(player)->get_all_infraction_descriptions();
+			const auto entry = big::g_player_database_service->get_or_create_player(player);
+			return big::g_player_database_service->get_player_copy(entry).get_all_infraction_descriptions();
 		}
 
 		return "";
@@ -84,7 +84,7 @@ namespace lua::script
 		    },
 		    name);
 
-		module->m_registered_scripts.push_back(std::move(lua_script));
+		module->add_script(std::move(lua_script));
 	}
 
 	// Lua API: Function
@@ -150,7 +150,7 @@ namespace lua::script
 		    },
 		    job_name);
 
-		module->m_registered_scripts.push_back(std::move(lua_script));
+		module->add_script(std::move(lua_script));
 	}
 
 	// Lua API: function
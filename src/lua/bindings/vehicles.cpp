@@ -50,7 +50,7 @@ namespace lua::vehicles
 	static std::vector<std::string> get_all_vehicles_by_class(std::string vehicle_class)
 	{
 		std::vector<std::string> return_value;
-		for (auto& [name, vehicle] : big::g_gta_data_service.vehicles())
+		for (const auto& vehicle : big::g_gta_data_service.vehicles())
 		{
 			if (vehicle.m_vehicle_class == vehicle_class)
 			{
@@ -76,7 +76,7 @@ namespace lua::vehicles
 	static std::vector<std::string> get_all_vehicles_by_mfr(std::string manufacturer)
 	{
 		std::vector<std::string> return_value;
-		for (auto& [name, vehicle] : big::g_gta_data_service.vehicles())
+		for (const auto& vehicle : big::g_gta_data_service.vehicles())
 		{
 			if (vehicle.m_display_manufacturer == manufacturer)
 			{
@@ -50,7 +50,7 @@ namespace lua::weapons
 	static std::vector<std::string> get_all_weapons_of_group_type(Hash group_hash)
 	{
 		std::vector<std::string> return_value;
-		for (auto& [name, weapon] : big::g_gta_data_service.weapons())
+		for (const auto& weapon : big::g_gta_data_service.weapons())
 		{
 			if (rage::joaat("GROUP_" + weapon.m_weapon_type) == group_hash)
 			{
@@ -85,7 +85,7 @@ namespace lua::weapons
 			group_name.erase(0, 6);
 		}
 		std::vector<std::string> return_value;
-		for (auto& [name, weapon] : big::g_gta_data_service.weapons())
+		for (const auto& weapon : big::g_gta_data_service.weapons())
 		{
 			if (weapon.m_weapon_type == group_name)
 			{
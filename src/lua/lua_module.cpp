@@ -23,6 +23,7 @@
 #include "bindings/weapons.hpp"
 #include "file_manager.hpp"
 #include "script_mgr.hpp"
+#include "script_profiler.hpp"
 
 namespace big
 {
@@ -125,6 +126,7 @@ namespace big
 	{
 		{
 			std::lock_guard guard(m_registered_scripts_mutex);
+			m_script_scheduler.clear();
 			m_registered_scripts.clear();
 			m_registered_script_patches.clear();
 		}
@@ -339,23 +341,25 @@ namespace big
 	void lua_module::tick_scripts()
 	{
 		std::lock_guard guard(m_registered_scripts_mutex);
+		script_profiler::scope profile(this, profiled_kind::LUA_MODULE, m_module_name);
 
-		const auto script_count = m_registered_scripts.size();
-		for (size_t i = 0; i < script_count; i++)
-		{
-			const auto script = m_registered_scripts[i].get();
+		m_script_scheduler.tick();
+	}
 
-			if (script->is_enabled())
-			{
-				script->tick();
-			}
-		}
+	void lua_module::add_script(std::unique_ptr<script> script)
+	{
+		// no lock, this is called by the module's own scripts while tick_scripts holds it
+		m_script_scheduler.add(script.get());
+		m_registered_scripts.push_back(std::move(script));
 	}
 
 	void lua_module::cleanup_done_scripts()
 	{
 		std::lock_guard guard(m_registered_scripts_mutex);
 
+		m_script_scheduler.remove_if([](script* script) {
+			return script->is_done();
+		});
 		std::erase_if(m_registered_scripts, [](auto& script) {
 			return script->is_done();
 		});
@@ -1,5 +1,6 @@
 #pragma once
 #include "../script.hpp"
+#include "../script_scheduler.hpp"
 #include "bindings/gui/gui_element.hpp"
 #include "core/data/menu_event.hpp"
 #include "lua/bindings/runtime_func_t.hpp"
@@ -25,6 +26,7 @@ namespace big
 
 		bool m_disabled;
 		std::mutex m_registered_scripts_mutex;
+		script_scheduler m_script_scheduler;
 
 	public:
 		std::vector<std::unique_ptr<script>> m_registered_scripts;
@@ -79,6 +81,8 @@ namespace big
 			}
 		}
 
+		// Registers a script to be ticked with the module's other scripts.
+		void add_script(std::unique_ptr<script> script);
 		void tick_scripts();
 		void cleanup_done_scripts();
 
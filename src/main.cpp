@@ -160,7 +160,11 @@ BOOL APIENTRY DllMain(HMODULE hmod, DWORD reason, PVOID)
 			    g_file_manager.init(base_dir);
 
 			    g.init(g_file_manager.get_project_file("./settings.json"));
-			    g_log.initialize("YimMenu", g_file_manager.get_project_file("./cout.log"), g.debug.external_console);
+			    g_log.initialize("YimMenu",
+			        g_file_manager.get_project_file("./cout.log"),
+			        g.debug.external_console,
+			        g.debug.logs.binary_file_log ? std::make_optional(g_file_manager.get_project_file("./cout.ylog")) : std::nullopt,
+			        g.debug.logs.text_file_log);
 			    LOG(INFO) << "Settings Loaded and logger initialized.";
 
 			    LOG(INFO) << "Yim's Menu Initializing";
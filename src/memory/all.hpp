@@ -5,5 +5,7 @@
 #include "handle.hpp"
 #include "module.hpp"
 #include "pattern.hpp"
+#include "pattern_batch.hpp"
 #include "range.hpp"
 #include "signature.hpp"
+#include "static_pattern.hpp"
@@ -1,9 +1,12 @@
 #pragma once
 #include "pattern.hpp"
+#include "pattern_batch.hpp"
 #include "range.hpp"
 #include "signature.hpp"
+#include "static_pattern.hpp"
 
-#include <future>
+#include <span>
+#include <unordered_map>
 
 namespace memory
 {
@@ -12,9 +15,9 @@ namespace memory
 	{
 		std::array<signature, N> m_entries;
 
-		constexpr batch(std::array<signature, N> entries)
+		constexpr batch(std::array<signature, N> entries) :
+		    m_entries(entries)
 		{
-			m_entries = entries;
 		}
 	};
 
@@ -35,10 +38,22 @@ namespace memory
 			return (str[0] == '\0') ? hash : fnv1a_32(&str[1], (hash ^ static_cast<uint32_t>(str[0])) * FNV_PRIME_32);
 		}
 
+		static inline constexpr uint32_t fnv1a_32(const static_pattern& pattern, uint32_t hash = FNV_OFFSET_32) noexcept
+		{
+			for (size_t i = 0; i < pattern.m_length; i++)
+			{
+				hash = (hash ^ pattern.m_value[i]) * FNV_PRIME_32;
+				hash = (hash ^ pattern.m_mask[i]) * FNV_PRIME_32;
+			}
+
+			return hash;
+		}
+
 		template<signature sig>
 		static inline constexpr uint32_t compute_hash(uint32_t hash)
 		{
 			hash = fnv1a_32(sig.m_ida, hash);
+			hash = fnv1a_32(sig.m_pattern, hash);
 
 			return hash;
 		}
@@ -67,42 +82,94 @@ namespace memory
 		return batch_and_hash<a1.size()>{h, signature_hasher::add<args...>()};
 	}
 
-	struct batch_runner
+	// Where a signature matched the last time its batch ran.
+	// The pattern hash doubles as the fingerprint: a hit is reused when the pattern still matches in place.
+	struct signature_hit
 	{
-		inline static std::mutex s_entry_mutex;
-		inline static std::vector<std::future<bool>> g_futures;
+		uint32_t m_name_hash;
+		uint32_t m_pattern_hash;
+		uint64_t m_offset;
+	};
 
+	struct batch_runner
+	{
 		template<size_t N>
-		inline static bool run(const memory::batch<N> batch, range region)
+		inline static bool run(const memory::batch<N>& batch, range region, std::span<const signature_hit> previous_hits, std::vector<signature_hit>& hits)
 		{
-			for (auto& entry : batch.m_entries)
+			std::unordered_map<uint64_t, uint64_t> previous_offsets;
+			for (const auto& hit : previous_hits)
 			{
-				g_futures.emplace_back(std::async(&scan_pattern_and_execute_callback, region, entry));
+				previous_offsets.emplace((uint64_t(hit.m_name_hash) << 32) | hit.m_pattern_hash, hit.m_offset);
 			}
 
-			bool found_all_patterns = true;
-			for (auto& future : g_futures)
+			std::array<std::optional<handle>, N> results{};
+			std::vector<size_t> rescan_indices;
+			std::vector<const static_pattern*> patterns;
+			for (size_t i = 0; i < N; i++)
 			{
-				future.wait();
+				const auto& entry = batch.m_entries[i];
 
-				if (!future.get())
-					found_all_patterns = false;
+				if (const auto it = previous_offsets.find(hit_key(entry)); it != previous_offsets.end())
+				{
+					const auto offset = it->second;
+					if (offset + entry.m_pattern.size() <= region.size() && entry.m_pattern.matches(region.begin().add(offset).as<uint8_t*>()))
+					{
+						results[i] = region.begin().add(offset);
+						continue;
+					}
+				}
+
+				rescan_indices.push_back(i);
+				patterns.push_back(&entry.m_pattern);
+			}
+
+			if (!previous_hits.empty())
+			{
+				LOG(INFO) << (N - rescan_indices.size()) << " signatures still match at their cached location, rescanning " << rescan_indices.size();
 			}
 
-			g_futures.clear();
+			// one sweep over the region for everything that has to be rescanned instead of one scan per signature
+			if (!patterns.empty())
+			{
+				const auto scanned = pattern_batch(std::move(patterns)).scan(region);
+				for (size_t i = 0; i < rescan_indices.size(); i++)
+				{
+					results[rescan_indices[i]] = scanned[i];
+				}
+			}
+
+			hits.clear();
+			hits.reserve(N);
+
+			bool found_all_patterns = true;
+			for (size_t i = 0; i < N; i++)
+			{
+				const auto& entry = batch.m_entries[i];
+				if (!execute_callback(region, entry, results[i]))
+				{
+					found_all_patterns = false;
+					continue;
+				}
+
+				const auto key = hit_key(entry);
+				hits.push_back({uint32_t(key >> 32), uint32_t(key), results[i]->as<uintptr_t>() - region.begin().as<uintptr_t>()});
+			}
 
 			return found_all_patterns;
 		}
 
-		inline static bool scan_pattern_and_execute_callback(range region, signature entry)
+		inline static uint64_t hit_key(const signature& entry)
 		{
-			if (auto result = region.scan(entry.m_ida); result.has_value())
+			return (uint64_t(signature_hasher::fnv1a_32(entry.m_name)) << 32) | signature_hasher::fnv1a_32(entry.m_pattern);
+		}
+
+		inline static bool execute_callback(range region, const signature& entry, std::optional<handle> result)
+		{
+			if (result.has_value())
 			{
 				if (entry.m_on_signature_found)
 				{
-					std::lock_guard<std::mutex> lock(s_entry_mutex); // Acquire a lock on the mutex to synchronize access.
-
-					std::invoke(std::move(entry.m_on_signature_found), result.value());
+					std::invoke(entry.m_on_signature_found, result.value());
 					LOG(INFO) << "Found '" << entry.m_name << "' GTA5.exe+"
 					          << HEX_TO_UPPER(result.value().as<DWORD64>() - region.begin().as<DWORD64>());
 
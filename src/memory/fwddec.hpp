@@ -7,5 +7,6 @@ namespace memory
 	class module;
 	class pattern;
 	class pattern_batch;
+	struct static_pattern;
 	class byte_patch;
 }
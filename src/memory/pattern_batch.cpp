@@ -0,0 +1,171 @@
+#include "pattern_batch.hpp"
+
+#include "../common.hpp"
+#include "range.hpp"
+
+#include <future>
+
+namespace memory
+{
+	constexpr std::size_t ANCHOR_KEY_COUNT = UINT16_MAX + 1;
+	constexpr std::size_t NOT_FOUND        = static_cast<std::size_t>(-1);
+
+	// chunks smaller than this aren't worth a thread
+	constexpr std::size_t MIN_CHUNK_SIZE = 4 * 1024 * 1024;
+	constexpr std::size_t MAX_SCAN_THREADS = 8;
+
+	// bytes that show up everywhere in x64 code, anchoring on them makes the bucket fire on most positions
+	static constexpr bool is_common_byte(std::uint8_t b)
+	{
+		switch (b)
+		{
+		case 0x00:
+		case 0x0F:
+		case 0x48:
+		case 0x4C:
+		case 0x83:
+		case 0x89:
+		case 0x8B:
+		case 0xCC:
+		case 0xE8:
+		case 0xFF: return true;
+		default: return false;
+		}
+	}
+
+	static inline std::uint16_t anchor_key(std::uint8_t first, std::uint8_t second)
+	{
+		return static_cast<std::uint16_t>(first | (second << 8));
+	}
+
+	pattern_batch::pattern_batch(std::vector<const static_pattern*> patterns) :
+	    m_patterns(std::move(patterns)),
+	    m_bucket_offsets(ANCHOR_KEY_COUNT + 1, 0)
+	{
+		// pick an anchor for every pattern, preferring uncommon bytes and buckets that are still lightly loaded
+		std::vector<std::uint32_t> bucket_sizes(ANCHOR_KEY_COUNT, 0);
+		std::vector<std::pair<std::uint16_t, candidate>> anchors;
+		anchors.reserve(m_patterns.size());
+
+		for (std::uint32_t pattern_index = 0; pattern_index < m_patterns.size(); ++pattern_index)
+		{
+			const auto& sig = *m_patterns[pattern_index];
+
+			std::optional<std::size_t> best_offset;
+			std::size_t best_score = NOT_FOUND;
+			for (std::size_t i = 0; i + 1 < sig.size(); ++i)
+			{
+				if (sig.is_wildcard(i) || sig.is_wildcard(i + 1))
+					continue;
+
+				const auto key     = anchor_key(sig.m_value[i], sig.m_value[i + 1]);
+				const auto penalty = (is_common_byte(sig.m_value[i]) ? 2 : 0) + (is_common_byte(sig.m_value[i + 1]) ? 2 : 0);
+				const auto score   = bucket_sizes[key] + penalty;
+				if (score < best_score)
+				{
+					best_score  = score;
+					best_offset = i;
+				}
+			}
+
+			if (!best_offset)
+			{
+				m_unanchored.push_back(pattern_index);
+				continue;
+			}
+
+			const auto key = anchor_key(sig.m_value[*best_offset], sig.m_value[*best_offset + 1]);
+			++bucket_sizes[key];
+			anchors.push_back({key, {pattern_index, static_cast<std::uint32_t>(*best_offset)}});
+		}
+
+		// flatten the buckets
+		for (std::size_t key = 0; key < ANCHOR_KEY_COUNT; ++key)
+			m_bucket_offsets[key + 1] = m_bucket_offsets[key] + bucket_sizes[key];
+
+		m_candidates.resize(anchors.size());
+		std::vector<std::uint32_t> cursor(m_bucket_offsets.begin(), m_bucket_offsets.end() - 1);
+		for (const auto& [key, entry] : anchors)
+			m_candidates[cursor[key]++] = entry;
+	}
+
+	void pattern_batch::scan_chunk(const std::uint8_t* data, std::size_t data_size, std::size_t chunk_begin, std::size_t chunk_end, std::atomic<std::size_t>* results) const
+	{
+		for (std::size_t pos = chunk_begin; pos < chunk_end; ++pos)
+		{
+			const auto key   = anchor_key(data[pos], data[pos + 1]);
+			const auto first = m_bucket_offsets[key];
+			const auto last  = m_bucket_offsets[key + 1];
+			if (first == last) [[likely]]
+				continue;
+
+			for (auto i = first; i != last; ++i)
+			{
+				const auto& entry = m_candidates[i];
+				if (pos < entry.m_anchor_offset)
+					continue;
+
+				const auto start  = pos - entry.m_anchor_offset;
+				const auto& sig   = *m_patterns[entry.m_pattern_index];
+				if (start + sig.size() > data_size)
+					continue;
+
+				auto& result = results[entry.m_pattern_index];
+				auto current = result.load(std::memory_order_relaxed);
+				if (start >= current)
+					continue;
+
+				if (!sig.matches(data + start))
+					continue;
+
+				// chunks run concurrently, keep the lowest hit so results match a sequential scan
+				while (start < current && !result.compare_exchange_weak(current, start, std::memory_order_relaxed))
+					;
+			}
+		}
+	}
+
+	std::vector<std::optional<handle>> pattern_batch::scan(const range& region, std::size_t max_threads) const
+	{
+		const auto data      = region.begin().as<const std::uint8_t*>();
+		const auto data_size = region.size();
+
+		auto results = std::make_unique<std::atomic<std::size_t>[]>(m_patterns.size());
+		for (std::size_t i = 0; i < m_patterns.size(); ++i)
+			results[i].store(NOT_FOUND, std::memory_order_relaxed);
+
+		if (data_size >= 2 && !m_candidates.empty())
+		{
+			// anchors read two bytes, the last valid anchor position is data_size - 2
+			const auto positions = data_size - 1;
+
+			if (!max_threads)
+				max_threads = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, MAX_SCAN_THREADS);
+			const auto chunk_count = std::clamp<std::size_t>(positions / MIN_CHUNK_SIZE, 1, max_threads);
+			const auto chunk_size  = (positions + chunk_count - 1) / chunk_count;
+
+			std::vector<std::future<void>> futures;
+			futures.reserve(chunk_count);
+			for (std::size_t chunk_begin = 0; chunk_begin < positions; chunk_begin += chunk_size)
+			{
+				const auto chunk_end = std::min(chunk_begin + chunk_size, positions);
+				futures.emplace_back(std::async(std::launch::async, &pattern_batch::scan_chunk, this, data, data_size, chunk_begin, chunk_end, results.get()));
+			}
+
+			for (auto& future : futures)
+				future.get();
+		}
+
+		std::vector<std::optional<handle>> found(m_patterns.size());
+		for (std::size_t i = 0; i < m_patterns.size(); ++i)
+		{
+			if (const auto offset = results[i].load(std::memory_order_relaxed); offset != NOT_FOUND)
+				found[i] = region.begin().add(offset);
+		}
+
+		for (const auto pattern_index : m_unanchored)
+			found[pattern_index] = region.scan(*m_patterns[pattern_index]);
+
+		return found;
+	}
+}
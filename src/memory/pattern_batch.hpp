@@ -0,0 +1,57 @@
+#pragma once
+#include "fwddec.hpp"
+#include "handle.hpp"
+#include "static_pattern.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace memory
+{
+	/**
+	 * @brief Scans a range for many patterns at once.
+	 *
+	 * Every pattern is bucketed by a two byte anchor taken from its non-wildcard bytes,
+	 * the range is then walked a single time (split in chunks across a bounded number of threads)
+	 * and only the patterns sharing the anchor found at the current position are compared.
+	 */
+	class pattern_batch
+	{
+	public:
+		/**
+		 * @brief Builds the anchor buckets for the given patterns.
+		 *
+		 * @param patterns Patterns to scan for, they have to outlive the batch.
+		 */
+		explicit pattern_batch(std::vector<const static_pattern*> patterns);
+
+		/**
+		 * @brief Scans the given range for every pattern of the batch.
+		 *
+		 * @param region Range to scan.
+		 * @param max_threads Upper bound of worker threads, 0 to pick one based on the hardware.
+		 * @return The lowest match of each pattern, in the order the patterns were given.
+		 */
+		std::vector<std::optional<handle>> scan(const range& region, std::size_t max_threads = 0) const;
+
+	private:
+		struct candidate
+		{
+			std::uint32_t m_pattern_index;
+			std::uint32_t m_anchor_offset;
+		};
+
+		void scan_chunk(const std::uint8_t* data, std::size_t data_size, std::size_t chunk_begin, std::size_t chunk_end, std::atomic<std::size_t>* results) const;
+
+		std::vector<const static_pattern*> m_patterns;
+
+		// CSR layout, candidates of anchor key K are m_candidates[m_bucket_offsets[K]..m_bucket_offsets[K + 1]]
+		std::vector<std::uint32_t> m_bucket_offsets;
+		std::vector<candidate> m_candidates;
+
+		// patterns without a two byte anchor, these go through range::scan instead
+		std::vector<std::uint32_t> m_unanchored;
+	};
+}
@@ -2,6 +2,10 @@
 
 #include "../common.hpp"
 #include "pattern.hpp"
+#include "static_pattern.hpp"
+
+#include <bit>
+#include <intrin.h>
 
 namespace memory
 {
@@ -35,6 +39,9 @@ namespace memory
 	// https://www.youtube.com/watch?v=AuZUeshhy-s
 	std::optional<handle> scan_pattern(const std::optional<uint8_t>* sig, std::size_t length, handle begin, std::size_t module_size)
 	{
+		if (!length || module_size < length)
+			return std::nullopt;
+
 		std::size_t maxShift = length;
 		std::size_t max_idx  = length - 1;
 
@@ -83,11 +90,275 @@ namespace memory
 		return std::nullopt;
 	}
 
+	bool pattern_matches(uint8_t* target, const std::optional<uint8_t>* sig, std::size_t length)
+	{
+		for (std::size_t i{}; i != length; ++i)
+		{
+			if (sig[i] && *sig[i] != target[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Value/mask form of a pattern for the vector kernels.
+	// Two non-wildcard bytes are used as a filter: a whole vector of start positions is tested against them at once
+	// and only the positions where both match are verified against the full value/mask pair.
+	// The value and mask buffers have to be padded with wildcards to m_padded_length.
+	struct simd_pattern
+	{
+		const uint8_t* m_value;
+		const uint8_t* m_mask;
+		std::size_t m_length;
+		std::size_t m_padded_length;
+		std::size_t m_first;
+		std::size_t m_last;
+
+		static std::optional<simd_pattern> create(const uint8_t* value, const uint8_t* mask, std::size_t length, std::size_t padded_length)
+		{
+			std::optional<std::size_t> first, last;
+			for (std::size_t i{}; i != length; ++i)
+			{
+				if (!mask[i])
+					continue;
+
+				if (!first)
+					first = i;
+				last = i;
+			}
+
+			if (!first || *first == *last)
+				return std::nullopt;
+
+			return simd_pattern{value, mask, length, padded_length, *first, *last};
+		}
+	};
+
+	// pad to a multiple of the widest vector so verification never needs a partial load of the pattern
+	static constexpr std::size_t pad_pattern_length(std::size_t length)
+	{
+		return (length + 31) & ~std::size_t(31);
+	}
+
+	static_assert(MAX_STATIC_PATTERN_LENGTH == pad_pattern_length(MAX_STATIC_PATTERN_LENGTH));
+
+	// Owns the value/mask buffers of a runtime parsed pattern.
+	struct runtime_simd_buffers
+	{
+		std::vector<uint8_t> m_value;
+		std::vector<uint8_t> m_mask;
+
+		explicit runtime_simd_buffers(const std::optional<uint8_t>* sig, std::size_t length) :
+		    m_value(pad_pattern_length(length), 0),
+		    m_mask(pad_pattern_length(length), 0)
+		{
+			for (std::size_t i{}; i != length; ++i)
+			{
+				if (sig[i])
+				{
+					m_value[i] = *sig[i];
+					m_mask[i]  = 0xFF;
+				}
+			}
+		}
+	};
+
+	struct sse_traits
+	{
+		using vector = __m128i;
+
+		static constexpr std::size_t WIDTH = 16;
+
+		static vector load(const uint8_t* ptr)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		}
+
+		static vector broadcast(uint8_t value)
+		{
+			return _mm_set1_epi8(static_cast<char>(value));
+		}
+
+		static uint32_t eq_mask(vector a, vector b)
+		{
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+		}
+
+		static bool masked_eq(vector data, vector value, vector mask)
+		{
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(data, mask), value)) == 0xFFFF;
+		}
+	};
+
+	struct avx2_traits
+	{
+		using vector = __m256i;
+
+		static constexpr std::size_t WIDTH = 32;
+
+		static vector load(const uint8_t* ptr)
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+		}
+
+		static vector broadcast(uint8_t value)
+		{
+			return _mm256_set1_epi8(static_cast<char>(value));
+		}
+
+		static uint32_t eq_mask(vector a, vector b)
+		{
+			return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+		}
+
+		static bool masked_eq(vector data, vector value, vector mask)
+		{
+			return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(data, mask), value)) == -1;
+		}
+	};
+
+	template<typename traits>
+	static bool verify_simd(const uint8_t* target, const simd_pattern& sig)
+	{
+		for (std::size_t i{}; i < sig.m_padded_length; i += traits::WIDTH)
+		{
+			if (!traits::masked_eq(traits::load(target + i), traits::load(sig.m_value + i), traits::load(sig.m_mask + i)))
+				return false;
+		}
+
+		return true;
+	}
+
+	static bool verify_scalar(const uint8_t* target, const simd_pattern& sig)
+	{
+		for (std::size_t i{}; i != sig.m_length; ++i)
+		{
+			if ((target[i] & sig.m_mask[i]) != sig.m_value[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	// Returns the offset of the first match at or after `from`, or std::nullopt.
+	template<typename traits>
+	static std::optional<std::size_t> find_simd(const uint8_t* data, std::size_t size, const simd_pattern& sig, std::size_t from)
+	{
+		if (size < sig.m_length)
+			return std::nullopt;
+
+		const auto scan_end    = size - sig.m_length;
+		const auto padded_size = sig.m_padded_length;
+		const auto first       = traits::broadcast(sig.m_value[sig.m_first]);
+		const auto last        = traits::broadcast(sig.m_value[sig.m_last]);
+
+		std::size_t current_idx = from;
+		for (; current_idx + sig.m_last + traits::WIDTH <= size && current_idx <= scan_end; current_idx += traits::WIDTH)
+		{
+			auto candidates = traits::eq_mask(traits::load(data + current_idx + sig.m_first), first)
+			    & traits::eq_mask(traits::load(data + current_idx + sig.m_last), last);
+
+			while (candidates)
+			{
+				const auto idx = current_idx + std::countr_zero(candidates);
+				candidates &= candidates - 1;
+
+				if (idx > scan_end)
+					return std::nullopt;
+
+				const auto target = data + idx;
+				if (idx + padded_size <= size ? verify_simd<traits>(target, sig) : verify_scalar(target, sig))
+					return idx;
+			}
+		}
+
+		// tail that is too short for a full vector load
+		for (; current_idx <= scan_end; ++current_idx)
+		{
+			if (verify_scalar(data + current_idx, sig))
+				return current_idx;
+		}
+
+		return std::nullopt;
+	}
+
+	enum class simd_level
+	{
+		NONE,
+		SSE42,
+		AVX2
+	};
+
+	static simd_level detect_simd_level()
+	{
+		int regs[4]{};
+		__cpuid(regs, 0);
+		const auto max_leaf = regs[0];
+
+		__cpuid(regs, 1);
+		const bool sse42   = regs[2] & (1 << 20);
+		const bool osxsave = regs[2] & (1 << 27);
+		const bool avx     = regs[2] & (1 << 28);
+
+		// the OS has to save the ymm registers on context switches as well
+		bool avx2 = false;
+		if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+		{
+			__cpuidex(regs, 7, 0);
+			avx2 = regs[1] & (1 << 5);
+		}
+
+		if (avx2)
+			return simd_level::AVX2;
+		if (sse42)
+			return simd_level::SSE42;
+		return simd_level::NONE;
+	}
+
+	static simd_level get_simd_level()
+	{
+		static const simd_level level = detect_simd_level();
+		return level;
+	}
+
+	static std::optional<std::size_t> find_next(const uint8_t* data, std::size_t size, const simd_pattern& sig, std::size_t from)
+	{
+		switch (get_simd_level())
+		{
+		case simd_level::AVX2: return find_simd<avx2_traits>(data, size, sig, from);
+		case simd_level::SSE42: return find_simd<sse_traits>(data, size, sig, from);
+		default: break;
+		}
+
+		for (auto current_idx = from; current_idx + sig.m_length <= size; ++current_idx)
+		{
+			if (verify_scalar(data + current_idx, sig))
+				return current_idx;
+		}
+
+		return std::nullopt;
+	}
+
 	std::optional<handle> range::scan(pattern const& sig) const
 	{
 		auto data   = sig.m_bytes.data();
 		auto length = sig.m_bytes.size();
 
+		if (get_simd_level() != simd_level::NONE)
+		{
+			const runtime_simd_buffers buffers(data, length);
+			if (const auto simd_sig = simd_pattern::create(buffers.m_value.data(), buffers.m_mask.data(), length, buffers.m_value.size()))
+			{
+				if (auto result = find_next(m_base.as<uint8_t*>(), m_size, *simd_sig, 0); result)
+					return m_base.add(*result);
+
+				return std::nullopt;
+			}
+		}
+
+		// patterns with less than two fixed bytes and cpus without vector support go through BMH
 		if (auto result = scan_pattern(data, length, m_base, m_size); result)
 		{
 			return result;
@@ -96,17 +367,25 @@ namespace memory
 		return std::nullopt;
 	}
 
-	bool pattern_matches(uint8_t* target, const std::optional<uint8_t>* sig, std::size_t length)
+	std::optional<handle> range::scan(static_pattern const& sig) const
 	{
-		for (std::size_t i{}; i != length; ++i)
+		const auto base = m_base.as<uint8_t*>();
+
+		if (const auto simd_sig = simd_pattern::create(sig.m_value.data(), sig.m_mask.data(), sig.size(), pad_pattern_length(sig.size())))
 		{
-			if (sig[i] && *sig[i] != target[i])
-			{
-				return false;
-			}
+			if (auto result = find_next(base, m_size, *simd_sig, 0); result)
+				return m_base.add(*result);
+
+			return std::nullopt;
 		}
 
-		return true;
+		for (std::size_t current_idx{}; current_idx + sig.size() <= m_size; ++current_idx)
+		{
+			if (sig.matches(base + current_idx))
+				return m_base.add(current_idx);
+		}
+
+		return std::nullopt;
 	}
 
 	std::vector<handle> range::scan_all(pattern const& sig) const
@@ -115,8 +394,23 @@ namespace memory
 		auto data   = sig.m_bytes.data();
 		auto length = sig.m_bytes.size();
 
+		const runtime_simd_buffers buffers(data, length);
+		if (const auto simd_sig = simd_pattern::create(buffers.m_value.data(), buffers.m_mask.data(), length, buffers.m_value.size()))
+		{
+			const auto base = m_base.as<uint8_t*>();
+			for (auto offset = find_next(base, m_size, *simd_sig, 0); offset; offset = find_next(base, m_size, *simd_sig, *offset + 1))
+			{
+				result.push_back(m_base.add(*offset));
+			}
+
+			return result;
+		}
+
+		if (!length || m_size < length)
+			return result;
+
 		const auto scan_end = m_size - length;
-		for (std::uintptr_t i{}; i != scan_end; ++i)
+		for (std::uintptr_t i{}; i <= scan_end; ++i)
 		{
 			if (pattern_matches(m_base.add(i).as<uint8_t*>(), data, length))
 			{
@@ -18,6 +18,7 @@ namespace memory
 		bool contains(handle h) const;
 
 		std::optional<handle> scan(pattern const& sig) const;
+		std::optional<handle> scan(static_pattern const& sig) const;
 		std::vector<handle> scan_all(pattern const& sig) const;
 
 	protected:
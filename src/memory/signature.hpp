@@ -1,4 +1,5 @@
 #pragma once
+#include "static_pattern.hpp"
 
 namespace memory
 {
@@ -6,6 +7,15 @@ namespace memory
 	{
 		const char* m_name;
 		const char* m_ida;
+		static_pattern m_pattern;
 		void (*m_on_signature_found)(memory::handle ptr);
+
+		consteval signature(const char* name, const char* ida, void (*on_signature_found)(memory::handle ptr)) :
+		    m_name(name),
+		    m_ida(ida),
+		    m_pattern(ida),
+		    m_on_signature_found(on_signature_found)
+		{
+		}
 	};
 }
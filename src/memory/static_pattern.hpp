@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace memory
+{
+	// longest signature in the pointers batches is well under this, a multiple of 32 keeps the vector verification simple
+	constexpr std::size_t MAX_STATIC_PATTERN_LENGTH = 96;
+
+	/**
+	 * @brief IDA style pattern parsed at compile time into a packed value/mask pair.
+	 *
+	 * Wildcards have a mask of 0x00 and a value of 0x00, fixed bytes have a mask of 0xFF.
+	 * Bytes past m_length are wildcards as well, so the arrays can always be compared in full vector widths.
+	 * A malformed signature is not a constant expression and fails the build.
+	 */
+	struct static_pattern
+	{
+		alignas(16) std::array<std::uint8_t, MAX_STATIC_PATTERN_LENGTH> m_value{};
+		alignas(16) std::array<std::uint8_t, MAX_STATIC_PATTERN_LENGTH> m_mask{};
+		std::size_t m_length{};
+
+		consteval static_pattern(const char* ida_sig)
+		{
+			for (std::size_t i = 0; ida_sig[i] != '\0';)
+			{
+				if (ida_sig[i] == ' ')
+				{
+					++i;
+					continue;
+				}
+
+				if (m_length == MAX_STATIC_PATTERN_LENGTH)
+					throw "Signature is longer than MAX_STATIC_PATTERN_LENGTH";
+
+				if (ida_sig[i] == '?')
+				{
+					// accept both "?" and "??"
+					i += ida_sig[i + 1] == '?' ? 2 : 1;
+					++m_length;
+				}
+				else
+				{
+					const auto high = to_nibble(ida_sig[i]);
+					const auto low  = to_nibble(ida_sig[i + 1]);
+
+					m_value[m_length] = static_cast<std::uint8_t>(high * 0x10 + low);
+					m_mask[m_length]  = 0xFF;
+					++m_length;
+					i += 2;
+				}
+
+				if (ida_sig[i] != ' ' && ida_sig[i] != '\0')
+					throw "Signature bytes have to be separated by spaces";
+			}
+
+			if (m_length == 0)
+				throw "Signature is empty";
+		}
+
+		constexpr std::size_t size() const
+		{
+			return m_length;
+		}
+
+		constexpr bool is_wildcard(std::size_t idx) const
+		{
+			return m_mask[idx] == 0;
+		}
+
+		constexpr bool matches(const std::uint8_t* target) const
+		{
+			for (std::size_t i = 0; i != m_length; ++i)
+			{
+				if ((target[i] & m_mask[i]) != m_value[i])
+					return false;
+			}
+
+			return true;
+		}
+
+	private:
+		static consteval std::uint8_t to_nibble(char c)
+		{
+			if (c >= '0' && c <= '9')
+				return static_cast<std::uint8_t>(c - '0');
+			if (c >= 'a' && c <= 'f')
+				return static_cast<std::uint8_t>(c - 'a' + 0xA);
+			if (c >= 'A' && c <= 'F')
+				return static_cast<std::uint8_t>(c - 'A' + 0xA);
+
+			throw "Signature contains a character that isn't hexadecimal";
+		}
+	};
+}
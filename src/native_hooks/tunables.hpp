@@ -18,8 +18,7 @@ namespace big
 		{
 			if (g_tunables_service->caching_tunables())
 			{
-				g_tunables_service->m_junk_values.emplace(g_tunables_service->m_current_junk_val, src->get_arg<Hash>(0));
-				src->set_return_value<int>(g_tunables_service->m_current_junk_val++);
+				src->set_return_value<int>(g_tunables_service->add_junk_value(src->get_arg<Hash>(0)));
 				return;
 			}
 			src->set_return_value<int>(NETWORK::_NETWORK_GET_TUNABLES_REGISTRATION_INT(src->get_arg<Hash>(0), src->get_arg<int>(1)));
@@ -29,8 +28,7 @@ namespace big
 		{
 			if (g_tunables_service->caching_tunables())
 			{
-				g_tunables_service->m_junk_values.emplace(g_tunables_service->m_current_junk_val, src->get_arg<Hash>(0));
-				src->set_return_value<int>(g_tunables_service->m_current_junk_val++);
+				src->set_return_value<int>(g_tunables_service->add_junk_value(src->get_arg<Hash>(0)));
 				return;
 			}
 			src->set_return_value<BOOL>(NETWORK::_NETWORK_GET_TUNABLES_REGISTRATION_BOOL(src->get_arg<Hash>(0), src->get_arg<BOOL>(1)));
@@ -40,8 +38,7 @@ namespace big
 		{
 			if (g_tunables_service->caching_tunables())
 			{
-				g_tunables_service->m_junk_values.emplace(g_tunables_service->m_current_junk_val, src->get_arg<Hash>(0));
-				src->set_return_value<int>(g_tunables_service->m_current_junk_val++);
+				src->set_return_value<int>(g_tunables_service->add_junk_value(src->get_arg<Hash>(0)));
 				return;
 			}
 			src->set_return_value<float>(NETWORK::_NETWORK_GET_TUNABLES_REGISTRATION_FLOAT(src->get_arg<Hash>(0), src->get_arg<float>(1)));
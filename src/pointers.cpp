@@ -2029,23 +2029,29 @@ namespace big
 		return batch_and_hash;
 	}
 
-	void pointers::load_pointers_from_cache(const cache_file& cache_file, const uintptr_t pointer_to_cacheable_data_start, const memory::module& mem_region)
+	bool pointers::load_pointers_from_cache(const cache_file& cache_file, size_t field_count, const uintptr_t pointer_to_cacheable_data_start, const memory::module& mem_region)
 	{
 		// fill pointers instance fields by reading the file data into it
 
+		const auto header = get_pointers_cache_header(cache_file);
+		if (!header || header->m_field_count != field_count)
+		{
+			LOG(WARNING) << "Pointers cache doesn't match the layout of the pointers instance, rescanning";
+			return false;
+		}
+
 		LOG(INFO) << "Loading pointers instance from cache";
 
 		// multiple things here:
 		// - iterate each cacheable field of the pointers instance
 		// - add the base module address to the current offset retrieved from the cache
 		// - assign that ptr to the pointers field
-		uintptr_t* cache_data = reinterpret_cast<uintptr_t*>(cache_file.data());
+		const uintptr_t* cache_data = reinterpret_cast<const uintptr_t*>(cache_file.data() + sizeof(pointers_cache_header));
 
-		const size_t field_count_from_cache = cache_file.data_size() / sizeof(uintptr_t);
-		LOG(INFO) << "Pointers cache: Loading " << field_count_from_cache << " fields from the cache";
+		LOG(INFO) << "Pointers cache: Loading " << field_count << " fields from the cache";
 
 		uintptr_t* field_ptr = reinterpret_cast<uintptr_t*>(pointer_to_cacheable_data_start);
-		for (size_t i = 0; i < field_count_from_cache; i++)
+		for (size_t i = 0; i < field_count; i++)
 		{
 			uintptr_t offset = cache_data[i];
 			uintptr_t ptr    = offset + mem_region.begin().as<uintptr_t>();
@@ -2061,6 +2067,34 @@ namespace big
 
 			field_ptr++;
 		}
+
+		return true;
+	}
+
+	const pointers::pointers_cache_header* pointers::get_pointers_cache_header(const cache_file& cache_file) const
+	{
+		if (!cache_file.data() || cache_file.data_size() < sizeof(pointers_cache_header))
+			return nullptr;
+
+		const auto header = reinterpret_cast<const pointers_cache_header*>(cache_file.data());
+		if (header->m_magic != POINTERS_CACHE_MAGIC)
+			return nullptr;
+
+		const auto expected_size = sizeof(pointers_cache_header) + uint64_t(header->m_field_count) * sizeof(uintptr_t) + uint64_t(header->m_hit_count) * sizeof(memory::signature_hit);
+		if (cache_file.data_size() != expected_size)
+			return nullptr;
+
+		return header;
+	}
+
+	std::span<const memory::signature_hit> pointers::get_signature_hits_from_cache(const cache_file& cache_file) const
+	{
+		const auto header = get_pointers_cache_header(cache_file);
+		if (!header)
+			return {};
+
+		const auto fields_size = header->m_field_count * sizeof(uintptr_t);
+		return {reinterpret_cast<const memory::signature_hit*>(cache_file.data() + sizeof(pointers_cache_header) + fields_size), header->m_hit_count};
 	}
 
 	pointers::pointers() :
@@ -16,47 +16,83 @@ namespace big
 	class pointers
 	{
 	private:
+		// Bump when the layout of the pointers cache data changes
+		static constexpr uint32_t POINTERS_CACHE_FORMAT = 2;
+		static constexpr uint32_t POINTERS_CACHE_MAGIC  = 0x52545059; // YPTR
+
+		// Cache data is this header, followed by the field offsets and then the signature hits
+		struct pointers_cache_header
+		{
+			uint32_t m_magic;
+			uint32_t m_field_count;
+			uint32_t m_hit_count;
+			uint32_t m_reserved;
+		};
+
 		template<cstxpr_str batch_name, auto batch_hash, size_t offset_of_cache_begin_field, size_t offset_of_cache_end_field, memory::batch batch>
 		void write_to_cache_or_read_from_cache(cache_file& cache_file, const memory::module& mem_region)
 		{
 			static_assert(batch_hash > 0);
 
 			constexpr size_t field_count = (offset_of_cache_end_field - offset_of_cache_begin_field) / sizeof(void*);
-			constexpr auto cache_version = batch_hash + field_count;
+			constexpr auto cache_version = batch_hash + field_count + POINTERS_CACHE_FORMAT;
 
 			cache_file.set_cache_version(cache_version);
 
 			const uintptr_t pointer_to_cacheable_data_start = reinterpret_cast<uintptr_t>(this) + offset_of_cache_begin_field;
 
-			if (!is_pointers_cache_up_to_date<batch_name>(cache_file, mem_region))
+			// a cache that is up to date but doesn't hold exactly our fields gets rescanned like an outdated one
+			if (!is_pointers_cache_up_to_date<batch_name>(cache_file, mem_region) || !load_pointers_from_cache(cache_file, field_count, pointer_to_cacheable_data_start, mem_region))
 			{
-				run_batch<batch_name>(batch, mem_region);
+				// signatures that still match where they were found last time don't need to be rescanned
+				std::vector<memory::signature_hit> hits;
+				run_batch<batch_name>(batch, mem_region, get_signature_hits_from_cache(cache_file), hits);
 
 				const uintptr_t pointer_to_cacheable_data_end = reinterpret_cast<uintptr_t>(this) + offset_of_cache_end_field;
-				write_pointers_to_cache<batch_name, offset_of_cache_begin_field, offset_of_cache_end_field>(cache_file, pointer_to_cacheable_data_start, pointer_to_cacheable_data_end, mem_region);
-			}
-			else
-			{
-				load_pointers_from_cache(cache_file, pointer_to_cacheable_data_start, mem_region);
+				write_pointers_to_cache<batch_name, offset_of_cache_begin_field, offset_of_cache_end_field>(cache_file, pointer_to_cacheable_data_start, pointer_to_cacheable_data_end, hits, mem_region);
 			}
 
 			cache_file.free();
 		}
 
-		void load_pointers_from_cache(const cache_file& cache_file, const uintptr_t pointer_to_cacheable_data_start, const memory::module& mem_region);
+		/// <summary>
+		/// Fills the cacheable fields from the offsets stored in the cache.
+		/// </summary>
+		/// <returns>False without touching any field if the cache doesn't hold exactly field_count fields.</returns>
+		bool load_pointers_from_cache(const cache_file& cache_file, size_t field_count, const uintptr_t pointer_to_cacheable_data_start, const memory::module& mem_region);
+
+		/// <summary>
+		/// Gets the header of the cache data if its magic and size agree with the field and hit counts in it.
+		/// </summary>
+		/// <returns>The header, nullptr if the cache doesn't exist or has an unknown layout.</returns>
+		const pointers_cache_header* get_pointers_cache_header(const cache_file& cache_file) const;
+
+		/// <summary>
+		/// Gets the signature hits stored in a cache that may belong to an older game or batch version.
+		/// </summary>
+		/// <returns>The hits, empty if the cache doesn't exist or has an unknown layout.</returns>
+		std::span<const memory::signature_hit> get_signature_hits_from_cache(const cache_file& cache_file) const;
 
 		template<cstxpr_str batch_name, size_t offset_of_cache_begin_field, size_t offset_of_cache_end_field>
-		void write_pointers_to_cache(cache_file& cache_file, const uintptr_t pointer_to_cacheable_data_start, const uintptr_t pointer_to_cacheable_data_end, const memory::module& mem_region)
+		void write_pointers_to_cache(cache_file& cache_file, const uintptr_t pointer_to_cacheable_data_start, const uintptr_t pointer_to_cacheable_data_end, const std::vector<memory::signature_hit>& hits, const memory::module& mem_region)
 		{
-			constexpr size_t data_size = offset_of_cache_end_field - offset_of_cache_begin_field;
+			constexpr size_t fields_size = offset_of_cache_end_field - offset_of_cache_begin_field;
+			const size_t hits_size       = hits.size() * sizeof(memory::signature_hit);
+			const size_t data_size       = sizeof(pointers_cache_header) + fields_size + hits_size;
 
 			cache_data cache_data_ptr = std::make_unique<uint8_t[]>(data_size);
 
+			auto header           = reinterpret_cast<pointers_cache_header*>(cache_data_ptr.get());
+			header->m_magic       = POINTERS_CACHE_MAGIC;
+			header->m_field_count = static_cast<uint32_t>(fields_size / sizeof(uintptr_t));
+			header->m_hit_count   = static_cast<uint32_t>(hits.size());
+			header->m_reserved    = 0;
+
 			// multiple things here:
 			// - iterate each cacheable field of the pointers instance
 			// - substract the base module address so that we only keep the offsets
 			// - save that to the cache
-			uintptr_t* cache_data = reinterpret_cast<uintptr_t*>(cache_data_ptr.get());
+			uintptr_t* cache_data = reinterpret_cast<uintptr_t*>(cache_data_ptr.get() + sizeof(pointers_cache_header));
 
 			size_t i = 0;
 			for (uintptr_t field_ptr = pointer_to_cacheable_data_start; field_ptr != pointer_to_cacheable_data_end; field_ptr += sizeof(uintptr_t))
@@ -76,7 +112,9 @@ namespace big
 				i++;
 			}
 
-			LOG(INFO) << "Pointers cache: saved " << (data_size / sizeof(uintptr_t)) << " fields to the cache";
+			memcpy(cache_data_ptr.get() + sizeof(pointers_cache_header) + fields_size, hits.data(), hits_size);
+
+			LOG(INFO) << "Pointers cache: saved " << header->m_field_count << " fields and " << header->m_hit_count << " signature hits to the cache";
 
 			cache_file.set_data(std::move(cache_data_ptr), data_size);
 
@@ -103,9 +141,9 @@ namespace big
 		static constexpr auto get_sc_batch();
 
 		template<cstxpr_str batch_name, size_t N>
-		void run_batch(const memory::batch<N>& batch, const memory::module& mem_region)
+		void run_batch(const memory::batch<N>& batch, const memory::module& mem_region, std::span<const memory::signature_hit> previous_hits, std::vector<memory::signature_hit>& hits)
 		{
-			if (!memory::batch_runner::run(batch, mem_region))
+			if (!memory::batch_runner::run(batch, mem_region, previous_hits, hits))
 			{
 				auto message = std::format("Failed to find some patterns for {}", batch_name.str);
 
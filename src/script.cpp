@@ -1,6 +1,8 @@
 #pragma once
 #include "script.hpp"
 
+#include "script_profiler.hpp"
+
 namespace big
 {
 	script::script(const func_t func, const std::string& name, const bool toggleable, const std::optional<std::size_t> stack_size) :
@@ -64,11 +66,17 @@ namespace big
 		return m_done;
 	}
 
+	std::optional<std::chrono::high_resolution_clock::time_point> script::wake_time() const
+	{
+		return m_wake_time;
+	}
+
 	void script::tick()
 	{
 		m_main_fiber = GetCurrentFiber();
 		if (!m_wake_time.has_value() || m_wake_time.value() <= std::chrono::high_resolution_clock::now())
 		{
+			script_profiler::scope profile(this, profiled_kind::SCRIPT, m_name, 1);
 			SwitchToFiber(m_script_fiber);
 		}
 	}
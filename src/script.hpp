@@ -26,6 +26,9 @@ namespace big
 
 		[[nodiscard]] bool is_done() const;
 
+		// when the script asked to be resumed, nullopt if it wants to run on every tick
+		[[nodiscard]] std::optional<std::chrono::high_resolution_clock::time_point> wake_time() const;
+
 		void tick();
 		void yield(std::optional<std::chrono::high_resolution_clock::duration> time = std::nullopt);
 		static script* get_current();
@@ -1,5 +1,7 @@
 #include "script_function.hpp"
 
+#include "services/script_patcher/script_patcher_service.hpp"
+
 namespace big
 {
 	script_function::script_function(const std::string& name, const rage::joaat_t script, const std::string& pattern) :
@@ -8,23 +10,50 @@ namespace big
 	    m_pattern(pattern),
 	    m_ip(0)
 	{
+		get_all().push_back(this);
 	}
 
-	uint32_t script_function::get_ip(rage::scrProgram* program)
+	std::vector<script_function*>& script_function::get_all()
 	{
-		if (m_ip != 0)
-			return m_ip;
+		// the functions are globals spread over several translation units, this can't be a global itself
+		static std::vector<script_function*> functions;
+		return functions;
+	}
 
-		if (auto location = scripts::get_code_location_by_pattern(program, m_pattern))
+	void script_function::resolve_all(rage::scrProgram* program)
+	{
+		std::vector<script_function*> functions;
+		std::vector<const memory::pattern*> patterns;
+		for (auto function : get_all())
 		{
-			m_ip = *location;
-			LOG(VERBOSE) << "Found pattern " << m_name << " at " << HEX_TO_UPPER(m_ip) << " in script " << program->m_name;
+			if (function->m_script == program->m_name_hash && function->m_ip == 0)
+			{
+				functions.push_back(function);
+				patterns.push_back(&function->m_pattern);
+			}
 		}
-		else
+
+		const auto locations = g_script_patcher_service ? g_script_patcher_service->find_code_locations(program, patterns) : script_code_index(program).find(patterns);
+		for (size_t i = 0; i < functions.size(); i++)
 		{
-			LOG(FATAL) << "Failed to find pattern " << m_name << " in script " << program->m_name;
+			if (locations[i])
+			{
+				functions[i]->m_ip = *locations[i];
+				LOG(VERBOSE) << "Found pattern " << functions[i]->m_name << " at " << HEX_TO_UPPER(functions[i]->m_ip) << " in script " << program->m_name;
+			}
 		}
+	}
+
+	uint32_t script_function::get_ip(rage::scrProgram* program)
+	{
+		if (m_ip != 0)
+			return m_ip;
+
+		resolve_all(program);
+
+		if (m_ip == 0)
+			LOG(FATAL) << "Failed to find pattern " << m_name << " in script " << program->m_name;
 
 		return m_ip;
 	}
-}
\ No newline at end of file
+}
@@ -15,6 +15,9 @@ namespace big
 		uint32_t m_ip;
 		std::string m_name;
 
+		static std::vector<script_function*>& get_all();
+		static void resolve_all(rage::scrProgram* program);
+
 	public:
 		script_function(const std::string& name, const rage::joaat_t script, const std::string& pattern);
 		uint32_t get_ip(rage::scrProgram* program);
@@ -7,4 +7,10 @@ namespace big
 	{
 		return g_pointers->m_gta.m_script_globals[m_index >> 0x12 & 0x3F] + (m_index & 0x3FFFF);
 	}
+
+	bool script_global::fits_in_block(std::size_t count) const
+	{
+		const auto block = m_index >> 0x12;
+		return block <= 0x3F && g_pointers->m_gta.m_script_globals[block] && (m_index & 0x3FFFF) + count <= 0x40000;
+	}
 }
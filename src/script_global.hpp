@@ -1,8 +1,13 @@
 #pragma once
 #include "common.hpp"
 
+#include <span>
+
 namespace big
 {
+	// bumped every time the game loads a script, which is when it allocates the blocks of globals that script owns
+	inline std::atomic<uint32_t> g_script_global_generation = 1;
+
 	class script_global
 	{
 	public:
@@ -32,8 +37,99 @@ namespace big
 			return *static_cast<std::add_pointer_t<std::remove_reference_t<T>>>(get());
 		}
 
+		constexpr std::size_t get_index() const
+		{
+			return m_index;
+		}
+
+		// True if count globals starting at this one fit in the 0x40000 slots a block can hold and the block is allocated.
+		// That is the capacity of the block, not what the owning script allocated of it, so only indices that are off by a lot get caught.
+		bool fits_in_block(std::size_t count = 1) const;
+
 	private:
 		void* get() const;
 		std::size_t m_index;
 	};
+
+	/**
+	 * @brief A global of type T that remembers its address until g_script_global_generation moves on.
+	 *
+	 * Meant to be owned by whatever touches the same global every tick, like a looped command, and only used from that one thread.
+	 * Debug builds check the global against the capacity of its block whenever the address is resolved, get() returns nullptr if it doesn't fit.
+	 */
+	template<typename T>
+	class script_global_ref
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+	public:
+		// globals are 8 byte slots, a value spanning several of them like a Vector3 takes up whole slots
+		static constexpr std::size_t SLOTS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+		constexpr script_global_ref(script_global global) :
+		    m_global(global)
+		{
+		}
+
+		T* get() const
+		{
+			if (const auto generation = g_script_global_generation.load(std::memory_order_relaxed); m_generation != generation)
+			{
+				// stays nullptr until the next generation, so a bad global gets logged once per script load instead of on every access
+				m_address    = check_capacity(1) ? m_global.as<T*>() : nullptr;
+				m_generation = generation;
+			}
+
+			return m_address;
+		}
+
+		T& operator*() const
+		{
+			return *get();
+		}
+
+		T* operator->() const
+		{
+			return get();
+		}
+
+		// values[i] is read from the i-th value of type T starting at this global
+		void read(std::span<T> values) const
+		{
+			const auto slots = reinterpret_cast<const uint64_t*>(get());
+			if (!slots || !check_capacity(values.size()))
+				return;
+
+			for (std::size_t i = 0; i < values.size(); i++)
+				std::memcpy(&values[i], slots + i * SLOTS, sizeof(T));
+		}
+
+		void write(std::span<const T> values) const
+		{
+			const auto slots = reinterpret_cast<uint64_t*>(get());
+			if (!slots || !check_capacity(values.size()))
+				return;
+
+			for (std::size_t i = 0; i < values.size(); i++)
+				std::memcpy(slots + i * SLOTS, &values[i], sizeof(T));
+		}
+
+	private:
+		bool check_capacity(std::size_t count) const
+		{
+#ifndef NDEBUG
+			if (!m_global.fits_in_block(count * SLOTS))
+			{
+				LOG(FATAL) << "Global " << m_global.get_index() << " doesn't have room for " << count << " values of " << sizeof(T) << " bytes";
+				return false;
+			}
+#endif
+
+			return true;
+		}
+
+		script_global m_global;
+		mutable T* m_address          = nullptr;
+		mutable uint32_t m_generation = 0;
+	};
 }
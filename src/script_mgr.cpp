@@ -4,6 +4,7 @@
 #include "gta/script_thread.hpp"
 #include "gta_util.hpp"
 #include "pointers.hpp"
+#include "script_profiler.hpp"
 #include "script/tlsContext.hpp"
 
 namespace big
@@ -12,6 +13,7 @@ namespace big
 	{
 		std::lock_guard lock(m_mutex);
 
+		m_scheduler.add(script.get());
 		m_scripts.push_back(std::move(script));
 	}
 
@@ -19,6 +21,7 @@ namespace big
 	{
 		std::lock_guard lock(m_mutex);
 
+		m_scheduler.clear();
 		m_scripts.clear();
 	}
 
@@ -50,12 +53,11 @@ namespace big
 
 		std::lock_guard lock(m_mutex);
 
+		if (g_script_profiler.is_enabled())
+			g_script_profiler.begin_frame();
+
 		lua_manager_tick();
 
-		for (const auto& script : m_scripts)
-		{
-			if (script->is_enabled())
-				script->tick();
-		}
+		m_scheduler.tick();
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "lua/lua_manager.hpp"
 #include "script.hpp"
+#include "script_scheduler.hpp"
 
 namespace big
 {
@@ -45,6 +46,7 @@ namespace big
 	private:
 		std::recursive_mutex m_mutex;
 		script_list m_scripts;
+		script_scheduler m_scheduler;
 
 		bool m_can_tick = false;
 	};
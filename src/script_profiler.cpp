@@ -0,0 +1,149 @@
+#include "script_profiler.hpp"
+
+#include <intrin.h>
+
+namespace big
+{
+	script_profiler::scope::scope(const void* owner, profiled_kind kind, std::string_view name, uint32_t yields) :
+	    m_owner(g_script_profiler.is_enabled() ? owner : nullptr),
+	    m_kind(kind),
+	    m_name(name),
+	    m_yields(yields),
+	    m_start(m_owner ? __rdtsc() : 0)
+	{
+	}
+
+	script_profiler::scope::~scope()
+	{
+		if (m_owner)
+			g_script_profiler.record(m_owner, m_kind, m_name, __rdtsc() - m_start, m_yields);
+	}
+
+	script_profiler::script_profiler() :
+	    m_tsc_start(__rdtsc()),
+	    m_clock_start(std::chrono::steady_clock::now())
+	{
+	}
+
+	void script_profiler::begin_frame()
+	{
+		std::lock_guard lock(m_mutex);
+
+		++m_frame;
+		for (auto it = m_entries.begin(); it != m_entries.end();)
+		{
+			auto& entry = it->second;
+
+			// nothing recorded for a whole sample window, the owner is gone or doesn't tick anymore
+			if (m_frame - entry.m_last_active_frame > SAMPLE_COUNT)
+			{
+				it = m_entries.erase(it);
+				continue;
+			}
+
+			const auto idx      = entry.m_sample_count++ % SAMPLE_COUNT;
+			entry.m_cycles[idx] = entry.m_frame_cycles;
+			entry.m_yields[idx] = entry.m_frame_yields;
+
+			entry.m_frame_cycles = 0;
+			entry.m_frame_yields = 0;
+			++it;
+		}
+	}
+
+	void script_profiler::record(const void* owner, profiled_kind kind, std::string_view name, uint64_t cycles, uint32_t yields)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (name.empty())
+			name = "Unnamed";
+
+		auto& entry = m_entries[owner];
+		// new entries have an empty name, owners get freed and their address reused when Lua scripts reload
+		if (entry.m_kind != kind || entry.m_name != name)
+		{
+			entry        = {};
+			entry.m_name = name;
+			entry.m_kind = kind;
+		}
+
+		entry.m_last_active_frame = m_frame;
+		entry.m_frame_cycles += cycles;
+		entry.m_frame_yields += yields;
+	}
+
+	double script_profiler::cycles_per_us() const
+	{
+		// derive the TSC rate from the time elapsed since startup instead of a blocking calibration
+		const auto elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_clock_start).count();
+		return elapsed_us > 0 ? (__rdtsc() - m_tsc_start) / elapsed_us : 1.0;
+	}
+
+	std::vector<script_profile_stats> script_profiler::get_stats()
+	{
+		const auto rate = cycles_per_us();
+
+		std::vector<script_profile_stats> stats;
+		std::array<uint64_t, SAMPLE_COUNT> samples;
+
+		std::lock_guard lock(m_mutex);
+		stats.reserve(m_entries.size());
+		for (const auto& [owner, entry] : m_entries)
+		{
+			const auto count = std::min(entry.m_sample_count, SAMPLE_COUNT);
+			if (count == 0)
+				continue;
+
+			std::copy_n(entry.m_cycles.begin(), count, samples.begin());
+
+			uint64_t total_cycles = 0, total_yields = 0;
+			for (std::size_t i = 0; i < count; i++)
+			{
+				total_cycles += samples[i];
+				total_yields += entry.m_yields[i];
+			}
+
+			const auto p99 = samples.begin() + (count - 1) * 99 / 100;
+			std::nth_element(samples.begin(), p99, samples.begin() + count);
+			const auto min = *std::min_element(samples.begin(), samples.begin() + count);
+
+			stats.push_back({entry.m_name,
+			    entry.m_kind,
+			    min / rate,
+			    total_cycles / rate / count,
+			    *p99 / rate,
+			    static_cast<double>(total_yields) / count});
+		}
+
+		std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) {
+			return a.m_p99_us > b.m_p99_us;
+		});
+
+		return stats;
+	}
+
+	void script_profiler::dump()
+	{
+		static constexpr const char* kind_names[] = {"script", "lua module", "looped command"};
+
+		const auto stats = get_stats();
+		LOG(INFO) << "Script profiler: " << stats.size() << " entries, times in us per frame (min / avg / p99), yields per frame";
+		for (const auto& stat : stats)
+		{
+			LOG(INFO) << std::format("{:>10.1f} {:>10.1f} {:>10.1f} {:>6.2f}  [{}] {}",
+			    stat.m_min_us,
+			    stat.m_avg_us,
+			    stat.m_p99_us,
+			    stat.m_yields_per_frame,
+			    kind_names[static_cast<int>(stat.m_kind)],
+			    stat.m_name);
+		}
+	}
+
+	void script_profiler::reset()
+	{
+		std::lock_guard lock(m_mutex);
+
+		m_entries.clear();
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+namespace big
+{
+	enum class profiled_kind : uint8_t
+	{
+		SCRIPT,
+		LUA_MODULE,
+		LOOPED_COMMAND
+	};
+
+	struct script_profile_stats
+	{
+		std::string m_name;
+		profiled_kind m_kind;
+		double m_min_us;
+		double m_avg_us;
+		double m_p99_us;
+		double m_yields_per_frame;
+	};
+
+	// Per frame cost of the fibers, Lua modules and looped commands ticked by script_mgr.
+	class script_profiler
+	{
+	public:
+		// frames kept per profiled owner
+		static constexpr std::size_t SAMPLE_COUNT = 256;
+
+		// Records the time until it goes out of scope, does nothing while the profiler is disabled.
+		class scope
+		{
+		public:
+			scope(const void* owner, profiled_kind kind, std::string_view name, uint32_t yields = 0);
+			~scope();
+
+			scope(const scope&)            = delete;
+			scope& operator=(const scope&) = delete;
+
+		private:
+			const void* m_owner;
+			profiled_kind m_kind;
+			std::string_view m_name;
+			uint32_t m_yields;
+			uint64_t m_start;
+		};
+
+		script_profiler();
+
+		// Commits the time recorded since the last call as one frame sample of every owner.
+		void begin_frame();
+		void record(const void* owner, profiled_kind kind, std::string_view name, uint64_t cycles, uint32_t yields);
+
+		// Stats sorted by p99, highest first.
+		std::vector<script_profile_stats> get_stats();
+		void dump();
+		void reset();
+
+		bool is_enabled() const
+		{
+			return g.debug.script_profiler;
+		}
+
+	private:
+		struct entry
+		{
+			std::string m_name;
+			profiled_kind m_kind;
+			std::array<uint64_t, SAMPLE_COUNT> m_cycles;
+			std::array<uint32_t, SAMPLE_COUNT> m_yields;
+			std::size_t m_sample_count;
+			uint64_t m_frame_cycles;
+			uint32_t m_frame_yields;
+			uint64_t m_last_active_frame;
+		};
+
+		double cycles_per_us() const;
+
+		std::mutex m_mutex;
+		// keyed by the address of the script, module or command
+		std::unordered_map<const void*, entry> m_entries;
+		// frames committed by begin_frame
+		uint64_t m_frame{};
+
+		uint64_t m_tsc_start;
+		std::chrono::steady_clock::time_point m_clock_start;
+	};
+
+	inline script_profiler g_script_profiler;
+}
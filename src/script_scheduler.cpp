@@ -0,0 +1,63 @@
+#include "script_scheduler.hpp"
+
+namespace big
+{
+	void script_scheduler::add(script* script)
+	{
+		m_every_frame.push_back(script);
+	}
+
+	void script_scheduler::remove_if(std::function<bool(script*)> pred)
+	{
+		std::erase_if(m_every_frame, pred);
+
+		if (std::erase_if(m_sleeping, [&pred](const sleeper& entry) {
+			    return pred(entry.m_script);
+		    }))
+		{
+			std::make_heap(m_sleeping.begin(), m_sleeping.end());
+		}
+	}
+
+	void script_scheduler::clear()
+	{
+		m_every_frame.clear();
+		m_sleeping.clear();
+	}
+
+	void script_scheduler::reschedule(script* script)
+	{
+		if (const auto wake_time = script->wake_time(); wake_time.has_value() && script->is_enabled())
+		{
+			m_sleeping.push_back({*wake_time, script});
+			std::push_heap(m_sleeping.begin(), m_sleeping.end());
+		}
+		else
+		{
+			m_every_frame.push_back(script);
+		}
+	}
+
+	void script_scheduler::tick()
+	{
+		// scripts can add new scripts while ticking, so work on a separate list and rebuild m_every_frame as we go
+		m_due.clear();
+		std::swap(m_due, m_every_frame);
+
+		const auto now = clock::now();
+		while (!m_sleeping.empty() && m_sleeping.front().m_wake_time <= now)
+		{
+			std::pop_heap(m_sleeping.begin(), m_sleeping.end());
+			m_due.push_back(m_sleeping.back().m_script);
+			m_sleeping.pop_back();
+		}
+
+		for (const auto script : m_due)
+		{
+			if (script->is_enabled())
+				script->tick();
+
+			reschedule(script);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "script.hpp"
+
+namespace big
+{
+	/**
+	 * @brief Decides which scripts get ticked on a frame.
+	 *
+	 * Scripts that yielded without a duration are ticked every frame, scripts that yielded with a duration sit in a min-heap
+	 * ordered by wake time and aren't looked at again until they are due, so sleeping scripts cost nothing per frame.
+	 * The scheduler doesn't own the scripts, remove them before they are destroyed.
+	 */
+	class script_scheduler
+	{
+	public:
+		// Safe to call from a script being ticked, the script is picked up on the next frame.
+		void add(script* script);
+		void remove_if(std::function<bool(script*)> pred);
+		void clear();
+
+		void tick();
+
+		std::size_t sleeping_count() const
+		{
+			return m_sleeping.size();
+		}
+
+	private:
+		using clock = std::chrono::high_resolution_clock;
+
+		struct sleeper
+		{
+			clock::time_point m_wake_time;
+			script* m_script;
+
+			// std heap functions build a max-heap, invert the order to get the earliest wake time on top
+			bool operator<(const sleeper& other) const
+			{
+				return m_wake_time > other.m_wake_time;
+			}
+		};
+
+		void reschedule(script* script);
+
+		std::vector<script*> m_every_frame;
+		std::vector<sleeper> m_sleeping;
+		std::vector<script*> m_due;
+	};
+}
@@ -147,7 +147,7 @@ namespace big
 		    {},
 		    {{"DISARM",
 		         [this] {
-			         for (auto& [_, weapon] : g_gta_data_service.weapons())
+			         for (const auto& weapon : g_gta_data_service.weapons())
 				         WEAPON::REMOVE_WEAPON_FROM_PED(m_handle, weapon.m_hash);
 		         }},
 		        {"KILL",
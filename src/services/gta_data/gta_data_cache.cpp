@@ -0,0 +1,304 @@
+#include "gta_data_cache.hpp"
+
+#include "ped_item.hpp"
+#include "vehicle_item.hpp"
+
+namespace big
+{
+	constexpr uint64_t SECTION_ALIGNMENT = 8;
+
+	static uint32_t fnv1a_32(const uint8_t* data, size_t size)
+	{
+		uint32_t hash = 0x811C9DC5;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x01000193;
+		}
+		return hash;
+	}
+
+	static constexpr size_t element_size(gta_data_section id)
+	{
+		switch (id)
+		{
+		case gta_data_section::STRINGS: return 1;
+		case gta_data_section::PEDS:
+		case gta_data_section::SOURCE_PEDS: return sizeof(ped_item);
+		case gta_data_section::VEHICLES:
+		case gta_data_section::SOURCE_VEHICLES: return sizeof(vehicle_item);
+		case gta_data_section::WEAPONS: return sizeof(packed_weapon_item);
+		case gta_data_section::SOURCE_WEAPONS: return sizeof(packed_source_weapon);
+		case gta_data_section::WEAPON_COMPONENTS:
+		case gta_data_section::SOURCE_WEAPON_COMPONENTS: return sizeof(packed_weapon_component);
+		case gta_data_section::SOURCES: return sizeof(packed_rpf_source);
+		case gta_data_section::PED_INDEX:
+		case gta_data_section::VEHICLE_INDEX:
+		case gta_data_section::WEAPON_INDEX:
+		case gta_data_section::WEAPON_COMPONENT_INDEX: return sizeof(hash_index_entry);
+		case gta_data_section::PED_TYPES:
+		case gta_data_section::VEHICLE_CLASSES:
+		case gta_data_section::WEAPON_TYPES:
+		case gta_data_section::WEAPON_ATTACHMENTS:
+		case gta_data_section::SOURCE_WEAPON_ATTACHMENTS: return sizeof(uint32_t);
+		}
+		return 0;
+	}
+
+	gta_data_cache::~gta_data_cache()
+	{
+		close();
+	}
+
+	bool gta_data_cache::open(const std::filesystem::path& path, uint32_t file_version)
+	{
+		close();
+
+		// share delete so the file can be renamed while it's mapped, a rebuild moves it out of the way that way
+		m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(gta_data_cache_header)))
+		{
+			close();
+			return false;
+		}
+		m_size = size.QuadPart;
+
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mapping)
+			m_view = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+		if (!m_view || !validate(file_version))
+		{
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void gta_data_cache::close()
+	{
+		if (m_view)
+			UnmapViewOfFile(m_view);
+		if (m_mapping)
+			CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE)
+			CloseHandle(m_file);
+
+		m_view    = nullptr;
+		m_mapping = nullptr;
+		m_file    = INVALID_HANDLE_VALUE;
+		m_size    = 0;
+		m_sections.fill(nullptr);
+		m_strings = {};
+	}
+
+	bool gta_data_cache::validate(uint32_t file_version)
+	{
+		const auto header = reinterpret_cast<const gta_data_cache_header*>(m_view);
+		if (header->m_magic != GTA_DATA_CACHE_MAGIC || header->m_cache_version != GTA_DATA_CACHE_VERSION || header->m_file_size != m_size)
+		{
+			LOG(WARNING) << "GTA data cache has an unknown layout, it will be rebuilt.";
+			return false;
+		}
+		if (header->m_file_version != file_version)
+		{
+			LOG(VERBOSE) << "GTA data cache was built for another game build.";
+			return false;
+		}
+
+		const auto table_end = sizeof(gta_data_cache_header) + uint64_t(header->m_section_count) * sizeof(gta_data_section_entry);
+		if (table_end > m_size)
+			return false;
+
+		const auto entries = reinterpret_cast<const gta_data_section_entry*>(m_view + sizeof(gta_data_cache_header));
+		for (uint32_t i = 0; i < header->m_section_count; i++)
+		{
+			const auto& entry = entries[i];
+			const auto id     = static_cast<size_t>(entry.m_id);
+			if (id >= m_sections.size() || m_sections[id] || entry.m_offset < table_end || entry.m_offset % SECTION_ALIGNMENT
+			    || entry.m_size > m_size - entry.m_offset || entry.m_size != uint64_t(entry.m_count) * element_size(entry.m_id))
+			{
+				LOG(WARNING) << "GTA data cache has a malformed section table, it will be rebuilt.";
+				return false;
+			}
+			if (fnv1a_32(m_view + entry.m_offset, entry.m_size) != entry.m_checksum)
+			{
+				LOG(WARNING) << "GTA data cache section " << id << " failed its checksum, it will be rebuilt.";
+				return false;
+			}
+
+			m_sections[id] = &entry;
+		}
+
+		// items are read in place from here on, make sure every reference they hold stays inside the mapping
+		const auto strings = section<char>(gta_data_section::STRINGS);
+		if (strings.empty() || strings.back() != '\0')
+			return false;
+		m_strings = {strings.data(), strings.size()};
+
+		const auto valid_string = [this](uint32_t offset) {
+			return offset < m_strings.size();
+		};
+		const auto valid_strings = [&](gta_data_section id) {
+			return std::ranges::all_of(section<uint32_t>(id), valid_string);
+		};
+		const auto valid_index = [this](gta_data_section index, size_t item_count) {
+			const auto entries = section<hash_index_entry>(index);
+			for (size_t i = 0; i < entries.size(); i++)
+				if (entries[i].m_index >= item_count || (i && entries[i - 1].m_hash >= entries[i].m_hash))
+					return false;
+			return true;
+		};
+
+		const auto valid_weapon = [&](const packed_weapon_item& weapon, std::span<const uint32_t> attachments) {
+			return valid_string(weapon.m_name) && valid_string(weapon.m_display_name) && valid_string(weapon.m_display_desc)
+			    && valid_string(weapon.m_weapon_type) && weapon.m_first_attachment <= attachments.size()
+			    && weapon.m_attachment_count <= attachments.size() - weapon.m_first_attachment;
+		};
+		const auto valid_component = [&](const packed_weapon_component& component) {
+			return valid_string(component.m_name) && valid_string(component.m_display_name) && valid_string(component.m_display_desc);
+		};
+		const auto valid_slice = [](uint32_t first, uint32_t count, size_t size) {
+			return first <= size && count <= size - first;
+		};
+
+		const auto attachments = section<uint32_t>(gta_data_section::WEAPON_ATTACHMENTS);
+		const auto weapons     = section<packed_weapon_item>(gta_data_section::WEAPONS);
+		const auto components  = section<packed_weapon_component>(gta_data_section::WEAPON_COMPONENTS);
+
+		const auto valid_weapons = std::ranges::all_of(weapons, [&](const packed_weapon_item& weapon) {
+			return valid_weapon(weapon, attachments);
+		});
+		const auto valid_components = std::ranges::all_of(components, valid_component);
+
+		const auto source_attachments = section<uint32_t>(gta_data_section::SOURCE_WEAPON_ATTACHMENTS);
+		const auto source_weapons     = section<packed_source_weapon>(gta_data_section::SOURCE_WEAPONS);
+		const auto source_components  = section<packed_weapon_component>(gta_data_section::SOURCE_WEAPON_COMPONENTS);
+		const auto source_peds        = section<ped_item>(gta_data_section::SOURCE_PEDS);
+		const auto source_vehicles    = section<vehicle_item>(gta_data_section::SOURCE_VEHICLES);
+
+		const auto valid_source_weapons = std::ranges::all_of(source_weapons, [&](const packed_source_weapon& weapon) {
+			return valid_weapon(weapon.m_item, source_attachments);
+		});
+		const auto valid_source_slices = std::ranges::all_of(section<packed_rpf_source>(gta_data_section::SOURCES), [&](const packed_rpf_source& source) {
+			return valid_string(source.m_path) && valid_slice(source.m_first_ped, source.m_ped_count, source_peds.size())
+			    && valid_slice(source.m_first_vehicle, source.m_vehicle_count, source_vehicles.size())
+			    && valid_slice(source.m_first_weapon, source.m_weapon_count, source_weapons.size())
+			    && valid_slice(source.m_first_weapon_component, source.m_weapon_component_count, source_components.size());
+		});
+		const auto valid_sources = valid_source_weapons && valid_source_slices && std::ranges::all_of(source_components, valid_component)
+		    && valid_strings(gta_data_section::SOURCE_WEAPON_ATTACHMENTS);
+
+		if (!valid_weapons || !valid_components || !valid_sources || !valid_strings(gta_data_section::PED_TYPES)
+		    || !valid_strings(gta_data_section::VEHICLE_CLASSES) || !valid_strings(gta_data_section::WEAPON_TYPES)
+		    || !valid_strings(gta_data_section::WEAPON_ATTACHMENTS)
+		    || !valid_index(gta_data_section::PED_INDEX, section<ped_item>(gta_data_section::PEDS).size())
+		    || !valid_index(gta_data_section::VEHICLE_INDEX, section<vehicle_item>(gta_data_section::VEHICLES).size())
+		    || !valid_index(gta_data_section::WEAPON_INDEX, weapons.size())
+		    || !valid_index(gta_data_section::WEAPON_COMPONENT_INDEX, components.size()))
+		{
+			LOG(WARNING) << "GTA data cache references data outside of its sections, it will be rebuilt.";
+			return false;
+		}
+
+		return true;
+	}
+
+	gta_data_cache_writer::gta_data_cache_writer() :
+	    m_strings(1, '\0')
+	{
+		m_string_offsets.emplace("", 0);
+	}
+
+	uint32_t gta_data_cache_writer::add_string(std::string_view str)
+	{
+		// the table is NUL terminated, anything after an embedded NUL would be unreachable anyway
+		str = str.substr(0, str.find('\0'));
+
+		if (const auto it = m_string_offsets.find(std::string(str)); it != m_string_offsets.end())
+			return it->second;
+
+		const auto offset = static_cast<uint32_t>(m_strings.size());
+		m_strings.append(str);
+		m_strings.push_back('\0');
+		m_string_offsets.emplace(str, offset);
+		return offset;
+	}
+
+	bool gta_data_cache_writer::write(const std::filesystem::path& path, uint32_t file_version, std::string_view game_build, std::string_view online_version) const
+	{
+		std::vector<const pending_section*> sections;
+		const pending_section strings{gta_data_section::STRINGS, static_cast<uint32_t>(m_strings.size()), {m_strings.begin(), m_strings.end()}};
+		sections.push_back(&strings);
+		for (const auto& section : m_sections)
+			sections.push_back(&section);
+
+		const auto align = [](uint64_t offset) {
+			return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+		};
+
+		gta_data_cache_header header{};
+		header.m_magic         = GTA_DATA_CACHE_MAGIC;
+		header.m_cache_version = GTA_DATA_CACHE_VERSION;
+		header.m_file_version  = file_version;
+		header.m_section_count = static_cast<uint32_t>(sections.size());
+		game_build.copy(header.m_game_build, sizeof(header.m_game_build) - 1);
+		online_version.copy(header.m_online_version, sizeof(header.m_online_version) - 1);
+
+		std::vector<gta_data_section_entry> entries;
+		auto offset = align(sizeof(gta_data_cache_header) + sections.size() * sizeof(gta_data_section_entry));
+		for (const auto section : sections)
+		{
+			gta_data_section_entry entry{};
+			entry.m_id       = section->m_id;
+			entry.m_count    = section->m_count;
+			entry.m_offset   = offset;
+			entry.m_size     = section->m_data.size();
+			entry.m_checksum = fnv1a_32(section->m_data.data(), section->m_data.size());
+			entries.push_back(entry);
+
+			offset = align(offset + entry.m_size);
+		}
+		header.m_file_size = offset;
+
+		auto temp_path = path;
+		temp_path += ".tmp";
+		{
+			std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return false;
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(gta_data_section_entry));
+			for (size_t i = 0; i < sections.size(); i++)
+			{
+				file.seekp(entries[i].m_offset);
+				file.write(reinterpret_cast<const char*>(sections[i]->m_data.data()), sections[i]->m_data.size());
+			}
+			// pad the last section so the file size matches the header
+			if (static_cast<uint64_t>(file.tellp()) < header.m_file_size)
+			{
+				file.seekp(header.m_file_size - 1);
+				file.put('\0');
+			}
+
+			if (!file)
+				return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temp_path, path, ec);
+		if (ec)
+		{
+			LOG(WARNING) << "Failed to replace GTA data cache: " << ec.message();
+			return false;
+		}
+
+		return true;
+	}
+}
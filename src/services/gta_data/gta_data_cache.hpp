@@ -0,0 +1,223 @@
+#pragma once
+#include "hash_index.hpp"
+
+#include <array>
+
+namespace big
+{
+	constexpr uint32_t GTA_DATA_CACHE_MAGIC = 0x43444759; // "YGDC"
+	// bump this when changing any of the structs stored in the cache
+	constexpr uint32_t GTA_DATA_CACHE_VERSION = 1;
+
+	enum class gta_data_section : uint32_t
+	{
+		// NUL terminated strings, offset 0 is always the empty string
+		STRINGS,
+
+		// ped_item, sorted by name
+		PEDS,
+		PED_INDEX,
+		// string offsets, sorted
+		PED_TYPES,
+
+		// vehicle_item, sorted by name
+		VEHICLES,
+		VEHICLE_INDEX,
+		// string offsets, sorted
+		VEHICLE_CLASSES,
+
+		// packed_weapon_item, sorted by name
+		WEAPONS,
+		WEAPON_INDEX,
+		// string offsets, sorted
+		WEAPON_TYPES,
+		// string offsets, sliced by packed_weapon_item::m_first_attachment
+		WEAPON_ATTACHMENTS,
+
+		// packed_weapon_component, sorted by name
+		WEAPON_COMPONENTS,
+		WEAPON_COMPONENT_INDEX,
+
+		// only in cache/gta_data_sources.bin, what each RPF on disk produced before the results got merged
+
+		// packed_rpf_source, in the order the RPFs were found
+		SOURCES,
+		// ped_item, vehicle_item, packed_source_weapon and packed_weapon_component, sliced by packed_rpf_source
+		SOURCE_PEDS,
+		SOURCE_VEHICLES,
+		SOURCE_WEAPONS,
+		SOURCE_WEAPON_COMPONENTS,
+		// string offsets, sliced by packed_source_weapon::m_item.m_first_attachment
+		SOURCE_WEAPON_ATTACHMENTS,
+
+		COUNT
+	};
+
+#pragma pack(push, 4)
+	struct gta_data_cache_header
+	{
+		uint32_t m_magic;
+		uint32_t m_cache_version;
+		// timestamp of GTA5.exe the cache was built from
+		uint32_t m_file_version;
+		uint32_t m_section_count;
+		uint64_t m_file_size;
+		char m_game_build[16];
+		char m_online_version[16];
+	};
+	static_assert(sizeof(gta_data_cache_header) == 56);
+
+	struct gta_data_section_entry
+	{
+		gta_data_section m_id;
+		uint32_t m_count;
+		uint64_t m_offset;
+		uint64_t m_size;
+		// fnv1a of the section bytes
+		uint32_t m_checksum;
+		uint32_t m_reserved;
+	};
+	static_assert(sizeof(gta_data_section_entry) == 32);
+
+	// weapon_item with its strings replaced by string table offsets
+	struct packed_weapon_item
+	{
+		uint32_t m_name;
+		uint32_t m_display_name;
+		uint32_t m_display_desc;
+		uint32_t m_weapon_type;
+		uint32_t m_hash;
+		uint32_t m_reward_hash;
+		uint32_t m_reward_ammo_hash;
+		uint32_t m_first_attachment;
+		uint32_t m_attachment_count;
+		uint32_t m_throwable;
+	};
+
+	// weapon_component with its strings replaced by string table offsets
+	struct packed_weapon_component
+	{
+		uint32_t m_name;
+		uint32_t m_display_name;
+		uint32_t m_display_desc;
+		uint32_t m_hash;
+	};
+
+	// a weapon as parsed, before the display strings were looked up
+	struct packed_source_weapon
+	{
+		packed_weapon_item m_item;
+		// RPFDatafileSource
+		uint32_t m_file_type;
+	};
+
+	struct packed_rpf_source
+	{
+		// path relative to the game folder
+		uint32_t m_path;
+		uint32_t m_toc_hash;
+		uint64_t m_size;
+		uint64_t m_write_time;
+
+		uint32_t m_first_ped;
+		uint32_t m_ped_count;
+		uint32_t m_first_vehicle;
+		uint32_t m_vehicle_count;
+		uint32_t m_first_weapon;
+		uint32_t m_weapon_count;
+		uint32_t m_first_weapon_component;
+		uint32_t m_weapon_component_count;
+	};
+#pragma pack(pop)
+
+	/**
+	 * @brief Read only view of cache/gta_data.bin or cache/gta_data_sources.bin.
+	 *
+	 * The file is mapped as a whole and validated once when opened, after that every section is read in place.
+	 */
+	class gta_data_cache final
+	{
+	public:
+		gta_data_cache() = default;
+		~gta_data_cache();
+
+		gta_data_cache(const gta_data_cache&)            = delete;
+		gta_data_cache& operator=(const gta_data_cache&) = delete;
+
+		/**
+		 * @brief Maps the cache and validates it against the current game build.
+		 *
+		 * @return False if the cache is missing, outdated or corrupt, the cache stays closed in that case.
+		 */
+		bool open(const std::filesystem::path& path, uint32_t file_version);
+		void close();
+
+		bool is_open() const
+		{
+			return m_view != nullptr;
+		}
+
+		template<typename T>
+		std::span<const T> section(gta_data_section id) const
+		{
+			const auto entry = m_sections[static_cast<size_t>(id)];
+			if (!entry)
+				return {};
+
+			return {reinterpret_cast<const T*>(m_view + entry->m_offset), entry->m_count};
+		}
+
+		// offsets are checked when the cache is opened
+		const char* string(uint32_t offset) const
+		{
+			return m_strings.data() + offset;
+		}
+
+	private:
+		bool validate(uint32_t file_version);
+
+	private:
+		HANDLE m_file         = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping      = nullptr;
+		const uint8_t* m_view = nullptr;
+		uint64_t m_size       = 0;
+
+		std::array<const gta_data_section_entry*, static_cast<size_t>(gta_data_section::COUNT)> m_sections{};
+		std::string_view m_strings;
+	};
+
+	class gta_data_cache_writer final
+	{
+	public:
+		gta_data_cache_writer();
+
+		// returns the offset of str in the string table, equal strings share an offset
+		uint32_t add_string(std::string_view str);
+
+		template<typename T>
+		void add_section(gta_data_section id, std::span<const T> items)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			const auto bytes = reinterpret_cast<const uint8_t*>(items.data());
+			m_sections.push_back({id, static_cast<uint32_t>(items.size()), std::vector<uint8_t>(bytes, bytes + items.size_bytes())});
+		}
+
+		/**
+		 * @brief Writes to a temporary file first and swaps it in once complete, the target must not be mapped.
+		 */
+		bool write(const std::filesystem::path& path, uint32_t file_version, std::string_view game_build, std::string_view online_version) const;
+
+	private:
+		struct pending_section
+		{
+			gta_data_section m_id;
+			uint32_t m_count;
+			std::vector<uint8_t> m_data;
+		};
+
+		std::string m_strings;
+		std::unordered_map<std::string, uint32_t> m_string_offsets;
+		std::vector<pending_section> m_sections;
+	};
+}
@@ -2,9 +2,9 @@
 
 #include "fiber_pool.hpp"
 #include "file_manager.hpp"
+#include "meta_parser.hpp"
 #include "natives.hpp"
 #include "pointers.hpp"
-#include "pugixml.hpp"
 #include "script.hpp"
 #include "thread_pool.hpp"
 #include "util/misc.hpp"
@@ -18,29 +18,30 @@
 
 namespace big
 {
-	bool add_if_not_exists(string_vec& vec, std::string str)
+	gta_data_service::gta_data_service() :
+	    m_update_state(eGtaDataUpdateState::IDLE)
 	{
-		if (std::find(vec.begin(), vec.end(), str) != vec.end())
-			return true;
+		m_data = m_loaded_data.emplace_back(std::make_unique<gta_data>()).get();
+	}
 
-		vec.emplace_back(std::move(str));
-		return false;
+	static std::filesystem::path cache_path()
+	{
+		return g_file_manager.get_project_file("./cache/gta_data.bin").get_path();
 	}
 
-	gta_data_service::gta_data_service() :
-	    m_update_state(eGtaDataUpdateState::IDLE)
+	// where a cache that was still mapped when it got rebuilt is moved to
+	static std::filesystem::path retired_cache_path()
 	{
+		return g_file_manager.get_project_file("./cache/gta_data.bin.old").get_path();
 	}
 
 	bool gta_data_service::init()
 	{
-		m_peds_cache     = {g_file_manager.get_project_file("./cache/peds.bin"), 5};
-		m_vehicles_cache = {g_file_manager.get_project_file("./cache/vehicles.bin"), 6};
+		std::error_code ec;
+		std::filesystem::remove(retired_cache_path(), ec);
 
-		if (!is_cache_up_to_date())
+		if (!load_data())
 			m_update_state = eGtaDataUpdateState::NEEDS_UPDATE;
-		else
-			load_data();
 
 		return true;
 	}
@@ -69,153 +70,345 @@ namespace big
 		});
 	}
 
-	// innefficient getters, don't care to fix right now
 	const ped_item& gta_data_service::ped_by_hash(uint32_t hash)
 	{
-		for (const auto& [name, ped] : m_peds)
-			if (ped.m_hash == hash)
-				return ped;
+		if (const auto ped = data().m_ped_index.find(hash))
+			return *ped;
 		return gta_data_service::empty_ped;
 	}
 
 	const vehicle_item& gta_data_service::vehicle_by_hash(uint32_t hash)
 	{
-		for (const auto& [name, veh] : m_vehicles)
-			if (veh.m_hash == hash)
-				return veh;
+		if (const auto veh = data().m_vehicle_index.find(hash))
+			return *veh;
 		return gta_data_service::empty_vehicle;
 	}
 
 	const weapon_item& gta_data_service::weapon_by_hash(uint32_t hash)
 	{
-		for (const auto& [name, weapon] : m_weapons_cache.weapon_map)
-			if (weapon.m_hash == hash)
-				return weapon;
+		if (const auto weapon = data().m_weapon_index.find(hash))
+			return *weapon;
 		return gta_data_service::empty_weapon;
 	}
 
 	const weapon_component& gta_data_service::weapon_component_by_hash(uint32_t hash)
 	{
-		for (const auto& [name, component] : m_weapons_cache.weapon_components)
-			if (component.m_hash == hash)
-				return component;
+		if (const auto component = data().m_weapon_component_index.find(hash))
+			return *component;
 		return gta_data_service::empty_component;
 	}
 
 	const weapon_component& gta_data_service::weapon_component_by_name(std::string name)
 	{
-		for (const auto& [name_key, component] : m_weapons_cache.weapon_components)
-			if (name_key == name)
-				return component;
+		const auto& components = data().m_weapon_components;
+
+		const auto it = std::lower_bound(components.begin(), components.end(), name, [](const weapon_component& component, const std::string& name) {
+			return component.m_name < name;
+		});
+		if (it != components.end() && it->m_name == name)
+			return *it;
 		return gta_data_service::empty_component;
 	}
 
-	string_vec& gta_data_service::ped_types()
+	const string_vec& gta_data_service::ped_types() const
+	{
+		return data().m_ped_types;
+	}
+
+	const string_vec& gta_data_service::vehicle_classes() const
+	{
+		return data().m_vehicle_classes;
+	}
+
+	const string_vec& gta_data_service::weapon_types() const
 	{
-		return m_ped_types;
+		return data().m_weapon_types;
 	}
 
-	string_vec& gta_data_service::vehicle_classes()
+	static string_vec load_strings(const gta_data_cache& cache, gta_data_section id)
 	{
-		return m_vehicle_classes;
+		string_vec strings;
+		for (const auto offset : cache.section<uint32_t>(id))
+			strings.emplace_back(cache.string(offset));
+		return strings;
+	}
+
+	static void load_peds(gta_data& data)
+	{
+		data.m_peds      = data.m_cache.section<ped_item>(gta_data_section::PEDS);
+		data.m_ped_index = {data.m_peds, data.m_cache.section<hash_index_entry>(gta_data_section::PED_INDEX)};
+		data.m_ped_types = load_strings(data.m_cache, gta_data_section::PED_TYPES);
+
+		LOG(INFO) << "Loaded " << data.m_peds.size() << " peds from cache.";
 	}
 
-	string_vec& gta_data_service::weapon_types()
+	static void load_vehicles(gta_data& data)
 	{
-		return m_weapon_types;
+		data.m_vehicles        = data.m_cache.section<vehicle_item>(gta_data_section::VEHICLES);
+		data.m_vehicle_index   = {data.m_vehicles, data.m_cache.section<hash_index_entry>(gta_data_section::VEHICLE_INDEX)};
+		data.m_vehicle_classes = load_strings(data.m_cache, gta_data_section::VEHICLE_CLASSES);
+
+		LOG(INFO) << "Loaded " << data.m_vehicles.size() << " vehicles from cache.";
 	}
 
-	bool gta_data_service::is_cache_up_to_date()
+	static void load_weapons(gta_data& data)
 	{
-		m_peds_cache.load();
-		m_vehicles_cache.load();
+		const auto weapons     = data.m_cache.section<packed_weapon_item>(gta_data_section::WEAPONS);
+		const auto attachments = data.m_cache.section<uint32_t>(gta_data_section::WEAPON_ATTACHMENTS);
 
-		auto weapons_file = g_file_manager.get_project_file("./cache/weapons.json");
-		if (weapons_file.exists())
+		data.m_weapons.reserve(weapons.size());
+		for (const auto& packed : weapons)
 		{
-			std::ifstream file(weapons_file.get_path());
-			file.open(weapons_file.get_path());
+			auto& weapon              = data.m_weapons.emplace_back();
+			weapon.m_name             = data.m_cache.string(packed.m_name);
+			weapon.m_display_name     = data.m_cache.string(packed.m_display_name);
+			weapon.m_display_desc     = data.m_cache.string(packed.m_display_desc);
+			weapon.m_weapon_type      = data.m_cache.string(packed.m_weapon_type);
+			weapon.m_hash             = packed.m_hash;
+			weapon.m_reward_hash      = packed.m_reward_hash;
+			weapon.m_reward_ammo_hash = packed.m_reward_ammo_hash;
+			weapon.m_throwable        = packed.m_throwable;
+
+			weapon.m_attachments.reserve(packed.m_attachment_count);
+			for (const auto offset : attachments.subspan(packed.m_first_attachment, packed.m_attachment_count))
+				weapon.m_attachments.emplace_back(data.m_cache.string(offset));
+		}
 
-			try
-			{
-				nlohmann::json weapons_file_json;
-				file >> weapons_file_json;
-				m_weapons_cache = weapons_file_json["weapons_cache"];
-				file.close();
-			}
-			catch (const std::exception& exception)
-			{
-				file.close();
-				LOG(WARNING) << "Detected corrupt weapons: " << exception.what();
-			}
+		const auto components = data.m_cache.section<packed_weapon_component>(gta_data_section::WEAPON_COMPONENTS);
+		data.m_weapon_components.reserve(components.size());
+		for (const auto& packed : components)
+		{
+			auto& component          = data.m_weapon_components.emplace_back();
+			component.m_name         = data.m_cache.string(packed.m_name);
+			component.m_display_name = data.m_cache.string(packed.m_display_name);
+			component.m_display_desc = data.m_cache.string(packed.m_display_desc);
+			component.m_hash         = packed.m_hash;
 		}
 
-		const auto file_version = memory::module("GTA5.exe").timestamp();
+		data.m_weapon_index           = {data.m_weapons, data.m_cache.section<hash_index_entry>(gta_data_section::WEAPON_INDEX)};
+		data.m_weapon_component_index = {data.m_weapon_components, data.m_cache.section<hash_index_entry>(gta_data_section::WEAPON_COMPONENT_INDEX)};
+		data.m_weapon_types           = load_strings(data.m_cache, gta_data_section::WEAPON_TYPES);
 
-		return m_peds_cache.up_to_date(file_version) && m_vehicles_cache.up_to_date(file_version) && m_weapons_cache.up_to_date(file_version);
+		LOG(INFO) << "Loaded " << data.m_weapons.size() << " weapons and " << data.m_weapon_components.size() << " weapon components from cache.";
 	}
 
-	void gta_data_service::load_data()
+	bool gta_data_service::load_data()
 	{
+		auto new_data = std::make_unique<gta_data>();
+		if (!new_data->m_cache.open(cache_path(), memory::module("GTA5.exe").timestamp()))
+			return false;
+
 		LOG(VERBOSE) << "Loading data from cache.";
 
-		load_peds();
-		load_vehicles();
-		load_weapons();
+		load_peds(*new_data);
+		load_vehicles(*new_data);
+		load_weapons(*new_data);
 
 		LOG(VERBOSE) << "Loaded all data from cache.";
+
+		m_data.store(new_data.get(), std::memory_order_release);
+		m_loaded_data.push_back(std::move(new_data));
+		return true;
 	}
 
-	void gta_data_service::load_peds()
+	static bool write_cache(uint32_t file_version, std::span<const ped_item> peds, std::span<const vehicle_item> vehicles, std::span<const weapon_item> weapons, std::span<const weapon_component> components)
 	{
-		const auto ped_count = m_peds_cache.data_size() / sizeof(ped_item);
-		LOG(INFO) << "Loading " << ped_count << " peds from cache.";
-
-		m_ped_types.clear();
-		m_ped_types.reserve(ped_count);
-		m_peds.clear();
+		gta_data_cache_writer writer;
+
+		const auto add_strings = [&writer](gta_data_section id, const std::set<std::string>& strings) {
+			std::vector<uint32_t> offsets;
+			offsets.reserve(strings.size());
+			for (const auto& str : strings)
+				offsets.push_back(writer.add_string(str));
+			writer.add_section<uint32_t>(id, offsets);
+		};
 
-		auto cached_peds = reinterpret_cast<const ped_item*>(m_peds_cache.data());
-		for (size_t i = 0; i < ped_count; i++)
+		std::set<std::string> ped_types;
+		for (const auto& ped : peds)
+			ped_types.insert(ped.m_ped_type);
+		writer.add_section(gta_data_section::PEDS, peds);
+		writer.add_section<hash_index_entry>(gta_data_section::PED_INDEX, hash_index<ped_item>::build(peds));
+		add_strings(gta_data_section::PED_TYPES, ped_types);
+
+		std::set<std::string> vehicle_classes;
+		for (const auto& vehicle : vehicles)
+			vehicle_classes.insert(vehicle.m_vehicle_class);
+		writer.add_section(gta_data_section::VEHICLES, vehicles);
+		writer.add_section<hash_index_entry>(gta_data_section::VEHICLE_INDEX, hash_index<vehicle_item>::build(vehicles));
+		add_strings(gta_data_section::VEHICLE_CLASSES, vehicle_classes);
+
+		std::set<std::string> weapon_types;
+		std::vector<packed_weapon_item> packed_weapons;
+		std::vector<uint32_t> attachments;
+		for (const auto& weapon : weapons)
 		{
-			const auto ped = cached_peds[i];
+			weapon_types.insert(weapon.m_weapon_type);
+
+			auto& packed              = packed_weapons.emplace_back();
+			packed.m_name             = writer.add_string(weapon.m_name);
+			packed.m_display_name     = writer.add_string(weapon.m_display_name);
+			packed.m_display_desc     = writer.add_string(weapon.m_display_desc);
+			packed.m_weapon_type      = writer.add_string(weapon.m_weapon_type);
+			packed.m_hash             = weapon.m_hash;
+			packed.m_reward_hash      = weapon.m_reward_hash;
+			packed.m_reward_ammo_hash = weapon.m_reward_ammo_hash;
+			packed.m_first_attachment = static_cast<uint32_t>(attachments.size());
+			packed.m_attachment_count = static_cast<uint32_t>(weapon.m_attachments.size());
+			packed.m_throwable        = weapon.m_throwable;
+
+			for (const auto& attachment : weapon.m_attachments)
+				attachments.push_back(writer.add_string(attachment));
+		}
+		writer.add_section<packed_weapon_item>(gta_data_section::WEAPONS, packed_weapons);
+		writer.add_section<hash_index_entry>(gta_data_section::WEAPON_INDEX, hash_index<weapon_item>::build(weapons));
+		add_strings(gta_data_section::WEAPON_TYPES, weapon_types);
+		writer.add_section<uint32_t>(gta_data_section::WEAPON_ATTACHMENTS, attachments);
 
-			add_if_not_exists(m_ped_types, ped.m_ped_type);
-			m_peds.insert({ped.m_name, ped});
+		std::vector<packed_weapon_component> packed_components;
+		for (const auto& component : components)
+		{
+			auto& packed          = packed_components.emplace_back();
+			packed.m_name         = writer.add_string(component.m_name);
+			packed.m_display_name = writer.add_string(component.m_display_name);
+			packed.m_display_desc = writer.add_string(component.m_display_desc);
+			packed.m_hash         = component.m_hash;
 		}
+		writer.add_section<packed_weapon_component>(gta_data_section::WEAPON_COMPONENTS, packed_components);
+		writer.add_section<hash_index_entry>(gta_data_section::WEAPON_COMPONENT_INDEX, hash_index<weapon_component>::build(components));
 
-		std::sort(m_ped_types.begin(), m_ped_types.end());
-		m_peds_cache.free();
+		return writer.write(cache_path(), file_version, g_pointers->m_gta.m_game_version, g_pointers->m_gta.m_online_version);
 	}
 
-	void gta_data_service::load_vehicles()
+	// what one RPF on disk produced, kept around so unchanged RPFs don't have to be read again on the next rebuild
+	struct rpf_source
 	{
-		const auto vehicle_count = m_vehicles_cache.data_size() / sizeof(vehicle_item);
-		LOG(INFO) << "Loading " << vehicle_count << " vehicles from cache.";
+		std::string m_path;
+		std::optional<rpf_fingerprint> m_fingerprint;
+		parsed_meta m_data;
+	};
+
+	// the sources only depend on the RPFs, not on the game build
+	constexpr uint32_t SOURCES_FILE_VERSION = 0;
 
-		m_vehicle_classes.clear();
-		m_vehicle_classes.reserve(vehicle_count);
-		m_vehicles.clear();
+	static std::filesystem::path sources_path()
+	{
+		return g_file_manager.get_project_file("./cache/gta_data_sources.bin").get_path();
+	}
 
-		auto cached_vehicles = reinterpret_cast<const vehicle_item*>(m_vehicles_cache.data());
-		for (size_t i = 0; i < vehicle_count; i++)
+	static std::unordered_map<std::string, rpf_source> load_sources()
+	{
+		gta_data_cache cache;
+		if (!cache.open(sources_path(), SOURCES_FILE_VERSION))
+			return {};
+
+		const auto peds        = cache.section<ped_item>(gta_data_section::SOURCE_PEDS);
+		const auto vehicles    = cache.section<vehicle_item>(gta_data_section::SOURCE_VEHICLES);
+		const auto weapons     = cache.section<packed_source_weapon>(gta_data_section::SOURCE_WEAPONS);
+		const auto components  = cache.section<packed_weapon_component>(gta_data_section::SOURCE_WEAPON_COMPONENTS);
+		const auto attachments = cache.section<uint32_t>(gta_data_section::SOURCE_WEAPON_ATTACHMENTS);
+
+		std::unordered_map<std::string, rpf_source> sources;
+		for (const auto& packed : cache.section<packed_rpf_source>(gta_data_section::SOURCES))
 		{
-			const auto vehicle = cached_vehicles[i];
+			rpf_source source;
+			source.m_path        = cache.string(packed.m_path);
+			source.m_fingerprint = rpf_fingerprint{packed.m_size, packed.m_write_time, packed.m_toc_hash};
+
+			const auto source_peds = peds.subspan(packed.m_first_ped, packed.m_ped_count);
+			source.m_data.m_peds.assign(source_peds.begin(), source_peds.end());
+
+			const auto source_vehicles = vehicles.subspan(packed.m_first_vehicle, packed.m_vehicle_count);
+			source.m_data.m_vehicles.assign(source_vehicles.begin(), source_vehicles.end());
 
-			add_if_not_exists(m_vehicle_classes, vehicle.m_vehicle_class);
-			m_vehicles.insert({vehicle.m_name, vehicle});
+			for (const auto& [item, file_type] : weapons.subspan(packed.m_first_weapon, packed.m_weapon_count))
+			{
+				auto& weapon              = source.m_data.m_weapons.emplace_back();
+				weapon.m_name             = cache.string(item.m_name);
+				weapon.m_display_name     = cache.string(item.m_display_name);
+				weapon.m_weapon_type      = cache.string(item.m_weapon_type);
+				weapon.m_hash             = item.m_hash;
+				weapon.m_reward_hash      = item.m_reward_hash;
+				weapon.m_reward_ammo_hash = item.m_reward_ammo_hash;
+				weapon.m_throwable        = item.m_throwable;
+				weapon.rpf_file_type      = static_cast<RPFDatafileSource>(file_type);
+
+				for (const auto offset : attachments.subspan(item.m_first_attachment, item.m_attachment_count))
+					weapon.m_attachments.emplace_back(cache.string(offset));
+			}
+
+			for (const auto& component : components.subspan(packed.m_first_weapon_component, packed.m_weapon_component_count))
+				source.m_data.m_weapon_components.push_back({cache.string(component.m_name), component.m_hash, cache.string(component.m_display_name), cache.string(component.m_display_desc)});
+
+			auto path = source.m_path;
+			sources.emplace(std::move(path), std::move(source));
 		}
 
-		std::sort(m_vehicle_classes.begin(), m_vehicle_classes.end());
-		m_vehicles_cache.free();
+		return sources;
 	}
 
-	void gta_data_service::load_weapons()
+	static bool write_sources(std::span<const rpf_source> sources)
 	{
-		LOG(INFO) << "Loading " << m_weapons_cache.weapon_map.size() << " weapons from cache.";
-		LOG(INFO) << "Loading " << m_weapons_cache.weapon_components.size() << " weapon components from cache.";
+		gta_data_cache_writer writer;
+
+		std::vector<packed_rpf_source> packed_sources;
+		std::vector<ped_item> peds;
+		std::vector<vehicle_item> vehicles;
+		std::vector<packed_source_weapon> weapons;
+		std::vector<packed_weapon_component> components;
+		std::vector<uint32_t> attachments;
+		for (const auto& source : sources)
+		{
+			// can't tell if it changed next time, it gets read again either way
+			if (!source.m_fingerprint)
+				continue;
 
-		std::sort(m_weapon_types.begin(), m_weapon_types.end());
+			auto& packed                    = packed_sources.emplace_back();
+			packed.m_path                   = writer.add_string(source.m_path);
+			packed.m_toc_hash               = source.m_fingerprint->m_toc_hash;
+			packed.m_size                   = source.m_fingerprint->m_size;
+			packed.m_write_time             = source.m_fingerprint->m_write_time;
+			packed.m_first_ped              = static_cast<uint32_t>(peds.size());
+			packed.m_ped_count              = static_cast<uint32_t>(source.m_data.m_peds.size());
+			packed.m_first_vehicle          = static_cast<uint32_t>(vehicles.size());
+			packed.m_vehicle_count          = static_cast<uint32_t>(source.m_data.m_vehicles.size());
+			packed.m_first_weapon           = static_cast<uint32_t>(weapons.size());
+			packed.m_weapon_count           = static_cast<uint32_t>(source.m_data.m_weapons.size());
+			packed.m_first_weapon_component = static_cast<uint32_t>(components.size());
+			packed.m_weapon_component_count = static_cast<uint32_t>(source.m_data.m_weapon_components.size());
+
+			peds.insert(peds.end(), source.m_data.m_peds.begin(), source.m_data.m_peds.end());
+			vehicles.insert(vehicles.end(), source.m_data.m_vehicles.begin(), source.m_data.m_vehicles.end());
+
+			for (const auto& weapon : source.m_data.m_weapons)
+			{
+				auto& [item, file_type]   = weapons.emplace_back();
+				item.m_name               = writer.add_string(weapon.m_name);
+				item.m_display_name       = writer.add_string(weapon.m_display_name);
+				item.m_weapon_type        = writer.add_string(weapon.m_weapon_type);
+				item.m_hash               = weapon.m_hash;
+				item.m_reward_hash        = weapon.m_reward_hash;
+				item.m_reward_ammo_hash   = weapon.m_reward_ammo_hash;
+				item.m_first_attachment   = static_cast<uint32_t>(attachments.size());
+				item.m_attachment_count   = static_cast<uint32_t>(weapon.m_attachments.size());
+				item.m_throwable          = weapon.m_throwable;
+				file_type                 = weapon.rpf_file_type;
+
+				for (const auto& attachment : weapon.m_attachments)
+					attachments.push_back(writer.add_string(attachment));
+			}
+
+			for (const auto& component : source.m_data.m_weapon_components)
+				components.push_back({writer.add_string(component.m_name), writer.add_string(component.m_loc_name), writer.add_string(component.m_loc_desc), component.m_hash});
+		}
+
+		writer.add_section<packed_rpf_source>(gta_data_section::SOURCES, packed_sources);
+		writer.add_section<ped_item>(gta_data_section::SOURCE_PEDS, peds);
+		writer.add_section<vehicle_item>(gta_data_section::SOURCE_VEHICLES, vehicles);
+		writer.add_section<packed_source_weapon>(gta_data_section::SOURCE_WEAPONS, weapons);
+		writer.add_section<packed_weapon_component>(gta_data_section::SOURCE_WEAPON_COMPONENTS, components);
+		writer.add_section<uint32_t>(gta_data_section::SOURCE_WEAPON_ATTACHMENTS, attachments);
+
+		return writer.write(sources_path(), SOURCES_FILE_VERSION, g_pointers->m_gta.m_game_version, g_pointers->m_gta.m_online_version);
 	}
 
 	static RPFDatafileSource determine_file_type(std::string file_path, std::string_view rpf_filename)
@@ -239,35 +432,10 @@ namespace big
 		return RPFDatafileSource::UNKNOWN;
 	}
 
-	inline void parse_ped(std::vector<ped_item>& peds, std::vector<uint32_t>& mapped_peds, pugi::xml_document& doc)
-	{
-		const auto& items = doc.select_nodes("/CPedModelInfo__InitDataList/InitDatas/Item");
-		for (const auto& item_node : items)
-		{
-			const auto& item = item_node.node();
-			const auto name  = item.child("Name").text().as_string();
-			const auto hash  = rage::joaat(name);
-
-			if (protection::is_crash_ped(hash))
-				continue;
-
-			if (std::find(mapped_peds.begin(), mapped_peds.end(), hash) != mapped_peds.end())
-				continue;
-
-			mapped_peds.emplace_back(hash);
-
-			auto ped = ped_item{};
-
-			std::strncpy(ped.m_name, name, sizeof(ped.m_name));
-
-			const auto ped_type = item.child("Pedtype").text().as_string();
-			std::strncpy(ped.m_ped_type, ped_type, sizeof(ped.m_ped_type));
-
-			ped.m_hash = hash;
-
-			peds.emplace_back(std::move(ped));
-		}
-	}
+	// files are handed to the thread pool in batches of about this size
+	constexpr size_t META_BATCH_SIZE = 4 * 1024 * 1024;
+	// keep the pool free for the jobs that block on it, parsing can wait for the next batch
+	constexpr size_t MAX_META_JOBS_IN_FLIGHT = 2;
 
 	void gta_data_service::rebuild_cache()
 	{
@@ -278,24 +446,13 @@ namespace big
 			return;
 		}
 
-		using hash_array = std::vector<uint32_t>;
-		hash_array mapped_peds{};
-		hash_array mapped_vehicles{};
-		hash_array mapped_weapons{};
-		hash_array mapped_components{};
-
 		int mp_weapons_thread_id = 0;
 
 		std::vector<ped_item> peds{};
 		std::vector<vehicle_item> vehicles{};
-		//std::vector<weapon_item> weapons;
 		std::unordered_map<Hash, weapon_item_parsed> weapons{};
 		std::vector<weapon_component> weapon_components{};
 
-		constexpr auto exists = [](const hash_array& arr, uint32_t val) -> bool {
-			return std::find(arr.begin(), arr.end(), val) != arr.end();
-		};
-
 		constexpr Hash script_hash = "MP_Weapons"_J;
 		if (!SCRIPT::GET_NUMBER_OF_THREADS_RUNNING_THE_SCRIPT_WITH_THIS_HASH(script_hash))
 		{
@@ -314,254 +471,216 @@ namespace big
 		}
 
 		LOG(INFO) << "Rebuilding cache started...";
-		yim_fipackfile::add_wrapper_call_back([&](yim_fipackfile& rpf_wrapper, std::filesystem::path path) -> void {
-			if (path.filename() == "vehicles.meta")
-			{
-				rpf_wrapper.read_xml_file(path, [&exists, &vehicles, &mapped_vehicles](pugi::xml_document& doc) {
-					const auto& items = doc.select_nodes("/CVehicleModelInfo__InitDataList/InitDatas/Item");
-					for (const auto& item_node : items)
-					{
-						const auto item = item_node.node();
 
-						std::string name = item.child("modelName").text().as_string();
-						std::transform(name.begin(), name.end(), name.begin(), ::toupper);
-						const auto hash = rage::joaat(name);
-						if (protection::is_crash_vehicle(hash))
-							continue;
-
-						if (exists(mapped_vehicles, hash))
-							continue;
-						mapped_vehicles.emplace_back(hash);
-
-						auto veh = vehicle_item{};
-						std::strncpy(veh.m_name, name.c_str(), sizeof(veh.m_name));
-
-						const auto manufacturer_display = item.child("vehicleMakeName").text().as_string();
-						std::strncpy(veh.m_display_manufacturer, manufacturer_display, sizeof(veh.m_display_manufacturer));
+		// the RPFs can only be read from here, parsing doesn't touch the game and is done on the thread pool while we keep reading
+		struct parse_job
+		{
+			std::future<std::vector<parsed_meta>> m_results;
+			// range of RPFs the batch has files from
+			uint32_t m_first_rpf;
+			uint32_t m_last_rpf;
+		};
+		std::vector<parse_job> parse_jobs;
+		std::vector<meta_file> batch;
+		size_t batch_size = 0;
+
+		const auto flush_batch = [&](bool force) {
+			if (batch.empty())
+				return;
+
+			const auto in_flight = std::ranges::count_if(parse_jobs, [](const parse_job& job) {
+				return job.m_results.wait_for(0s) != std::future_status::ready;
+			});
+			if (!force && (batch_size < META_BATCH_SIZE || static_cast<size_t>(in_flight) >= MAX_META_JOBS_IN_FLIGHT))
+				return;
+
+			const auto first_rpf = batch.front().m_rpf;
+			const auto last_rpf  = batch.back().m_rpf;
+			parse_jobs.push_back({g_thread_pool->push([files = std::move(batch)]() mutable {
+				return parse_meta_files(std::move(files));
+			}),
+			    first_rpf,
+			    last_rpf});
+			batch      = {};
+			batch_size = 0;
+		};
 
-						const auto game_name = item.child("gameName").text().as_string();
-						std::strncpy(veh.m_display_name, game_name, sizeof(veh.m_display_name));
+		// every RPF on disk in the order they were found, unchanged ones are taken from the last rebuild instead of being read again
+		auto previous_sources = load_sources();
+		std::vector<rpf_source> sources;
+		size_t reused_sources = 0;
 
-						const auto vehicle_class       = item.child("vehicleClass").text().as_string();
-						constexpr auto enum_prefix_len = 3;
-						if (std::strlen(vehicle_class) > enum_prefix_len)
-							std::strncpy(veh.m_vehicle_class, vehicle_class + enum_prefix_len, sizeof(veh.m_vehicle_class));
+		const auto add_file = [&](meta_file&& file) {
+			file.m_rpf = static_cast<uint32_t>(sources.size() - 1);
+			batch_size += file.m_data.size();
+			batch.push_back(std::move(file));
+			flush_batch(false);
+		};
 
-						veh.m_hash = hash;
+		yim_fipackfile::add_wrapper_call_back([&](yim_fipackfile& rpf_wrapper, std::filesystem::path path) -> void {
+			const auto read_meta = [&](meta_file_kind kind, RPFDatafileSource file_type = RPFDatafileSource::UNKNOWN) {
+				if (auto data = rpf_wrapper.read_file(path); !data.empty())
+					add_file({kind, 0, file_type, {}, std::move(data)});
+			};
 
-						vehicles.emplace_back(std::move(veh));
-					}
-				});
+			if (path.filename() == "vehicles.meta")
+			{
+				read_meta(meta_file_kind::VEHICLES);
 			}
 			else if (const auto file_str = path.string(); file_str.find("weaponcomponents") != std::string::npos && path.extension() == ".meta")
 			{
-				rpf_wrapper.read_xml_file(path, [&exists, &weapon_components, &mapped_components, &mp_weapons_thread_id](pugi::xml_document& doc) {
-					const auto& items = doc.select_nodes("/CWeaponComponentInfoBlob/Infos/*[self::Item[@type='CWeaponComponentInfo'] or self::Item[@type='CWeaponComponentFlashLightInfo'] or self::Item[@type='CWeaponComponentScopeInfo'] or self::Item[@type='CWeaponComponentSuppressorInfo'] or self::Item[@type='CWeaponComponentVariantModelInfo'] or self::Item[@type='CWeaponComponentClipInfo']]");
-					for (const auto& item_node : items)
-					{
-						const auto item        = item_node.node();
-						const std::string name = item.child("Name").text().as_string();
-						const auto hash        = rage::joaat(name);
-
-						if (!name.starts_with("COMPONENT") || name.ends_with("MK2_UPGRADE"))
-						{
-							continue;
-						}
-
-						if (exists(mapped_components, hash))
-						{
-							continue;
-						}
-						mapped_components.emplace_back(hash);
-
-						std::string LocName = item.child("LocName").text().as_string();
-						std::string LocDesc = item.child("LocDesc").text().as_string();
-
-						if (LocName.ends_with("RAIL"))
-							continue;
-
-						if (LocName.ends_with("INVALID"))
-						{
-							Hash weapon_hash = 0;
-							if (name.starts_with("COMPONENT_KNIFE"))
-								weapon_hash = "WEAPON_KNIFE"_J;
-							else if (name.starts_with("COMPONENT_KNUCKLE"))
-								weapon_hash = "WEAPON_KNUCKLE"_J;
-							else if (name.starts_with("COMPONENT_BAT"))
-								weapon_hash = "WEAPON_BAT"_J;
-							const auto display_string = scr_functions::get_component_name_string.call<const char*>(hash, weapon_hash);
-							if (display_string == nullptr)
-								continue;
-							LocName = display_string;
-						}
-
-						if (LocName.ends_with("INVALID"))
-							continue;
-
-						if (LocDesc.ends_with("INVALID"))
-						{
-							const auto display_string = scr_functions::get_component_desc_string.call<const char*>(hash, 0);
-							if (display_string != nullptr)
-								LocDesc = display_string;
-						}
-
-						if (LocDesc.ends_with("INVALID"))
-							LocDesc.clear();
-
-						weapon_component component;
-
-						component.m_name         = name;
-						component.m_hash         = hash;
-						component.m_display_name = LocName;
-						component.m_display_desc = LocDesc;
-
-						weapon_components.push_back(component);
-					}
-				});
+				read_meta(meta_file_kind::WEAPON_COMPONENTS);
 			}
 			else if (const auto file_str = path.string(); file_str.contains("weapon") && !file_str.contains("vehicle") && path.extension() == ".meta")
 			{
-				rpf_wrapper.read_xml_file(path, [&exists, &weapons, &mapped_weapons, file_str, &rpf_wrapper](pugi::xml_document& doc) {
-					const auto& items = doc.select_nodes("/CWeaponInfoBlob/Infos/Item/Infos/Item[@type='CWeaponInfo']");
-					for (const auto& item_node : items)
-					{
-						const auto item = item_node.node();
-						const auto name = item.child("Name").text().as_string();
-						const auto hash = rage::joaat(name);
-
-						if (hash == "WEAPON_STRICKLER"_J) // Gen9 exclusive
-							continue;
-
-						if (hash == "WEAPON_BIRD_CRAP"_J)
-							continue;
-
-						if (!exists(mapped_weapons, hash))
-							mapped_weapons.emplace_back(hash);
-
-						const auto human_name_hash = item.child("HumanNameHash").text().as_string();
-						if (std::strcmp(human_name_hash, "WT_INVALID") == 0 || std::strcmp(human_name_hash, "WT_VEHMINE") == 0)
-							continue;
-
-						std::string desc = scr_functions::get_weapon_desc_string.call<const char*>(hash, false);
-						if (desc.ends_with("INVALID"))
-							desc.clear();
-
-						auto weapon = weapon_item_parsed{};
-
-						weapon.m_name         = name;
-						weapon.m_display_name = human_name_hash;
-						weapon.m_display_desc = desc;
-						weapon.rpf_file_type  = determine_file_type(file_str, rpf_wrapper.get_name());
-
-						auto weapon_flags = std::string(item.child("WeaponFlags").text().as_string());
-
-						bool is_gun         = false;
-						bool is_rechargable = false;
-
-						const char* category = "";
-
-						std::size_t pos;
-						while ((pos = weapon_flags.find(' ')) != std::string::npos)
-						{
-							const auto flag = weapon_flags.substr(0, pos);
-							if (flag == "Thrown")
-							{
-								weapon.m_throwable = true;
-							}
-							else if (flag == "Gun")
-							{
-								is_gun = true;
-							}
-							else if (flag == "DisplayRechargeTimeHUD")
-							{
-								is_rechargable = true;
-							}
-							else if (flag == "Vehicle" || flag == "HiddenFromWeaponWheel" || flag == "NotAWeapon")
-							{
-								goto skip;
-							}
-
-							weapon_flags.erase(0, pos + 1);
-						}
-
-						category = item.child("Group").text().as_string();
-
-						if (std::strlen(category) == 0 || std::strcmp(category, "GROUP_DIGISCANNER") == 0)
-							continue;
-
-						if (std::strlen(category) > 6)
-						{
-							weapon.m_weapon_type = category + 6;
-						}
-
-						if (is_gun || weapon.m_weapon_type == "MELEE" || weapon.m_weapon_type == "UNARMED")
-						{
-							const std::string reward_prefix = "REWARD_";
-							weapon.m_reward_hash            = rage::joaat(reward_prefix + name);
-
-							if (is_gun && !is_rechargable)
-							{
-								std::string weapon_id     = name + 7;
-								weapon.m_reward_ammo_hash = rage::joaat(reward_prefix + "AMMO_" + weapon_id);
-							}
-						}
-
-						for (pugi::xml_node attach_point : item.child("AttachPoints").children("Item"))
-						{
-							for (pugi::xml_node component : attach_point.child("Components").children("Item"))
-							{
-								weapon.m_attachments.push_back(component.child_value("Name"));
-							}
-						}
-
-						weapon.m_hash = hash;
-
-						if (weapons.contains(hash))
-						{
-							if (weapons[hash].rpf_file_type > weapon.rpf_file_type)
-							{
-								continue;
-							}
-						}
-
-						weapons[hash] = weapon;
-					skip:
-						continue;
-					}
-				});
+				read_meta(meta_file_kind::WEAPONS, determine_file_type(file_str, rpf_wrapper.get_name()));
 			}
 			else if (path.filename() == "peds.meta")
 			{
-				rpf_wrapper.read_xml_file(path, [&exists, &peds, &mapped_peds](pugi::xml_document& doc) {
-					parse_ped(peds, mapped_peds, doc);
-				});
+				read_meta(meta_file_kind::PEDS);
 			}
 			else if (std::string str = rpf_wrapper.get_name(); (str.find("componentpeds") != std::string::npos || str.find("streamedpeds") != std::string::npos || str.find("mppatches") != std::string::npos || str.find("cutspeds") != std::string::npos) && path.extension() == ".yft")
 			{
-				const auto name = path.stem().string();
-				const auto hash = rage::joaat(name);
+				add_file({meta_file_kind::PED_MODEL, 0, RPFDatafileSource::UNKNOWN, path.stem().string(), {}});
+			}
+		});
 
-				if (protection::is_crash_ped(hash))
-					return;
+		if (state() == eGtaDataUpdateState::UPDATING)
+		{
+			yim_fipackfile::for_each_fipackfile([&](const std::filesystem::path& rpf_path) {
+				auto& source         = sources.emplace_back();
+				source.m_path        = rpf_path.string();
+				source.m_fingerprint = yim_fipackfile::fingerprint(rpf_path);
+
+				if (const auto it = previous_sources.find(source.m_path);
+				    it != previous_sources.end() && source.m_fingerprint && it->second.m_fingerprint == source.m_fingerprint)
+				{
+					source.m_data = std::move(it->second.m_data);
+					reused_sources++;
+					return false;
+				}
 
-				if (std::find(mapped_peds.begin(), mapped_peds.end(), hash) != mapped_peds.end())
-					return;
+				return true;
+			});
+		}
+		flush_batch(true);
+		previous_sources.clear();
 
-				mapped_peds.emplace_back(hash);
+		for (auto& job : parse_jobs)
+		{
+			while (job.m_results.wait_for(0s) != std::future_status::ready)
+				script::get_current()->yield();
 
-				auto ped = ped_item{};
+			try
+			{
+				for (auto& result : job.m_results.get())
+				{
+					auto& data = sources[result.m_rpf].m_data;
+					std::ranges::move(result.m_peds, std::back_inserter(data.m_peds));
+					std::ranges::move(result.m_vehicles, std::back_inserter(data.m_vehicles));
+					std::ranges::move(result.m_weapons, std::back_inserter(data.m_weapons));
+					std::ranges::move(result.m_weapon_components, std::back_inserter(data.m_weapon_components));
+				}
+			}
+			catch (const std::exception& e)
+			{
+				LOG(WARNING) << "Failed to parse a batch of meta files: " << e.what();
 
-				std::strncpy(ped.m_name, name.c_str(), sizeof(ped.m_name));
+				// incomplete, make sure they get read again next time
+				for (auto i = job.m_first_rpf; i <= job.m_last_rpf; i++)
+					sources[i].m_fingerprint = std::nullopt;
+			}
+		}
+		LOG(VERBOSE) << "Reused " << reused_sources << " of " << sources.size() << " RPFs from the last rebuild.";
 
-				ped.m_hash = hash;
+		// merged in the order the RPFs were found so the result is the same no matter what was reused
+		std::unordered_set<Hash> mapped_peds;
+		std::unordered_set<Hash> mapped_vehicles;
+		std::unordered_set<Hash> mapped_components;
+		for (const auto& source : sources)
+		{
+			for (const auto& ped : source.m_data.m_peds)
+			{
+				if (protection::is_crash_ped(ped.m_hash) || !mapped_peds.insert(ped.m_hash).second)
+					continue;
 
-				peds.emplace_back(std::move(ped));
+				peds.push_back(ped);
 			}
-		});
 
-		if (state() == eGtaDataUpdateState::UPDATING)
+			for (const auto& veh : source.m_data.m_vehicles)
+			{
+				if (protection::is_crash_vehicle(veh.m_hash) || !mapped_vehicles.insert(veh.m_hash).second)
+					continue;
+
+				vehicles.push_back(veh);
+			}
+
+			for (const auto& component : source.m_data.m_weapon_components)
+			{
+				if (!mapped_components.insert(component.m_hash).second)
+					continue;
+
+				const auto& name    = component.m_name;
+				std::string LocName = component.m_loc_name;
+				std::string LocDesc = component.m_loc_desc;
+
+				if (LocName.ends_with("RAIL"))
+					continue;
+
+				if (LocName.ends_with("INVALID"))
+				{
+					Hash weapon_hash = 0;
+					if (name.starts_with("COMPONENT_KNIFE"))
+						weapon_hash = "WEAPON_KNIFE"_J;
+					else if (name.starts_with("COMPONENT_KNUCKLE"))
+						weapon_hash = "WEAPON_KNUCKLE"_J;
+					else if (name.starts_with("COMPONENT_BAT"))
+						weapon_hash = "WEAPON_BAT"_J;
+					const auto display_string = scr_functions::get_component_name_string.call<const char*>(component.m_hash, weapon_hash);
+					if (display_string == nullptr)
+						continue;
+					LocName = display_string;
+				}
+
+				if (LocName.ends_with("INVALID"))
+					continue;
+
+				if (LocDesc.ends_with("INVALID"))
+				{
+					const auto display_string = scr_functions::get_component_desc_string.call<const char*>(component.m_hash, 0);
+					if (display_string != nullptr)
+						LocDesc = display_string;
+				}
+
+				if (LocDesc.ends_with("INVALID"))
+					LocDesc.clear();
+
+				weapon_component item;
+
+				item.m_name         = name;
+				item.m_hash         = component.m_hash;
+				item.m_display_name = std::move(LocName);
+				item.m_display_desc = std::move(LocDesc);
+
+				weapon_components.push_back(std::move(item));
+			}
+
+			for (const auto& weapon : source.m_data.m_weapons)
+			{
+				if (const auto it = weapons.find(weapon.m_hash); it != weapons.end() && it->second.rpf_file_type > weapon.rpf_file_type)
+					continue;
+
+				weapons[weapon.m_hash] = weapon;
+			}
+		}
+
+		// only needed for the weapons that made it through, each call runs script code
+		for (auto& [hash, weapon] : weapons)
 		{
-			yim_fipackfile::for_each_fipackfile();
+			if (const auto desc = scr_functions::get_weapon_desc_string.call<const char*>(hash, false); desc != nullptr)
+				weapon.m_display_desc = desc;
+			if (weapon.m_display_desc.ends_with("INVALID"))
+				weapon.m_display_desc.clear();
 		}
 
 		if (mp_weapons_thread_id != 0)
@@ -626,65 +745,56 @@ namespace big
 		          << "\n\tWeapons: " << weapons.size() << "\n\tWeaponComponents: " << weapon_components.size();
 
 		LOG(VERBOSE) << "Starting cache saving procedure...";
-		g_thread_pool->push([this, peds = std::move(peds), vehicles = std::move(vehicles), weapons = std::move(weapons), weapon_components = std::move(weapon_components)] {
+		g_thread_pool->push([this, peds = std::move(peds), vehicles = std::move(vehicles), weapons = std::move(weapons), weapon_components = std::move(weapon_components), sources = std::move(sources)]() mutable {
 			const auto file_version = memory::module("GTA5.exe").timestamp();
 
+			// the cache stores everything sorted by name
+			const auto by_name = [](const auto& a, const auto& b) {
+				return a.m_name < b.m_name;
+			};
+			const auto by_c_name = [](const auto& a, const auto& b) {
+				return std::strcmp(a.m_name, b.m_name) < 0;
+			};
+
+			std::sort(peds.begin(), peds.end(), by_c_name);
+			std::sort(vehicles.begin(), vehicles.end(), by_c_name);
+			std::sort(weapon_components.begin(), weapon_components.end(), by_name);
+
+			std::vector<weapon_item> sorted_weapons;
+			sorted_weapons.reserve(weapons.size());
+			for (const auto& [_, weapon] : weapons)
+				sorted_weapons.push_back(weapon);
+			std::sort(sorted_weapons.begin(), sorted_weapons.end(), by_name);
+
+			// readers can still be holding items of the current cache, so it can neither be unmapped nor overwritten.
+			// the file gets renamed instead, its mapping stays valid under the new name until the menu unloads
+			std::error_code ec;
+			if (data().m_cache.is_open())
+				std::filesystem::rename(cache_path(), retired_cache_path(), ec);
+
+			if (ec)
 			{
-				const auto data_size = sizeof(ped_item) * peds.size();
-				m_peds_cache.set_data(std::make_unique<uint8_t[]>(data_size), data_size);
-				std::memcpy(m_peds_cache.data(), peds.data(), data_size);
-
-				m_peds_cache.set_header_version(file_version);
-				m_peds_cache.write();
+				LOG(WARNING) << "Failed to move the current GTA data cache out of the way, keeping it: " << ec.message();
 			}
-
+			else if (!write_cache(file_version, peds, vehicles, sorted_weapons, weapon_components))
 			{
-				const auto data_size = sizeof(vehicle_item) * vehicles.size();
-				m_vehicles_cache.set_data(std::make_unique<uint8_t[]>(data_size), data_size);
-				std::memcpy(m_vehicles_cache.data(), vehicles.data(), data_size);
-
-				m_vehicles_cache.set_header_version(file_version);
-				m_vehicles_cache.write();
+				LOG(WARNING) << "Failed to write GTA data cache.";
 			}
-
+			else
 			{
-				m_weapons_cache.version_info.m_game_build     = g_pointers->m_gta.m_game_version;
-				m_weapons_cache.version_info.m_online_version = g_pointers->m_gta.m_online_version;
-				m_weapons_cache.version_info.m_file_version   = file_version;
-
-				m_weapon_types.clear();
-				m_weapon_types.reserve(weapons.size());
-				m_weapons_cache.weapon_map.clear();
-				for (auto weapon : weapons)
-				{
-					add_if_not_exists(m_weapon_types, weapon.second.m_weapon_type);
-					m_weapons_cache.weapon_map.insert({weapon.second.m_name, weapon.second});
-				}
+				LOG(INFO) << "Finished writing cache to disk.";
 
-				m_weapons_cache.weapon_components.clear();
-				for (auto weapon_component : weapon_components)
+				// superseded by gta_data.bin
+				for (const auto old_cache : {"./cache/peds.bin", "./cache/vehicles.bin", "./cache/weapons.json"})
 				{
-					m_weapons_cache.weapon_components.insert({weapon_component.m_name, weapon_component});
+					std::filesystem::remove(g_file_manager.get_project_file(old_cache).get_path(), ec);
 				}
 
-				auto weapons_file = g_file_manager.get_project_file("./cache/weapons.json");
-				std::ofstream file(weapons_file.get_path());
-				try
-				{
-					nlohmann::json weapons_file_json;
-					weapons_file_json["weapons_cache"] = m_weapons_cache;
-					file << weapons_file_json;
-					file.flush();
-				}
-				catch (const std::exception& exception)
-				{
-					LOG(WARNING) << "Failed to write weapons JSON: " << exception.what();
-				}
+				load_data();
 			}
 
-			LOG(INFO) << "Finished writing cache to disk.";
-
-			load_data();
+			if (!sources.empty() && !write_sources(sources))
+				LOG(WARNING) << "Failed to write GTA data sources, the next rebuild will read every RPF again.";
 
 			completed = true; //Prevent repeat calls.
 		});
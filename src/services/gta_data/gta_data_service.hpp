@@ -1,8 +1,9 @@
 #pragma once
-#include "cache_file.hpp"
+#include "gta_data_cache.hpp"
 #include "ped_item.hpp"
 #include "vehicle_item.hpp"
-#include "weapon_file.hpp"
+#include "weapon_component.hpp"
+#include "weapon_item.hpp"
 
 namespace big
 {
@@ -14,9 +15,28 @@ namespace big
 		UPDATING
 	};
 
-	using ped_map     = std::map<std::string, ped_item>;
-	using vehicle_map = std::map<std::string, vehicle_item>;
-	using string_vec  = std::vector<std::string>;
+	using string_vec = std::vector<std::string>;
+
+	// everything read from one version of the cache, replaced as a whole when the cache gets rebuilt
+	struct gta_data final
+	{
+		gta_data_cache m_cache;
+
+		std::span<const ped_item> m_peds;
+		std::span<const vehicle_item> m_vehicles;
+		// these hold std::strings and get unpacked from the cache once
+		std::vector<weapon_item> m_weapons;
+		std::vector<weapon_component> m_weapon_components;
+
+		hash_index<ped_item> m_ped_index;
+		hash_index<vehicle_item> m_vehicle_index;
+		hash_index<weapon_item> m_weapon_index;
+		hash_index<weapon_component> m_weapon_component_index;
+
+		string_vec m_ped_types;
+		string_vec m_vehicle_classes;
+		string_vec m_weapon_types;
+	};
 
 	class gta_data_service final
 	{
@@ -37,49 +57,44 @@ namespace big
 		const weapon_component& weapon_component_by_hash(uint32_t hash);
 		const weapon_component& weapon_component_by_name(std::string name);
 
-		string_vec& ped_types();
-		string_vec& vehicle_classes();
-		string_vec& weapon_types();
+		const string_vec& ped_types() const;
+		const string_vec& vehicle_classes() const;
+		const string_vec& weapon_types() const;
 
-		ped_map& peds()
+		// all of these are sorted by name, peds and vehicles are read straight from the mapped cache
+		std::span<const ped_item> peds() const
 		{
-			return m_peds;
+			return data().m_peds;
 		}
-		vehicle_map& vehicles()
+		std::span<const vehicle_item> vehicles() const
 		{
-			return m_vehicles;
+			return data().m_vehicles;
 		}
-		std::map<std::string, weapon_item>& weapons()
+		const std::vector<weapon_item>& weapons() const
 		{
-			return m_weapons_cache.weapon_map;
+			return data().m_weapons;
 		}
-		std::map<std::string, weapon_component>& weapon_components()
+		const std::vector<weapon_component>& weapon_components() const
 		{
-			return m_weapons_cache.weapon_components;
+			return data().m_weapon_components;
 		}
 
 	private:
-		bool is_cache_up_to_date();
+		const gta_data& data() const
+		{
+			return *m_data.load(std::memory_order_acquire);
+		}
 
-		void load_data();
-		void load_peds();
-		void load_vehicles();
-		void load_weapons();
+		// maps the cache on disk and makes it the current data, false if it's missing or outdated
+		bool load_data();
 
 		void rebuild_cache();
 
 	private:
-		cache_file m_peds_cache;
-		cache_file m_vehicles_cache;
-		weapon_file m_weapons_cache;
-
-		// std::map is free sorting algo
-		ped_map m_peds;
-		vehicle_map m_vehicles;
-
-		string_vec m_ped_types;
-		string_vec m_vehicle_classes;
-		string_vec m_weapon_types;
+		// The data readers currently get. A rebuild loads the new cache next to it and swaps the pointer,
+		// what readers got from the old one stays valid since every version is kept in m_loaded_data until shutdown.
+		std::atomic<const gta_data*> m_data;
+		std::vector<std::unique_ptr<gta_data>> m_loaded_data;
 
 		eGtaDataUpdateState m_update_state;
 
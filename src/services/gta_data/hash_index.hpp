@@ -0,0 +1,67 @@
+#pragma once
+#include <span>
+
+namespace big
+{
+#pragma pack(push, 4)
+	struct hash_index_entry
+	{
+		uint32_t m_hash;
+		// position of the item in its name sorted section
+		uint32_t m_index;
+	};
+#pragma pack(pop)
+
+	/**
+	 * @brief Lookup from joaat hash to an item of a name sorted array.
+	 *
+	 * The entries are sorted by hash and get stored in the gta data cache next to the items,
+	 * so a lookup is a binary search over memory that was mapped in with the rest of the cache.
+	 * Neither span is owned, the index has to be rebuilt whenever the items move.
+	 */
+	template<typename T>
+	class hash_index final
+	{
+	public:
+		hash_index() = default;
+		hash_index(std::span<const T> items, std::span<const hash_index_entry> entries) :
+		    m_items(items),
+		    m_entries(entries)
+		{
+		}
+
+		const T* find(uint32_t hash) const
+		{
+			const auto it = std::lower_bound(m_entries.begin(), m_entries.end(), hash, [](const hash_index_entry& entry, uint32_t hash) {
+				return entry.m_hash < hash;
+			});
+			if (it == m_entries.end() || it->m_hash != hash)
+				return nullptr;
+
+			return &m_items[it->m_index];
+		}
+
+		static std::vector<hash_index_entry> build(std::span<const T> items)
+		{
+			std::vector<hash_index_entry> entries;
+			entries.reserve(items.size());
+			for (uint32_t i = 0; i < items.size(); i++)
+				entries.push_back({items[i].m_hash, i});
+
+			// stable so the first item in name order wins on duplicate hashes
+			std::stable_sort(entries.begin(), entries.end(), [](const hash_index_entry& a, const hash_index_entry& b) {
+				return a.m_hash < b.m_hash;
+			});
+			entries.erase(std::unique(entries.begin(), entries.end(), [](const hash_index_entry& a, const hash_index_entry& b) {
+				return a.m_hash == b.m_hash;
+			}),
+			    entries.end());
+
+			return entries;
+		}
+
+	private:
+		std::span<const T> m_items;
+		std::span<const hash_index_entry> m_entries;
+	};
+}
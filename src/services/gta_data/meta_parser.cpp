@@ -0,0 +1,325 @@
+#include "meta_parser.hpp"
+
+#include "gta/joaat.hpp"
+#include "meta_reader.hpp"
+
+namespace big
+{
+	// calls cb for every child of the open element named name, cb has to consume the child
+	template<typename F>
+	static void for_each_child(meta_reader& reader, std::string_view name, F&& cb)
+	{
+		while (reader.next_child())
+		{
+			if (reader.name() == name)
+				cb();
+			else
+				reader.skip();
+		}
+	}
+
+	// only the first element of a name counts, same as XPath child lookups
+	static void read_field(meta_reader& reader, std::optional<std::string>& field)
+	{
+		if (field)
+			reader.skip();
+		else
+			field = reader.text();
+	}
+
+	static void parse_vehicle(parsed_meta& result, meta_reader& reader)
+	{
+		std::optional<std::string> model_name, make_name, game_name, vehicle_class;
+		while (reader.next_child())
+		{
+			const auto field = reader.name();
+			if (field == "modelName")
+				read_field(reader, model_name);
+			else if (field == "vehicleMakeName")
+				read_field(reader, make_name);
+			else if (field == "gameName")
+				read_field(reader, game_name);
+			else if (field == "vehicleClass")
+				read_field(reader, vehicle_class);
+			else
+				reader.skip();
+		}
+
+		std::string name = model_name.value_or("");
+		std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+
+		auto veh = vehicle_item{};
+		std::strncpy(veh.m_name, name.c_str(), sizeof(veh.m_name));
+		std::strncpy(veh.m_display_manufacturer, make_name.value_or("").c_str(), sizeof(veh.m_display_manufacturer));
+		std::strncpy(veh.m_display_name, game_name.value_or("").c_str(), sizeof(veh.m_display_name));
+
+		constexpr auto enum_prefix_len = 3;
+		if (vehicle_class && vehicle_class->size() > enum_prefix_len)
+			std::strncpy(veh.m_vehicle_class, vehicle_class->c_str() + enum_prefix_len, sizeof(veh.m_vehicle_class));
+
+		veh.m_hash = rage::joaat(name);
+
+		result.m_vehicles.emplace_back(std::move(veh));
+	}
+
+	static void parse_vehicles(parsed_meta& result, meta_reader& reader)
+	{
+		for_each_child(reader, "CVehicleModelInfo__InitDataList", [&] {
+			for_each_child(reader, "InitDatas", [&] {
+				for_each_child(reader, "Item", [&] {
+					parse_vehicle(result, reader);
+				});
+			});
+		});
+	}
+
+	static bool is_weapon_component_info(std::string_view type)
+	{
+		return type == "CWeaponComponentInfo" || type == "CWeaponComponentFlashLightInfo" || type == "CWeaponComponentScopeInfo"
+		    || type == "CWeaponComponentSuppressorInfo" || type == "CWeaponComponentVariantModelInfo" || type == "CWeaponComponentClipInfo";
+	}
+
+	static void parse_weapon_component(parsed_meta& result, meta_reader& reader)
+	{
+		std::optional<std::string> name, loc_name, loc_desc;
+		while (reader.next_child())
+		{
+			const auto field = reader.name();
+			if (field == "Name")
+				read_field(reader, name);
+			else if (field == "LocName")
+				read_field(reader, loc_name);
+			else if (field == "LocDesc")
+				read_field(reader, loc_desc);
+			else
+				reader.skip();
+		}
+
+		if (!name || !name->starts_with("COMPONENT") || name->ends_with("MK2_UPGRADE"))
+			return;
+
+		const auto hash = rage::joaat(*name);
+		result.m_weapon_components.push_back({std::move(*name), hash, loc_name.value_or(""), loc_desc.value_or("")});
+	}
+
+	static void parse_weapon_components(parsed_meta& result, meta_reader& reader)
+	{
+		for_each_child(reader, "CWeaponComponentInfoBlob", [&] {
+			for_each_child(reader, "Infos", [&] {
+				for_each_child(reader, "Item", [&] {
+					if (is_weapon_component_info(reader.attribute("type")))
+						parse_weapon_component(result, reader);
+					else
+						reader.skip();
+				});
+			});
+		});
+	}
+
+	static void parse_weapon(parsed_meta& result, meta_reader& reader, RPFDatafileSource source)
+	{
+		std::optional<std::string> name, human_name_hash, flags, group;
+		std::vector<std::string> attachments;
+		bool has_attach_points = false;
+
+		while (reader.next_child())
+		{
+			const auto field = reader.name();
+			if (field == "Name")
+				read_field(reader, name);
+			else if (field == "HumanNameHash")
+				read_field(reader, human_name_hash);
+			else if (field == "WeaponFlags")
+				read_field(reader, flags);
+			else if (field == "Group")
+				read_field(reader, group);
+			else if (field == "AttachPoints" && !has_attach_points)
+			{
+				has_attach_points = true;
+				for_each_child(reader, "Item", [&] {
+					bool has_components = false;
+					for_each_child(reader, "Components", [&] {
+						if (has_components)
+							return reader.skip();
+						has_components = true;
+
+						for_each_child(reader, "Item", [&] {
+							std::optional<std::string> component;
+							for_each_child(reader, "Name", [&] {
+								read_field(reader, component);
+							});
+							attachments.push_back(component.value_or(""));
+						});
+					});
+				});
+			}
+			else
+				reader.skip();
+		}
+
+		const auto weapon_name = name.value_or("");
+		const auto hash        = rage::joaat(weapon_name);
+
+		if (hash == "WEAPON_STRICKLER"_J) // Gen9 exclusive
+			return;
+
+		if (hash == "WEAPON_BIRD_CRAP"_J)
+			return;
+
+		const auto display_name = human_name_hash.value_or("");
+		if (display_name == "WT_INVALID" || display_name == "WT_VEHMINE")
+			return;
+
+		auto weapon = weapon_item_parsed{};
+
+		weapon.m_name         = weapon_name;
+		weapon.m_display_name = display_name;
+		weapon.rpf_file_type  = source;
+
+		auto weapon_flags = flags.value_or("");
+
+		bool is_gun         = false;
+		bool is_rechargable = false;
+
+		std::size_t pos;
+		while ((pos = weapon_flags.find(' ')) != std::string::npos)
+		{
+			const auto flag = weapon_flags.substr(0, pos);
+			if (flag == "Thrown")
+				weapon.m_throwable = true;
+			else if (flag == "Gun")
+				is_gun = true;
+			else if (flag == "DisplayRechargeTimeHUD")
+				is_rechargable = true;
+			else if (flag == "Vehicle" || flag == "HiddenFromWeaponWheel" || flag == "NotAWeapon")
+				return;
+
+			weapon_flags.erase(0, pos + 1);
+		}
+
+		const auto category = group.value_or("");
+
+		if (category.empty() || category == "GROUP_DIGISCANNER")
+			return;
+
+		if (category.size() > 6)
+			weapon.m_weapon_type = category.substr(6);
+
+		if (is_gun || weapon.m_weapon_type == "MELEE" || weapon.m_weapon_type == "UNARMED")
+		{
+			const std::string reward_prefix = "REWARD_";
+			weapon.m_reward_hash            = rage::joaat(reward_prefix + weapon_name);
+
+			if (is_gun && !is_rechargable && weapon_name.size() > 7)
+			{
+				std::string weapon_id     = weapon_name.substr(7);
+				weapon.m_reward_ammo_hash = rage::joaat(reward_prefix + "AMMO_" + weapon_id);
+			}
+		}
+
+		weapon.m_attachments = std::move(attachments);
+		weapon.m_hash        = hash;
+
+		result.m_weapons.emplace_back(std::move(weapon));
+	}
+
+	static void parse_weapons(parsed_meta& result, meta_reader& reader, RPFDatafileSource source)
+	{
+		for_each_child(reader, "CWeaponInfoBlob", [&] {
+			for_each_child(reader, "Infos", [&] {
+				for_each_child(reader, "Item", [&] {
+					for_each_child(reader, "Infos", [&] {
+						for_each_child(reader, "Item", [&] {
+							if (reader.attribute("type") == "CWeaponInfo")
+								parse_weapon(result, reader, source);
+							else
+								reader.skip();
+						});
+					});
+				});
+			});
+		});
+	}
+
+	static void parse_ped(parsed_meta& result, meta_reader& reader)
+	{
+		std::optional<std::string> name, ped_type;
+		while (reader.next_child())
+		{
+			const auto field = reader.name();
+			if (field == "Name")
+				read_field(reader, name);
+			else if (field == "Pedtype")
+				read_field(reader, ped_type);
+			else
+				reader.skip();
+		}
+
+		auto ped = ped_item{};
+
+		std::strncpy(ped.m_name, name.value_or("").c_str(), sizeof(ped.m_name));
+		std::strncpy(ped.m_ped_type, ped_type.value_or("").c_str(), sizeof(ped.m_ped_type));
+
+		ped.m_hash = rage::joaat(name.value_or(""));
+
+		result.m_peds.emplace_back(std::move(ped));
+	}
+
+	static void parse_peds(parsed_meta& result, meta_reader& reader)
+	{
+		for_each_child(reader, "CPedModelInfo__InitDataList", [&] {
+			for_each_child(reader, "InitDatas", [&] {
+				for_each_child(reader, "Item", [&] {
+					parse_ped(result, reader);
+				});
+			});
+		});
+	}
+
+	std::vector<parsed_meta> parse_meta_files(std::vector<meta_file> files)
+	{
+		std::vector<parsed_meta> results;
+
+		for (const auto& file : files)
+		{
+			if (results.empty() || results.back().m_rpf != file.m_rpf)
+				results.emplace_back().m_rpf = file.m_rpf;
+			auto& result = results.back();
+
+			if (file.m_kind == meta_file_kind::PED_MODEL)
+			{
+				auto ped = ped_item{};
+				std::strncpy(ped.m_name, file.m_name.c_str(), sizeof(ped.m_name));
+				ped.m_hash = rage::joaat(file.m_name);
+
+				result.m_peds.emplace_back(std::move(ped));
+				continue;
+			}
+
+			const auto peds              = result.m_peds.size();
+			const auto vehicles          = result.m_vehicles.size();
+			const auto weapons           = result.m_weapons.size();
+			const auto weapon_components = result.m_weapon_components.size();
+
+			meta_reader reader({reinterpret_cast<const char*>(file.m_data.data()), file.m_data.size()});
+			switch (file.m_kind)
+			{
+			case meta_file_kind::VEHICLES: parse_vehicles(result, reader); break;
+			case meta_file_kind::WEAPONS: parse_weapons(result, reader, file.m_file_type); break;
+			case meta_file_kind::WEAPON_COMPONENTS: parse_weapon_components(result, reader); break;
+			case meta_file_kind::PEDS: parse_peds(result, reader); break;
+			}
+
+			// a malformed file is dropped as a whole, like it was when the DOM failed to load
+			if (reader.failed())
+			{
+				result.m_peds.resize(peds);
+				result.m_vehicles.resize(vehicles);
+				result.m_weapons.resize(weapons);
+				result.m_weapon_components.resize(weapon_components);
+			}
+		}
+
+		return results;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "ped_item.hpp"
+#include "vehicle_item.hpp"
+#include "weapon_item.hpp"
+
+namespace big
+{
+	enum class meta_file_kind : uint8_t
+	{
+		VEHICLES,
+		WEAPONS,
+		WEAPON_COMPONENTS,
+		PEDS,
+		// a streamed ped model, only the name is known
+		PED_MODEL
+	};
+
+	// read out of an RPF on the game thread, parsed on the thread pool
+	struct meta_file
+	{
+		meta_file_kind m_kind;
+		// index of the RPF on disk the file was found in
+		uint32_t m_rpf = 0;
+		RPFDatafileSource m_file_type = RPFDatafileSource::UNKNOWN;
+		// model name for PED_MODEL
+		std::string m_name;
+		std::vector<uint8_t> m_data;
+	};
+
+	struct parsed_weapon_component
+	{
+		std::string m_name;
+		Hash m_hash;
+		std::string m_loc_name;
+		std::string m_loc_desc;
+	};
+
+	/**
+	 * @brief Everything found in the meta files of one RPF, in file order.
+	 *
+	 * Nothing in here has been deduplicated or checked against the running game yet, that happens on the game thread
+	 * when the results get merged in the order they were read.
+	 */
+	struct parsed_meta
+	{
+		uint32_t m_rpf = 0;
+		std::vector<ped_item> m_peds;
+		std::vector<vehicle_item> m_vehicles;
+		std::vector<weapon_item_parsed> m_weapons;
+		std::vector<parsed_weapon_component> m_weapon_components;
+	};
+
+	// returns one result per run of files from the same RPF, doesn't touch any game state and is safe to call from any thread
+	std::vector<parsed_meta> parse_meta_files(std::vector<meta_file> files);
+}
@@ -0,0 +1,340 @@
+#include "meta_reader.hpp"
+
+#include <charconv>
+
+namespace big
+{
+	static bool is_space(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	static bool is_name_end(char c)
+	{
+		return is_space(c) || c == '/' || c == '>' || c == '=';
+	}
+
+	static void append_utf8(std::string& out, uint32_t cp)
+	{
+		if (cp < 0x80)
+		{
+			out.push_back(static_cast<char>(cp));
+		}
+		else if (cp < 0x800)
+		{
+			out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+		else if (cp < 0x10000)
+		{
+			out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+		else
+		{
+			out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+	}
+
+	// same result pugixml gives for text(): entities decoded and line endings normalized
+	static std::string decode(std::string_view raw)
+	{
+		std::string out;
+		out.reserve(raw.size());
+
+		for (size_t i = 0; i < raw.size(); i++)
+		{
+			const auto c = raw[i];
+			if (c == '\r')
+			{
+				out.push_back('\n');
+				if (i + 1 < raw.size() && raw[i + 1] == '\n')
+					i++;
+				continue;
+			}
+			if (c != '&')
+			{
+				out.push_back(c);
+				continue;
+			}
+
+			const auto end = raw.find(';', i);
+			if (end == std::string_view::npos)
+			{
+				out.push_back(c);
+				continue;
+			}
+
+			const auto entity = raw.substr(i + 1, end - i - 1);
+			if (entity == "lt")
+				out.push_back('<');
+			else if (entity == "gt")
+				out.push_back('>');
+			else if (entity == "amp")
+				out.push_back('&');
+			else if (entity == "apos")
+				out.push_back('\'');
+			else if (entity == "quot")
+				out.push_back('"');
+			else if (entity.size() > 1 && entity[0] == '#')
+			{
+				const auto hex    = entity[1] == 'x';
+				const auto digits = entity.substr(hex ? 2 : 1);
+
+				uint32_t cp{};
+				const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), cp, hex ? 16 : 10);
+				if (ec != std::errc() || ptr != digits.data() + digits.size() || cp > 0x10FFFF)
+				{
+					out.push_back(c);
+					continue;
+				}
+				append_utf8(out, cp);
+			}
+			else
+			{
+				out.push_back(c);
+				continue;
+			}
+
+			i = end;
+		}
+
+		return out;
+	}
+
+	meta_reader::meta_reader(std::string_view data) :
+	    m_data(data)
+	{
+		if (m_data.starts_with("\xEF\xBB\xBF"))
+			m_pos = 3;
+	}
+
+	bool meta_reader::next_child()
+	{
+		const auto parent_depth = m_open.size();
+		while (true)
+		{
+			switch (next())
+			{
+			case token::START:
+				if (m_open.size() == parent_depth + 1)
+					return true;
+				break;
+			case token::END:
+				if (m_open.size() < parent_depth)
+					return false;
+				break;
+			case token::TEXT: break;
+			case token::DONE: return false;
+			}
+		}
+	}
+
+	std::string meta_reader::text()
+	{
+		const auto depth = m_open.size();
+		std::string result;
+		bool found = false;
+		while (true)
+		{
+			switch (next())
+			{
+			case token::TEXT:
+				if (!found && m_open.size() == depth)
+				{
+					result = decode(m_text);
+					found  = true;
+				}
+				break;
+			case token::END:
+				if (m_open.size() < depth)
+					return result;
+				break;
+			case token::START: break;
+			case token::DONE: return result;
+			}
+		}
+	}
+
+	void meta_reader::skip()
+	{
+		const auto depth = m_open.size();
+		while (true)
+		{
+			const auto result = next();
+			if (result == token::DONE || (result == token::END && m_open.size() < depth))
+				return;
+		}
+	}
+
+	std::string_view meta_reader::attribute(std::string_view name) const
+	{
+		for (const auto& [key, value] : m_attributes)
+			if (key == name)
+				return value;
+		return {};
+	}
+
+	meta_reader::token meta_reader::fail()
+	{
+		m_failed = true;
+		m_pos    = m_data.size();
+		m_open.clear();
+		return token::DONE;
+	}
+
+	meta_reader::token meta_reader::next()
+	{
+		if (m_pending_end)
+		{
+			m_pending_end = false;
+			m_name        = m_open.back();
+			m_open.pop_back();
+			return token::END;
+		}
+
+		while (m_pos < m_data.size())
+		{
+			if (m_data[m_pos] != '<')
+			{
+				const auto end = std::min(m_data.find('<', m_pos), m_data.size());
+				m_text         = m_data.substr(m_pos, end - m_pos);
+				m_pos          = end;
+
+				// whitespace between elements isn't text, pugixml drops it as well
+				if (std::ranges::all_of(m_text, is_space))
+					continue;
+				if (m_open.empty())
+					return fail();
+				return token::TEXT;
+			}
+
+			const auto rest = m_data.substr(m_pos);
+			if (rest.starts_with("<!--"))
+			{
+				const auto end = rest.find("-->", 4);
+				if (end == std::string_view::npos)
+					return fail();
+				m_pos += end + 3;
+			}
+			else if (rest.starts_with("<![CDATA["))
+			{
+				const auto end = rest.find("]]>", 9);
+				if (end == std::string_view::npos || m_open.empty())
+					return fail();
+				m_text = rest.substr(9, end - 9);
+				m_pos += end + 3;
+				return token::TEXT;
+			}
+			else if (rest.starts_with("<?"))
+			{
+				const auto end = rest.find("?>", 2);
+				if (end == std::string_view::npos)
+					return fail();
+				m_pos += end + 2;
+			}
+			else if (rest.starts_with("<!"))
+			{
+				// doctype, the meta files don't have an internal subset
+				const auto end = rest.find('>', 2);
+				if (end == std::string_view::npos)
+					return fail();
+				m_pos += end + 1;
+			}
+			else if (rest.starts_with("</"))
+			{
+				const auto end = rest.find('>', 2);
+				if (end == std::string_view::npos || m_open.empty())
+					return fail();
+
+				auto name = rest.substr(2, end - 2);
+				while (!name.empty() && is_space(name.back()))
+					name.remove_suffix(1);
+				if (name != m_open.back())
+					return fail();
+
+				m_pos += end + 1;
+				m_name = name;
+				m_open.pop_back();
+				return token::END;
+			}
+			else
+			{
+				if (!read_start_tag())
+					return fail();
+				return token::START;
+			}
+		}
+
+		if (!m_open.empty())
+			return fail();
+		return token::DONE;
+	}
+
+	bool meta_reader::read_start_tag()
+	{
+		auto pos        = m_pos + 1;
+		const auto size = m_data.size();
+
+		const auto name_start = pos;
+		while (pos < size && !is_name_end(m_data[pos]))
+			pos++;
+		if (pos == name_start || pos == size)
+			return false;
+		m_name = m_data.substr(name_start, pos - name_start);
+
+		m_attributes.clear();
+		while (true)
+		{
+			while (pos < size && is_space(m_data[pos]))
+				pos++;
+			if (pos >= size)
+				return false;
+
+			if (m_data[pos] == '>')
+			{
+				pos++;
+				break;
+			}
+			if (m_data[pos] == '/')
+			{
+				if (pos + 1 >= size || m_data[pos + 1] != '>')
+					return false;
+				pos += 2;
+				m_pending_end = true;
+				break;
+			}
+
+			const auto key_start = pos;
+			while (pos < size && !is_name_end(m_data[pos]))
+				pos++;
+			const auto key = m_data.substr(key_start, pos - key_start);
+
+			while (pos < size && is_space(m_data[pos]))
+				pos++;
+			if (key.empty() || pos >= size || m_data[pos] != '=')
+				return false;
+			pos++;
+			while (pos < size && is_space(m_data[pos]))
+				pos++;
+			if (pos >= size || (m_data[pos] != '"' && m_data[pos] != '\''))
+				return false;
+
+			const auto quote = m_data[pos++];
+			const auto end   = m_data.find(quote, pos);
+			if (end == std::string_view::npos)
+				return false;
+
+			m_attributes.emplace_back(key, m_data.substr(pos, end - pos));
+			pos = end + 1;
+		}
+
+		m_pos = pos;
+		m_open.push_back(m_name);
+		return true;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace big
+{
+	/**
+	 * @brief Forward only reader for the XML dialect used by .meta files.
+	 *
+	 * Names and attribute values point into the buffer, which has to outlive the reader, only text() returns a copy
+	 * with entities decoded. The attributes of the current element and the stack of open elements are kept in vectors
+	 * that get reused, so walking a file only allocates until they have grown to the deepest nesting and the most
+	 * attributes seen. Only what the rebuild needs is supported: elements, attributes, text and CDATA,
+	 * comments, declarations and processing instructions are skipped.
+	 *
+	 * The reader is driven one element at a time, every element returned by next_child() has to be consumed
+	 * with either text(), skip() or a next_child() loop of its own before moving on to its next sibling:
+	 * @code
+	 * while (reader.next_child())
+	 * {
+	 *     if (reader.name() == "Name")
+	 *         name = reader.text();
+	 *     else
+	 *         reader.skip();
+	 * }
+	 * @endcode
+	 */
+	class meta_reader final
+	{
+	public:
+		explicit meta_reader(std::string_view data);
+
+		/**
+		 * @brief Moves to the next child of the element currently open.
+		 *
+		 * @return False once the element is closed, on the end of the document or on malformed input.
+		 */
+		bool next_child();
+
+		// consumes the element returned by next_child() and returns its first text node with entities decoded
+		std::string text();
+		// consumes the element returned by next_child() including all of its children
+		void skip();
+
+		// name of the element returned by next_child()
+		std::string_view name() const
+		{
+			return m_name;
+		}
+
+		// raw value of an attribute of the element returned by next_child(), empty if missing
+		std::string_view attribute(std::string_view name) const;
+
+		// true if the document turned out to be malformed, anything read so far shouldn't be trusted
+		bool failed() const
+		{
+			return m_failed;
+		}
+
+	private:
+		enum class token
+		{
+			START,
+			END,
+			TEXT,
+			DONE
+		};
+
+		token next();
+		token fail();
+		bool read_start_tag();
+
+	private:
+		std::string_view m_data;
+		size_t m_pos = 0;
+		bool m_failed = false;
+
+		std::string_view m_name;
+		std::string_view m_text;
+		bool m_pending_end = false;
+
+		std::vector<std::pair<std::string_view, std::string_view>> m_attributes;
+		// names of the open elements, used to match end tags
+		std::vector<std::string_view> m_open;
+	};
+}
@@ -110,7 +110,7 @@ namespace big
 		return {};
 	}
 
-	void yim_fipackfile::for_each_fipackfile()
+	void yim_fipackfile::for_each_fipackfile(const rpf_filter& filter)
 	{
 		const auto gta_folder = get_game_folder_path();
 		if (gta_folder.empty())
@@ -146,11 +146,57 @@ namespace big
 			if (utf8_path.contains("mods"))
 				continue;
 
-			if (rel_path.extension() == ".rpf")
+			if (rel_path.extension() == ".rpf" && (!filter || filter(rel_path)))
 				traverse_rpf_file(rel_path.u8string());
 		}
 	}
 
+	std::optional<rpf_fingerprint> yim_fipackfile::fingerprint(const std::filesystem::path& rpf_path)
+	{
+		struct rpf7_header
+		{
+			uint32_t m_magic;
+			uint32_t m_entry_count;
+			uint32_t m_names_length;
+			uint32_t m_encryption;
+		};
+		constexpr uint32_t RPF7_MAGIC = 0x52504637;
+		constexpr uint32_t RPF7_ENTRY_SIZE = 16;
+
+		std::error_code ec;
+		const auto size       = std::filesystem::file_size(rpf_path, ec);
+		const auto write_time = std::filesystem::last_write_time(rpf_path, ec);
+		if (ec)
+			return std::nullopt;
+
+		std::ifstream file(rpf_path, std::ios::binary);
+		rpf7_header header{};
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.m_magic != RPF7_MAGIC)
+			return std::nullopt;
+
+		// the table of contents is hashed as stored, encrypted or not
+		const auto toc_size = uint64_t(header.m_entry_count) * RPF7_ENTRY_SIZE + header.m_names_length;
+		if (toc_size > size - sizeof(header))
+			return std::nullopt;
+
+		std::vector<char> toc(toc_size);
+		if (!file.read(toc.data(), toc.size()))
+			return std::nullopt;
+
+		uint32_t toc_hash = 0x811C9DC5;
+		const auto hash   = [&toc_hash](const char* data, size_t length) {
+			for (size_t i = 0; i < length; i++)
+			{
+				toc_hash ^= static_cast<uint8_t>(data[i]);
+				toc_hash *= 0x01000193;
+			}
+		};
+		hash(reinterpret_cast<const char*>(&header), sizeof(header));
+		hash(toc.data(), toc.size());
+
+		return rpf_fingerprint{size, static_cast<uint64_t>(write_time.time_since_epoch().count()), toc_hash};
+	}
+
 	std::vector<std::filesystem::path> yim_fipackfile::get_file_paths(std::string parent)
 	{
 		std::vector<std::filesystem::path> file_paths;
@@ -215,6 +261,19 @@ namespace big
 		}
 	}
 
+	std::vector<uint8_t> yim_fipackfile::read_file(const std::filesystem::path& path)
+	{
+		std::vector<uint8_t> file_content;
+		if (const auto handle = rpf->Open(path.string().c_str(), true); handle != -1)
+		{
+			file_content.resize(rpf->GetFileLength(handle));
+			rpf->ReadFull(handle, file_content.data(), static_cast<uint32_t>(file_content.size()));
+
+			rpf->Close(handle);
+		}
+		return file_content;
+	}
+
 	void yim_fipackfile::read_xml_file(const std::filesystem::path& path, std::function<void(pugi::xml_document& doc)> cb)
 	{
 		read_file(path, [&cb](const std::unique_ptr<uint8_t[]>& file_content, const int data_size) {
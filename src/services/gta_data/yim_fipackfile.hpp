@@ -5,6 +5,18 @@
 namespace big
 {
 	using file_contents_callback = std::function<void(const std::unique_ptr<uint8_t[]>& file_content, const int data_size)>;
+	// called with the path of every RPF on disk before it gets opened, return false to skip it
+	using rpf_filter = std::function<bool(const std::filesystem::path& rpf_path)>;
+
+	struct rpf_fingerprint
+	{
+		uint64_t m_size;
+		uint64_t m_write_time;
+		// hash of the RPF header and table of contents
+		uint32_t m_toc_hash;
+
+		bool operator==(const rpf_fingerprint&) const = default;
+	};
 
 	class yim_fipackfile
 	{
@@ -20,13 +32,18 @@ namespace big
 		static void add_wrapper_call_back(std::function<void(yim_fipackfile& rpf_wrapper, std::filesystem::path path)> cb);
 
 		static void traverse_rpf_file(const std::u8string& path, int depth = 0);
-		static void for_each_fipackfile();
+		static void for_each_fipackfile(const rpf_filter& filter = {});
+
+		// reads the RPF header straight from disk without mounting it, nullopt if it isn't an RPF7 archive
+		static std::optional<rpf_fingerprint> fingerprint(const std::filesystem::path& rpf_path);
 
 		std::vector<std::filesystem::path> get_file_paths(std::string parent = {});
 
 		const char* get_name();
 
 		void read_file(const std::filesystem::path& path, file_contents_callback&& cb);
+		// returns an empty buffer if the file couldn't be opened
+		std::vector<uint8_t> read_file(const std::filesystem::path& path);
 
 		void read_xml_file(const std::filesystem::path& path, std::function<void(pugi::xml_document& doc)> cb);
 	};
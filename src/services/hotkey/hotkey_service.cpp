@@ -145,9 +145,11 @@ namespace big
 			{
 				if (auto& hotkey = it->second; hotkey.can_exec())
 				{
-					g_fiber_pool->queue_job([&hotkey] {
-						hotkey.exec();
-					});
+					g_fiber_pool->queue_job(
+					    [&hotkey] {
+						    hotkey.exec();
+					    },
+					    fiber_job_priority::HIGH);
 				}
 			}
 		}
@@ -13,7 +13,7 @@ namespace big
 		Player player  = self::id;
 		Ped player_ped = self::ped;
 		weaponloadout_json weapon_json{};
-		for (const auto& [name, weapon] : g_gta_data_service.weapons())
+		for (const auto& weapon : g_gta_data_service.weapons())
 		{
 			Hash weapon_hash = weapon.m_hash;
 			if (weapon_hash != WEAPON_UNARMED && WEAPON::HAS_PED_GOT_WEAPON(player_ped, weapon_hash, FALSE))
@@ -0,0 +1,244 @@
+#include "player_database_journal.hpp"
+
+#include "thread_pool.hpp"
+
+namespace big
+{
+	// small journals aren't worth rewriting the snapshot for
+	constexpr size_t MIN_COMPACT_SIZE = 64 * 1024;
+
+	player_database_journal::player_database_journal(std::filesystem::path snapshot_path, std::filesystem::path journal_path) :
+	    m_snapshot_path(std::move(snapshot_path)),
+	    m_journal_path(std::move(journal_path))
+	{
+	}
+
+	player_database_journal::~player_database_journal()
+	{
+		flush();
+	}
+
+	std::unordered_map<uint64_t, nlohmann::json> player_database_journal::load()
+	{
+		std::unique_lock lock(m_write_lock);
+
+		m_players.clear();
+		m_journal.close();
+		m_snapshot_size = 0;
+		m_journal_size  = 0;
+
+		if (std::filesystem::exists(m_snapshot_path))
+		{
+			try
+			{
+				std::ifstream file_stream(m_snapshot_path, std::ios::binary);
+
+				nlohmann::json json;
+				file_stream >> json;
+
+				for (auto& [key, value] : json.items())
+					m_players[std::stoull(key)] = std::move(value);
+
+				std::error_code ec;
+				m_snapshot_size = std::filesystem::file_size(m_snapshot_path, ec);
+			}
+			catch (std::exception& e)
+			{
+				LOG(WARNING) << "Failed to load player database file. " << e.what();
+			}
+		}
+
+		size_t replayed = 0;
+		size_t damaged  = 0;
+		if (std::ifstream journal(m_journal_path, std::ios::binary); journal)
+		{
+			std::string line;
+			while (std::getline(journal, line))
+			{
+				if (line.empty())
+					continue;
+
+				// a crash mid write leaves a torn entry behind, it was never complete so it can be skipped
+				const auto entry = nlohmann::json::parse(line, nullptr, false);
+				if (entry.is_discarded() || !entry.is_object() || !entry.contains("rid") || !entry["rid"].is_number_unsigned())
+				{
+					damaged++;
+					continue;
+				}
+
+				const auto rockstar_id = entry["rid"].get<uint64_t>();
+				if (const auto player = entry.find("player"); player != entry.end() && !player->is_null())
+					m_players[rockstar_id] = *player;
+				else
+					m_players.erase(rockstar_id);
+
+				replayed++;
+			}
+		}
+		if (damaged)
+			LOG(WARNING) << "Skipped " << damaged << " damaged entries in the player database journal.";
+
+		// fold the journal into the snapshot right away
+		if ((replayed || damaged) && compact())
+			return m_players;
+
+		m_journal.open(m_journal_path, std::ios::binary | std::ios::app);
+		// terminate a torn entry so the next one doesn't get glued to it
+		if (damaged)
+			m_journal << '\n';
+
+		return m_players;
+	}
+
+	void player_database_journal::put(uint64_t rockstar_id, nlohmann::json player)
+	{
+		std::unique_lock lock(m_queue_lock);
+		m_queue.push_back({rockstar_id, std::move(player)});
+		queue(lock);
+	}
+
+	void player_database_journal::remove(uint64_t rockstar_id)
+	{
+		std::unique_lock lock(m_queue_lock);
+		m_queue.push_back({rockstar_id, std::nullopt});
+		queue(lock);
+	}
+
+	void player_database_journal::reset(std::unordered_map<uint64_t, nlohmann::json> players)
+	{
+		std::unique_lock lock(m_queue_lock);
+		// anything queued before is replaced anyway
+		m_queue.clear();
+		m_queued_reset = std::move(players);
+		queue(lock);
+	}
+
+	void player_database_journal::flush()
+	{
+		write_queued();
+	}
+
+	void player_database_journal::queue(std::unique_lock<std::mutex>& lock)
+	{
+		if (m_write_scheduled)
+			return;
+		m_write_scheduled = true;
+		lock.unlock();
+
+		g_thread_pool->push([this] {
+			{
+				std::unique_lock lock(m_queue_lock);
+				m_write_scheduled = false;
+			}
+			write_queued();
+		});
+	}
+
+	void player_database_journal::write_queued()
+	{
+		std::unique_lock write_lock(m_write_lock);
+
+		std::vector<change> changes;
+		std::optional<std::unordered_map<uint64_t, nlohmann::json>> reset;
+		{
+			std::unique_lock lock(m_queue_lock);
+			changes = std::move(m_queue);
+			reset   = std::move(m_queued_reset);
+			m_queue.clear();
+			m_queued_reset.reset();
+		}
+
+		if (reset)
+		{
+			m_players = std::move(*reset);
+			if (!compact())
+				LOG(WARNING) << "Failed to rewrite the player database.";
+		}
+
+		if (changes.empty())
+			return;
+
+		// only the last change to a player needs to hit the disk
+		std::unordered_map<uint64_t, size_t> latest;
+		for (size_t i = 0; i < changes.size(); i++)
+			latest[changes[i].m_rockstar_id] = i;
+
+		std::vector<change> coalesced;
+		coalesced.reserve(latest.size());
+		for (size_t i = 0; i < changes.size(); i++)
+			if (latest[changes[i].m_rockstar_id] == i)
+				coalesced.push_back(std::move(changes[i]));
+
+		if (!append(coalesced))
+			LOG(WARNING) << "Failed to write to the player database journal.";
+
+		for (auto& change : coalesced)
+		{
+			if (change.m_player)
+				m_players[change.m_rockstar_id] = std::move(*change.m_player);
+			else
+				m_players.erase(change.m_rockstar_id);
+		}
+
+		if (m_journal_size > std::max(m_snapshot_size, MIN_COMPACT_SIZE) && !compact())
+			LOG(WARNING) << "Failed to compact the player database journal.";
+	}
+
+	bool player_database_journal::append(const std::vector<change>& changes)
+	{
+		if (!m_journal.is_open())
+			m_journal.open(m_journal_path, std::ios::binary | std::ios::app);
+
+		std::string data;
+		for (const auto& change : changes)
+		{
+			nlohmann::json entry;
+			entry["rid"]    = change.m_rockstar_id;
+			entry["player"] = change.m_player ? *change.m_player : nlohmann::json(nullptr);
+
+			data += entry.dump();
+			data += '\n';
+		}
+
+		// one write per batch, a crash can only tear the last entry
+		m_journal.write(data.data(), data.size());
+		m_journal.flush();
+		m_journal_size += data.size();
+
+		return m_journal.good();
+	}
+
+	bool player_database_journal::compact()
+	{
+		nlohmann::json json = nlohmann::json::object();
+		for (const auto& [rockstar_id, player] : m_players)
+			json[std::to_string(rockstar_id)] = player;
+		const auto data = json.dump();
+
+		auto temp_path = m_snapshot_path;
+		temp_path += ".tmp";
+		{
+			std::ofstream file_stream(temp_path, std::ios::binary | std::ios::trunc);
+			file_stream.write(data.data(), data.size());
+			file_stream.flush();
+			if (!file_stream)
+				return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temp_path, m_snapshot_path, ec);
+		if (ec)
+		{
+			LOG(WARNING) << "Failed to replace player database file: " << ec.message();
+			return false;
+		}
+		m_snapshot_size = data.size();
+
+		// the snapshot has everything now, if this doesn't happen the journal just gets replayed on top of it again
+		m_journal.close();
+		m_journal.open(m_journal_path, std::ios::binary | std::ios::trunc);
+		m_journal_size = 0;
+
+		return true;
+	}
+}
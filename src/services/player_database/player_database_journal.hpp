@@ -0,0 +1,66 @@
+#pragma once
+
+namespace big
+{
+	/**
+	 * @brief Storage behind the player database.
+	 *
+	 * Changes get appended to a journal next to the snapshot instead of rewriting every player each time,
+	 * the snapshot is only rewritten once the journal has grown larger than it.
+	 * Writes happen on the thread pool, changes queued while a write is running are coalesced into the next one.
+	 *
+	 * Every journal entry holds the full player, so replaying an entry that already made it into the snapshot is harmless.
+	 * That covers crashing between the snapshot being replaced and the journal being truncated,
+	 * a torn entry at the end of the journal is dropped when loading.
+	 */
+	class player_database_journal final
+	{
+	public:
+		player_database_journal(std::filesystem::path snapshot_path, std::filesystem::path journal_path);
+		~player_database_journal();
+
+		player_database_journal(const player_database_journal&)            = delete;
+		player_database_journal& operator=(const player_database_journal&) = delete;
+
+		// reads the snapshot and replays the journal on top of it, call this before queueing anything
+		std::unordered_map<uint64_t, nlohmann::json> load();
+
+		void put(uint64_t rockstar_id, nlohmann::json player);
+		void remove(uint64_t rockstar_id);
+		// drops everything on disk and stores players instead
+		void reset(std::unordered_map<uint64_t, nlohmann::json> players);
+
+		// writes everything queued on the calling thread
+		void flush();
+
+	private:
+		struct change
+		{
+			uint64_t m_rockstar_id;
+			// nullopt removes the player
+			std::optional<nlohmann::json> m_player;
+		};
+
+		void queue(std::unique_lock<std::mutex>& lock);
+		void write_queued();
+		bool append(const std::vector<change>& changes);
+		bool compact();
+
+	private:
+		const std::filesystem::path m_snapshot_path;
+		const std::filesystem::path m_journal_path;
+
+		std::mutex m_queue_lock;
+		std::vector<change> m_queue;
+		std::optional<std::unordered_map<uint64_t, nlohmann::json>> m_queued_reset;
+		bool m_write_scheduled = false;
+
+		// everything below is only touched while holding this
+		std::mutex m_write_lock;
+		// mirror of what is on disk, compaction writes this out without touching the service
+		std::unordered_map<uint64_t, nlohmann::json> m_players;
+		std::ofstream m_journal;
+		size_t m_journal_size  = 0;
+		size_t m_snapshot_size = 0;
+	};
+}
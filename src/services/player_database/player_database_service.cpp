@@ -12,6 +12,54 @@ namespace big
 	bool_command g_player_db_auto_update_online_states("player_db_auto_update_states", "AUTO_UPDATE_STATES", "AUTO_UPDATE_STATES_DESC",
 	    g.player_db.update_player_online_states);
 
+	struct player_database_service::presence_query
+	{
+		static constexpr size_t MAX_PLAYERS  = 100;
+		static constexpr int ATTRIBUTE_COUNT = 9;
+
+		rage::rlScTaskStatus m_status{};
+		size_t m_count = 0;
+		std::vector<rage::rlScHandle> m_handles;
+		rage::rlQueryPresenceAttributesContext m_contexts[MAX_PLAYERS][ATTRIBUTE_COUNT]{};
+		rage::rlQueryPresenceAttributesContext* m_contexts_per_player[MAX_PLAYERS]{};
+
+		bool start(const rage::rlScHandle* handles, size_t count)
+		{
+			m_status = {};
+			m_count  = count;
+			m_handles.assign(handles, handles + count);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				auto contexts = m_contexts[i];
+				std::fill_n(contexts, ATTRIBUTE_COUNT, rage::rlQueryPresenceAttributesContext{});
+
+				contexts[0].m_presence_attibute_type = 1;
+				strcpy(contexts[0].m_presence_attribute_key, "gstype");
+				contexts[0].m_presence_attribute_int_value = -1;
+				contexts[1].m_presence_attibute_type       = 3;
+				strcpy(contexts[1].m_presence_attribute_key, "gsinfo");
+				contexts[2].m_presence_attibute_type = 1;
+				strcpy(contexts[2].m_presence_attribute_key, "sctv");
+				contexts[3].m_presence_attibute_type = 1;
+				strcpy(contexts[3].m_presence_attribute_key, "gshost");
+				contexts[4].m_presence_attibute_type = 3;
+				strcpy(contexts[4].m_presence_attribute_key, "trinfo");
+				contexts[5].m_presence_attibute_type = 1;
+				strcpy(contexts[5].m_presence_attribute_key, "trhost");
+				contexts[6].m_presence_attibute_type = 3;
+				strcpy(contexts[6].m_presence_attribute_key, "mp_mis_str");
+				contexts[7].m_presence_attibute_type = 3;
+				strcpy(contexts[7].m_presence_attribute_key, "mp_mis_id");
+				contexts[8].m_presence_attibute_type = 1;
+				strcpy(contexts[8].m_presence_attribute_key, "mp_curr_gamemode");
+				m_contexts_per_player[i] = contexts;
+			}
+
+			return g_pointers->m_sc.m_start_get_presence_attributes(0, m_handles.data(), static_cast<int>(count), m_contexts_per_player, ATTRIBUTE_COUNT, &m_status);
+		}
+	};
+
 	const char* player_database_service::get_name_by_content_id(const std::string& content_id)
 	{
 		if (NETWORK::UGC_QUERY_BY_CONTENT_ID(content_id.c_str(), false, "gta5mission"))
@@ -61,17 +109,25 @@ namespace big
 		const char* old_game_mode_str = get_game_mode_str(old_game_mode);
 		const char* new_game_mode_str = get_game_mode_str(new_game_mode);
 		auto player                   = g_player_database_service->get_player_by_rockstar_id(rid);
+		if (!player)
+			return;
+
+		std::string name;
+		{
+			std::lock_guard lock(g_player_database_service->m_lock);
+			name = player->name;
+		}
 
 		if (new_game_mode == GameMode::None && old_game_mode != GameMode::None && old_game_mode_str != "None")
 		{
-			g_notification_service.push("Player DB", std::format("{} is no longer in a {}", player->name, old_game_mode_str));
+			g_notification_service.push("Player DB", std::format("{} is no longer in a {}", name, old_game_mode_str));
 			return;
 		}
 
 		if (!can_fetch_name(new_game_mode))
 		{
 			if (new_game_mode_str != "None")
-				g_notification_service.push("Player DB", std::format("{} is now in a {}", player->name, new_game_mode_str));
+				g_notification_service.push("Player DB", std::format("{} is now in a {}", name, new_game_mode_str));
 
 			return;
 		}
@@ -83,11 +139,13 @@ namespace big
 
 		if (mission_name.empty())
 		{
-			g_notification_service.push("Player DB", std::format("{} is now in a {}", player->name, new_game_mode_str));
+			g_notification_service.push("Player DB", std::format("{} is now in a {}", name, new_game_mode_str));
 			return;
 		}
 
-		g_notification_service.push("Player DB", std::format("{} has joined the {} \"{}\"", player->name, new_game_mode_str, mission_name));
+		g_notification_service.push("Player DB", std::format("{} has joined the {} \"{}\"", name, new_game_mode_str, mission_name));
+
+		std::lock_guard lock(g_player_database_service->m_lock);
 		player->game_mode_name = mission_name;
 	}
 
@@ -99,12 +157,15 @@ namespace big
 		int current_preference_level = 0;
 		rage::rlSessionInfo preferred_session{};
 
-		for (auto& player : m_players)
 		{
-			if (player.second->join_redirect && is_joinable_session(player.second->session_type, player.second->game_mode))
+			std::lock_guard lock(m_lock);
+			for (auto& player : m_players)
 			{
-				current_preference_level = player.second->join_redirect_preference;
-				preferred_session        = player.second->redirect_info;
+				if (player.second->join_redirect && is_joinable_session(player.second->session_type, player.second->game_mode))
+				{
+					current_preference_level = player.second->join_redirect_preference;
+					preferred_session        = player.second->redirect_info;
+				}
 			}
 		}
 
@@ -134,6 +195,7 @@ namespace big
 	}
 
 	player_database_service::player_database_service() :
+	    m_journal(g_file_manager.get_project_file("./players.json").get_path(), g_file_manager.get_project_file("./players.journal").get_path()),
 	    m_file_path(g_file_manager.get_project_file("./players.json").get_path())
 	{
 		load();
@@ -150,38 +212,51 @@ namespace big
 
 	void player_database_service::save()
 	{
-		nlohmann::json json;
+		std::unordered_map<uint64_t, nlohmann::json> players;
 
-		for (auto& [rid, player] : m_players)
 		{
-			json[std::to_string(rid)] = player;
+			std::lock_guard lock(m_lock);
+			for (auto& [rid, player] : m_players)
+			{
+				players[rid] = player;
+			}
 		}
 
-		std::ofstream file_stream(m_file_path);
-		file_stream << json;
+		m_journal.reset(std::move(players));
+		invalidate_snapshot();
+	}
+
+	void player_database_service::save(const std::shared_ptr<persistent_player>& player)
+	{
+		bool stored = false;
+		{
+			std::lock_guard lock(m_lock);
+			// the journal is keyed like m_players, fall back to a full save if the rid was edited without moving the entry
+			if (const auto it = m_players.find(player->rockstar_id); it != m_players.end() && it->second == player)
+			{
+				m_journal.put(player->rockstar_id, *player);
+				stored = true;
+			}
+		}
+
+		// name and flags might have changed
+		if (stored)
+			invalidate_snapshot();
+		else
+			save();
 	}
 
 	void player_database_service::load()
 	{
 		m_selected = nullptr;
-		if (std::filesystem::exists(m_file_path))
 		{
+			std::lock_guard lock(m_lock);
+			m_players.clear();
 			try
 			{
-				std::ifstream file_stream(m_file_path);
-
-				nlohmann::json json;
-				file_stream >> json;
-				file_stream.close();
-
-				for (auto& [key, value] : json.items())
+				for (auto& [rid, value] : m_journal.load())
 				{
-					auto player                = value.get<std::shared_ptr<persistent_player>>();
-					m_players[std::stoll(key)] = player;
-
-					std::string lower = player->name;
-					std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-					m_sorted_players[lower] = player;
+					m_players[rid] = value.get<std::shared_ptr<persistent_player>>();
 				}
 			}
 			catch (std::exception& e)
@@ -189,43 +264,89 @@ namespace big
 				LOG(WARNING) << "Failed to load player database file. " << e.what();
 			}
 		}
+
+		rebuild_snapshot();
 	}
 
-	std::unordered_map<uint64_t, std::shared_ptr<persistent_player>>& player_database_service::get_players()
+	std::shared_ptr<const player_database_snapshot> player_database_service::get_snapshot()
 	{
-		return m_players;
+		return m_snapshot.load();
 	}
 
-	std::map<std::string, std::shared_ptr<persistent_player>>& player_database_service::get_sorted_players()
+	void player_database_service::invalidate_snapshot()
 	{
-		return m_sorted_players;
+		// changes coming in while a rebuild is queued end up in that one
+		if (m_snapshot_scheduled.exchange(true))
+			return;
+
+		g_thread_pool->push([this] {
+			m_snapshot_scheduled = false;
+			rebuild_snapshot();
+		});
 	}
 
-	std::shared_ptr<persistent_player> player_database_service::add_player(std::int64_t rid, const std::string_view name)
+	void player_database_service::rebuild_snapshot()
+	{
+		// keeps an older rebuild from being published over a newer one
+		std::lock_guard snapshot_lock(m_snapshot_lock);
+
+		// the players are edited under m_lock from the GUI and the update loop, so everything indexed is copied while holding it
+		std::vector<player_database_snapshot::entry> players;
+		{
+			std::lock_guard lock(m_lock);
+			players.reserve(m_players.size());
+			for (const auto& player : m_players | std::views::values)
+				players.push_back(player_database_snapshot::make_entry(player));
+		}
+
+		m_snapshot = std::make_shared<const player_database_snapshot>(std::move(players));
+	}
+
+	void player_database_service::update_player(const std::shared_ptr<persistent_player>& player, const std::function<void(persistent_player&)>& edit)
 	{
-		std::string lower = name.data();
-		std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-		if (m_players.contains(rid))
 		{
-			m_sorted_players.erase(lower);
+			std::lock_guard lock(m_lock);
+			edit(*player);
 		}
 
-		auto player    = std::make_shared<persistent_player>(name.data(), rid);
-		m_players[rid] = player;
+		invalidate_snapshot();
+	}
+
+	void player_database_service::set_name(const std::shared_ptr<persistent_player>& player, std::string name)
+	{
+		update_player(player, [&name](persistent_player& player) {
+			player.name = std::move(name);
+		});
+	}
+
+	persistent_player player_database_service::get_player_copy(const std::shared_ptr<persistent_player>& player)
+	{
+		std::lock_guard lock(m_lock);
+		return *player;
+	}
 
-		m_sorted_players[lower] = player;
+	std::shared_ptr<persistent_player> player_database_service::add_player(std::int64_t rid, const std::string_view name)
+	{
+		auto player = std::make_shared<persistent_player>(name.data(), rid);
+		{
+			std::lock_guard lock(m_lock);
+			m_players[rid] = player;
+		}
+		invalidate_snapshot();
 
 		return player;
 	}
 
 	void player_database_service::remove_filtered_players(bool filter_modder, bool filter_trust, bool filter_block_join, bool filter_track_player)
 	{
+		std::unique_lock lock(m_lock);
 		for (auto it = m_players.begin(); it != m_players.end();)
 		{
 			auto player = it->second;
 			if ((filter_modder && player->is_modder) || (filter_trust && player->is_trusted)
 			    || (filter_block_join && player->block_join) || (filter_track_player && player->notify_online))
 			{
+				m_journal.remove(it->first);
 				it = m_players.erase(it);
 			}
 			else
@@ -233,47 +354,48 @@ namespace big
 				++it;
 			}
 		}
+		lock.unlock();
 
-		for (auto it = m_sorted_players.begin(); it != m_sorted_players.end();)
-		{
-			auto player = it->second;
-			if ((filter_modder && player->is_modder) || (filter_trust && player->is_trusted)
-			    || (filter_block_join && player->block_join) || (filter_track_player && player->notify_online))
-			{
-				it = m_sorted_players.erase(it);
-			}
-			else
-			{
-				++it;
-			}
-		}
+		invalidate_snapshot();
 	}
 
 	std::shared_ptr<persistent_player> player_database_service::get_player_by_rockstar_id(uint64_t rockstar_id)
 	{
-		if (m_players.contains(rockstar_id))
-			return m_players[rockstar_id];
+		std::lock_guard lock(m_lock);
+		if (const auto it = m_players.find(rockstar_id); it != m_players.end())
+			return it->second;
 		return nullptr;
 	}
 
 	std::shared_ptr<persistent_player> player_database_service::get_or_create_player(player_ptr player)
 	{
-		if (m_players.contains(player->get_rockstar_id()))
-			return m_players[player->get_rockstar_id()];
+		if (auto entry = get_player_by_rockstar_id(player->get_rockstar_id()))
+			return entry;
 		else
 		{
 			auto player_ptr = add_player(player->get_rockstar_id(), player->get_name());
-			save();
+			save(player_ptr);
 			return player_ptr;
 		}
 	}
 
 	void player_database_service::update_rockstar_id(uint64_t old, uint64_t _new)
 	{
-		auto player  = m_players.extract(old);
-		player.key() = _new;
+		{
+			std::lock_guard lock(m_lock);
+			auto player = m_players.extract(old);
+			if (player.empty())
+				return;
+			player.key()                 = _new;
+			player.mapped()->rockstar_id = _new;
+
+			m_journal.remove(old);
+			m_journal.put(_new, *player.mapped());
 
-		m_players.insert(std::move(player));
+			m_players.insert(std::move(player));
+		}
+
+		invalidate_snapshot();
 	}
 
 	void player_database_service::remove_rockstar_id(uint64_t rockstar_id)
@@ -281,14 +403,25 @@ namespace big
 		if (m_selected && m_selected->rockstar_id == rockstar_id)
 			m_selected = nullptr;
 
-		if (auto it = m_players.find(rockstar_id); it != m_players.end())
 		{
-			std::string lower = it->second->name;
-			std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+			std::lock_guard lock(m_lock);
+			if (!m_players.erase(rockstar_id))
+				return;
+			m_journal.remove(rockstar_id);
+		}
 
-			m_sorted_players.erase(lower);
-			m_players.erase(it);
+		invalidate_snapshot();
+	}
+
+	void player_database_service::remove_all_players()
+	{
+		m_selected = nullptr;
+		{
+			std::lock_guard lock(m_lock);
+			m_players.clear();
 		}
+
+		save();
 	}
 
 	void player_database_service::set_selected(std::shared_ptr<persistent_player> selected)
@@ -323,19 +456,22 @@ namespace big
 				first_time = false;
 			}
 
-			static auto last_update = std::chrono::high_resolution_clock::now() - 45s;
+			static auto last_update = std::chrono::high_resolution_clock::now() - STATE_UPDATE_TICK;
 
 			while (g_running && g.player_db.update_player_online_states)
 			{
 				const auto cur = std::chrono::high_resolution_clock::now();
-				if (cur - last_update > 45s && !updating)
+				// only players that are due get queried, see get_state_update_interval
+				if (cur - last_update > STATE_UPDATE_TICK && !updating)
 				{
 					updating = true;
-					g_fiber_pool->queue_job([this] {
-						update_player_states(true);
-						updating = false;
-						last_update = std::chrono::high_resolution_clock::now();
-					});
+					g_fiber_pool->queue_job(
+					    [this] {
+						    update_player_states(true);
+						    updating    = false;
+						    last_update = std::chrono::high_resolution_clock::now();
+					    },
+					    fiber_job_priority::LOW);
 				}
 
 				std::this_thread::sleep_for(1s);
@@ -343,188 +479,269 @@ namespace big
 		});
 	}
 
-	void player_database_service::update_player_states(bool tracked_only)
+	// everything the notifications are based on, compared as a whole to skip players whose presence didn't change
+	struct presence_state
 	{
-		constexpr auto bucket_size = 100;
+		GSType session_type;
+		int64_t session_id;
+		bool is_spectating;
+		bool is_host_of_session;
+		int64_t transition_session_id;
+		bool is_host_of_transition_session;
+		GameMode game_mode;
+
+		bool operator==(const presence_state&) const = default;
+	};
+
+	std::chrono::seconds player_database_service::get_state_update_interval(const persistent_player& player, std::chrono::steady_clock::time_point now)
+	{
+		if (player.join_redirect || now - player.last_state_change < RECENT_STATE_CHANGE)
+			return FAST_STATE_UPDATE_INTERVAL;
+
+		// the longer someone has been offline the less likely they are to come back any second
+		if (player.session_type == GSType::Invalid)
+			return std::clamp(std::chrono::duration_cast<std::chrono::seconds>(now - player.last_state_change) / 4,
+			    STATE_UPDATE_INTERVAL,
+			    MAX_STATE_UPDATE_INTERVAL);
 
-		std::vector<std::vector<rage::rlScHandle>> gamer_handle_buckets{};
+		return STATE_UPDATE_INTERVAL;
+	}
 
-		size_t i = 0;
-		for (auto& player : m_players)
+	std::unique_ptr<player_database_service::presence_query> player_database_service::acquire_presence_query()
+	{
 		{
-			if (!tracked_only || (player.second->notify_online || player.second->join_redirect))
+			std::lock_guard lock(m_presence_query_lock);
+			if (!m_presence_query_pool.empty())
 			{
-				if (gamer_handle_buckets.size() <= i / bucket_size)
-					gamer_handle_buckets.push_back({});
+				auto query = std::move(m_presence_query_pool.back());
+				m_presence_query_pool.pop_back();
+				return query;
+			}
+		}
 
-				if (player.second->rockstar_id == 0 || ((int64_t)player.second->rockstar_id) < 0)
-					continue;
+		return std::make_unique<presence_query>();
+	}
+
+	void player_database_service::release_presence_query(std::unique_ptr<presence_query> query)
+	{
+		std::lock_guard lock(m_presence_query_lock);
+		m_presence_query_pool.push_back(std::move(query));
+	}
+
+	void player_database_service::update_player_states(bool tracked_only)
+	{
+		const auto now = std::chrono::steady_clock::now();
 
-				gamer_handle_buckets[i / bucket_size].push_back(player.second->rockstar_id);
-				i++;
+		std::vector<rage::rlScHandle> handles;
+		{
+			std::lock_guard lock(m_lock);
+			for (auto& player : m_players)
+			{
+				if (!tracked_only || (player.second->notify_online || player.second->join_redirect))
+				{
+					// a manual refresh asks for everyone, the update loop only for the players that are due
+					if (tracked_only && now < player.second->next_state_update)
+						continue;
+
+					if (player.second->rockstar_id == 0 || ((int64_t)player.second->rockstar_id) < 0)
+						continue;
+
+					handles.push_back(player.second->rockstar_id);
+				}
 			}
 		}
 
-		if (i == 0)
+		if (handles.empty())
 			return;
 
-		for (auto& bucket : gamer_handle_buckets)
+		std::vector<std::unique_ptr<presence_query>> in_flight;
+		size_t next = 0;
+
+		while (next < handles.size() || !in_flight.empty())
 		{
-			rage::rlScTaskStatus status{};
+			while (next < handles.size() && in_flight.size() < MAX_PRESENCE_QUERIES_IN_FLIGHT)
+			{
+				const auto count = std::min(handles.size() - next, presence_query::MAX_PLAYERS);
 
-			// TODO: big sized object on the stack, might be a problem in the future
-			rage::rlQueryPresenceAttributesContext contexts[bucket_size][9]{};
-			rage::rlQueryPresenceAttributesContext* contexts_per_player[bucket_size]{};
+				auto query = acquire_presence_query();
+				if (query->start(handles.data() + next, count))
+				{
+					in_flight.push_back(std::move(query));
+				}
+				else
+				{
+					postpone_state_updates(handles.data() + next, count, std::chrono::steady_clock::now());
+					release_presence_query(std::move(query));
+				}
 
-			for (int i = 0; i < bucket.size(); i++)
-			{
-				contexts[i][0].m_presence_attibute_type = 1;
-				strcpy(contexts[i][0].m_presence_attribute_key, "gstype");
-				contexts[i][0].m_presence_attribute_int_value = -1;
-				contexts[i][1].m_presence_attibute_type       = 3;
-				strcpy(contexts[i][1].m_presence_attribute_key, "gsinfo");
-				contexts[i][2].m_presence_attibute_type = 1;
-				strcpy(contexts[i][2].m_presence_attribute_key, "sctv");
-				contexts[i][3].m_presence_attibute_type = 1;
-				strcpy(contexts[i][3].m_presence_attribute_key, "gshost");
-				contexts[i][4].m_presence_attibute_type = 3;
-				strcpy(contexts[i][4].m_presence_attribute_key, "trinfo");
-				contexts[i][5].m_presence_attibute_type = 1;
-				strcpy(contexts[i][5].m_presence_attribute_key, "trhost");
-				contexts[i][6].m_presence_attibute_type = 3;
-				strcpy(contexts[i][6].m_presence_attribute_key, "mp_mis_str");
-				contexts[i][7].m_presence_attibute_type = 3;
-				strcpy(contexts[i][7].m_presence_attribute_key, "mp_mis_id");
-				contexts[i][8].m_presence_attibute_type = 1;
-				strcpy(contexts[i][8].m_presence_attribute_key, "mp_curr_gamemode");
-				contexts_per_player[i] = contexts[i];
+				next += count;
 			}
 
-			if (g_pointers->m_sc.m_start_get_presence_attributes(0, bucket.data(), bucket.size(), contexts_per_player, 9, &status))
+			if (in_flight.empty())
+				break;
+
+			script::get_current()->yield();
+
+			for (auto it = in_flight.begin(); it != in_flight.end();)
 			{
-				while (status.status == 1)
+				auto& query = **it;
+				if (query.m_status.status == 1)
 				{
-					script::get_current()->yield();
+					++it;
+					continue;
 				}
 
-				if (status.status == 3)
+				if (query.m_status.status == 3)
 				{
-					for (size_t i = 0; i < bucket.size(); ++i)
+					const auto finished = std::chrono::steady_clock::now();
+					bool changed        = false;
 					{
-						if (const auto& it = m_players.find(bucket[i].m_rockstar_id); it != m_players.end())
+						std::lock_guard lock(m_lock);
+						for (size_t i = 0; i < query.m_count; ++i)
 						{
-							rage::rlSessionInfo info{};
-							rage::rlSessionInfo transition_info{};
-							info.m_session_token            = -1;
-							transition_info.m_session_token = -1;
-							GSType gstype           = (GSType)(int)contexts[i][0].m_presence_attribute_int_value;
-							bool is_spectating      = (bool)contexts[i][2].m_presence_attribute_int_value;
-							bool is_host_of_session = (bool)contexts[i][3].m_presence_attribute_int_value;
-							bool is_host_of_transition_session = (bool)contexts[i][5].m_presence_attribute_int_value;
-							GameMode game_mode       = (GameMode)contexts[i][8].m_presence_attribute_int_value;
-							std::string mission_id   = contexts[i][7].m_presence_attribute_string_value;
-							std::string mission_name = contexts[i][6].m_presence_attribute_string_value;
-
-							if (contexts[i][1].m_presence_attribute_string_value[0] == 0
-							    || !g_pointers->m_gta.m_decode_session_info(&info, contexts[i][1].m_presence_attribute_string_value, nullptr))
-								gstype = GSType::Invalid;
-
-							if (can_fetch_name(game_mode) && mission_name.empty() && mission_id.empty())
-								game_mode = GameMode::None;
-
-							if (contexts[i][4].m_presence_attribute_string_value[0] == 0
-							    || !g_pointers->m_gta.m_decode_session_info(&transition_info, contexts[i][4].m_presence_attribute_string_value, nullptr))
-								transition_info.m_session_token = -1;
-
-							if (it->second->session_type != gstype)
-							{
-								handle_session_type_change(*it->second, gstype);
-							}
-							else if (it->second->notify_online && it->second->session_id != info.m_session_token
-							    && g.player_db.notify_on_session_change)
-							{
-								g_notification_service.push("Player DB",
-								    std::format("{} has joined a new session", it->second->name));
-							}
-
-							if (gstype != GSType::Invalid)
-							{
-								if (it->second->notify_online && is_spectating != it->second->is_spectating
-								    && g.player_db.notify_on_spectator_change)
-								{
-									if (is_spectating)
-									{
-										g_notification_service.push("Player DB",
-										    std::format("{} is now spectating", it->second->name));
-									}
-									else
-									{
-										g_notification_service.push("Player DB",
-										    std::format("{} is no longer spectating", it->second->name));
-									}
-								}
-
-								if (it->second->notify_online && is_host_of_session != it->second->is_host_of_session
-								    && g.player_db.notify_on_become_host && is_host_of_session && it->second->session_id == info.m_session_token)
-								{
-									g_notification_service.push("Player DB",
-									    std::format("{} is now the host of their session", it->second->name));
-								}
-
-								if (it->second->notify_online && g.player_db.notify_on_transition_change
-								    && transition_info.m_session_token != -1 && it->second->transition_session_id == -1)
-								{
-									if (is_host_of_transition_session)
-									{
-										g_notification_service.push("Player DB",
-										    std::format("{} has hosted a job lobby", it->second->name));
-									}
-									else
-									{
-										g_notification_service.push("Player DB",
-										    std::format("{} has joined a job lobby", it->second->name));
-									}
-								}
-								else if (it->second->notify_online && g.player_db.notify_on_transition_change
-								    && transition_info.m_session_token == -1 && it->second->transition_session_id != -1)
-								{
-									g_notification_service.push("Player DB",
-									    std::format("{} is no longer in a job lobby", it->second->name));
-								}
-
-								if (it->second->notify_online && g.player_db.notify_on_mission_change
-								    && game_mode != it->second->game_mode)
-								{
-									auto rid           = it->second->rockstar_id;
-									auto old_game_mode = it->second->game_mode;
-									g_fiber_pool->queue_job([rid, old_game_mode, game_mode, mission_id, mission_name] {
-										handle_game_mode_change(rid, old_game_mode, game_mode, mission_id, mission_name);
-									});
-								}
-							}
-
-							if (it->second->join_redirect)
-								it->second->redirect_info = info;
-
-							it->second->session_type                  = gstype;
-							it->second->session_id                    = info.m_session_token;
-							it->second->is_spectating                 = is_spectating;
-							it->second->is_host_of_session            = is_host_of_session;
-							it->second->transition_session_id         = transition_info.m_session_token;
-							it->second->is_host_of_transition_session = is_host_of_transition_session;
-							it->second->game_mode                     = game_mode;
-							it->second->game_mode_id                  = mission_id;
-							it->second->game_mode_name                = mission_name;
+							if (const auto it = m_players.find(query.m_handles[i].m_rockstar_id); it != m_players.end())
+								changed |= apply_presence_attributes(*it->second, query.m_contexts[i], finished);
 						}
 					}
+					// the player list is ordered by online state
+					if (changed)
+						invalidate_snapshot();
 					handle_join_redirect();
 				}
 				else
 				{
 					LOG(WARNING) << "Presence attribute endpoint failed";
+					postpone_state_updates(query.m_handles.data(), query.m_count, std::chrono::steady_clock::now());
+				}
+
+				release_presence_query(std::move(*it));
+				it = in_flight.erase(it);
+			}
+		}
+	}
+
+	void player_database_service::postpone_state_updates(const rage::rlScHandle* handles, size_t count, std::chrono::steady_clock::time_point now)
+	{
+		std::lock_guard lock(m_lock);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (const auto it = m_players.find(handles[i].m_rockstar_id); it != m_players.end())
+				it->second->next_state_update = std::max(it->second->next_state_update, now + STATE_UPDATE_INTERVAL);
+		}
+	}
+
+	bool player_database_service::apply_presence_attributes(persistent_player& player, rage::rlQueryPresenceAttributesContext* contexts, std::chrono::steady_clock::time_point now)
+	{
+		rage::rlSessionInfo info{};
+		rage::rlSessionInfo transition_info{};
+		info.m_session_token               = -1;
+		transition_info.m_session_token    = -1;
+		GSType gstype                      = (GSType)(int)contexts[0].m_presence_attribute_int_value;
+		bool is_spectating                 = (bool)contexts[2].m_presence_attribute_int_value;
+		bool is_host_of_session            = (bool)contexts[3].m_presence_attribute_int_value;
+		bool is_host_of_transition_session = (bool)contexts[5].m_presence_attribute_int_value;
+		GameMode game_mode                 = (GameMode)contexts[8].m_presence_attribute_int_value;
+		std::string mission_id             = contexts[7].m_presence_attribute_string_value;
+		std::string mission_name           = contexts[6].m_presence_attribute_string_value;
+
+		if (contexts[1].m_presence_attribute_string_value[0] == 0
+		    || !g_pointers->m_gta.m_decode_session_info(&info, contexts[1].m_presence_attribute_string_value, nullptr))
+			gstype = GSType::Invalid;
+
+		if (can_fetch_name(game_mode) && mission_name.empty() && mission_id.empty())
+			game_mode = GameMode::None;
+
+		if (contexts[4].m_presence_attribute_string_value[0] == 0
+		    || !g_pointers->m_gta.m_decode_session_info(&transition_info, contexts[4].m_presence_attribute_string_value, nullptr))
+			transition_info.m_session_token = -1;
+
+		if (player.join_redirect)
+			player.redirect_info = info;
+
+		const presence_state old_state{player.session_type, player.session_id, player.is_spectating, player.is_host_of_session, player.transition_session_id, player.is_host_of_transition_session, player.game_mode};
+		const presence_state new_state{gstype, static_cast<int64_t>(info.m_session_token), is_spectating, is_host_of_session, static_cast<int64_t>(transition_info.m_session_token), is_host_of_transition_session, game_mode};
+
+		if (old_state == new_state && player.game_mode_id == mission_id)
+		{
+			player.next_state_update = now + get_state_update_interval(player, now);
+			return false;
+		}
+
+		// the first answer after loading isn't a change, it's just the first thing we know
+		if (player.session_type != GSType::Unknown)
+			player.last_state_change = now;
+
+		if (player.session_type != gstype)
+		{
+			handle_session_type_change(player, gstype);
+		}
+		else if (player.notify_online && player.session_id != info.m_session_token && g.player_db.notify_on_session_change)
+		{
+			g_notification_service.push("Player DB", std::format("{} has joined a new session", player.name));
+		}
+
+		if (gstype != GSType::Invalid)
+		{
+			if (player.notify_online && is_spectating != player.is_spectating && g.player_db.notify_on_spectator_change)
+			{
+				if (is_spectating)
+				{
+					g_notification_service.push("Player DB", std::format("{} is now spectating", player.name));
 				}
+				else
+				{
+					g_notification_service.push("Player DB", std::format("{} is no longer spectating", player.name));
+				}
+			}
+
+			if (player.notify_online && is_host_of_session != player.is_host_of_session && g.player_db.notify_on_become_host
+			    && is_host_of_session && player.session_id == info.m_session_token)
+			{
+				g_notification_service.push("Player DB", std::format("{} is now the host of their session", player.name));
+			}
+
+			if (player.notify_online && g.player_db.notify_on_transition_change && transition_info.m_session_token != -1
+			    && player.transition_session_id == -1)
+			{
+				if (is_host_of_transition_session)
+				{
+					g_notification_service.push("Player DB", std::format("{} has hosted a job lobby", player.name));
+				}
+				else
+				{
+					g_notification_service.push("Player DB", std::format("{} has joined a job lobby", player.name));
+				}
+			}
+			else if (player.notify_online && g.player_db.notify_on_transition_change && transition_info.m_session_token == -1
+			    && player.transition_session_id != -1)
+			{
+				g_notification_service.push("Player DB", std::format("{} is no longer in a job lobby", player.name));
+			}
+
+			if (player.notify_online && g.player_db.notify_on_mission_change && game_mode != player.game_mode)
+			{
+				auto rid           = player.rockstar_id;
+				auto old_game_mode = player.game_mode;
+				g_fiber_pool->queue_job(
+				    [rid, old_game_mode, game_mode, mission_id, mission_name] {
+					    handle_game_mode_change(rid, old_game_mode, game_mode, mission_id, mission_name);
+				    },
+				    fiber_job_priority::LOW);
 			}
 		}
+
+		player.session_type                  = gstype;
+		player.session_id                    = info.m_session_token;
+		player.is_spectating                 = is_spectating;
+		player.is_host_of_session            = is_host_of_session;
+		player.transition_session_id         = transition_info.m_session_token;
+		player.is_host_of_transition_session = is_host_of_transition_session;
+		player.game_mode                     = game_mode;
+		player.game_mode_id                  = mission_id;
+		player.game_mode_name                = mission_name;
+
+		player.next_state_update = now + get_state_update_interval(player, now);
+		return true;
 	}
 
 	bool player_database_service::is_joinable_session(GSType type, GameMode mode)
@@ -1,5 +1,7 @@
 #pragma once
 #include "persistent_player.hpp"
+#include "player_database_journal.hpp"
+#include "player_database_snapshot.hpp"
 #include "services/players/player.hpp"
 
 namespace nlohmann
@@ -24,32 +26,73 @@ namespace big
 {
 	class player_database_service
 	{
+		// guards m_players, never hold it across a yield
+		std::mutex m_lock;
 		std::unordered_map<uint64_t, std::shared_ptr<persistent_player>> m_players;
-		std::map<std::string, std::shared_ptr<persistent_player>> m_sorted_players;
 		std::shared_ptr<persistent_player> m_selected = nullptr;
 
+		std::mutex m_snapshot_lock;
+		std::atomic<std::shared_ptr<const player_database_snapshot>> m_snapshot;
+		std::atomic_bool m_snapshot_scheduled = false;
+		// rebuilds the snapshot on the thread pool, readers keep the old one until then
+		void invalidate_snapshot();
+		void rebuild_snapshot();
+
 		void handle_session_type_change(persistent_player& player, GSType new_session_type);
 		static void handle_game_mode_change(uint64_t rid, GameMode old_game_mode, GameMode new_game_mode, std::string mission_id, std::string mission_name); // run in fiber pool
 		bool join_being_redirected = false;
 		void handle_join_redirect();
 		std::atomic_bool updating = false;
 
+		// how often the update loop looks for players that are due, the interval of each player is chosen by get_state_update_interval
+		static constexpr auto STATE_UPDATE_TICK                = std::chrono::seconds(5);
+		static constexpr auto STATE_UPDATE_INTERVAL            = std::chrono::seconds(45);
+		static constexpr auto FAST_STATE_UPDATE_INTERVAL       = std::chrono::seconds(15);
+		static constexpr auto MAX_STATE_UPDATE_INTERVAL        = std::chrono::seconds(300);
+		static constexpr auto RECENT_STATE_CHANGE              = std::chrono::seconds(120);
+		static constexpr size_t MAX_PRESENCE_QUERIES_IN_FLIGHT = 4;
+
+		// one presence request of up to 100 players, pooled since the contexts are too big for a fiber stack
+		struct presence_query;
+		std::mutex m_presence_query_lock;
+		std::vector<std::unique_ptr<presence_query>> m_presence_query_pool;
+		std::unique_ptr<presence_query> acquire_presence_query();
+		void release_presence_query(std::unique_ptr<presence_query> query);
+
+		static std::chrono::seconds get_state_update_interval(const persistent_player& player, std::chrono::steady_clock::time_point now);
+		// a failed query would otherwise be repeated on every tick, the players are asked for again after the regular interval
+		void postpone_state_updates(const rage::rlScHandle* handles, size_t count, std::chrono::steady_clock::time_point now);
+		// call with m_lock held, returns true if the online state of the player changed
+		bool apply_presence_attributes(persistent_player& player, rage::rlQueryPresenceAttributesContext* contexts, std::chrono::steady_clock::time_point now);
+
+		player_database_journal m_journal;
+
 	public:
 		std::filesystem::path m_file_path;
 		player_database_service();
 		~player_database_service();
 
+		// rewrites every player, use save(player) when only one of them changed
 		void save();
+		void save(const std::shared_ptr<persistent_player>& player);
 		void load();
 
+		// the update loop writes to the players from a fiber, edits from anywhere else have to go through these
+		// they only update the snapshot, call save(player) to store the change
+		void update_player(const std::shared_ptr<persistent_player>& player, const std::function<void(persistent_player&)>& edit);
+		void set_name(const std::shared_ptr<persistent_player>& player, std::string name);
+		// consistent copy for reading fields the update loop writes to
+		persistent_player get_player_copy(const std::shared_ptr<persistent_player>& player);
+
 		std::shared_ptr<persistent_player> add_player(std::int64_t rid, const std::string_view name);
-		std::unordered_map<uint64_t, std::shared_ptr<persistent_player>>& get_players();
-		std::map<std::string, std::shared_ptr<persistent_player>>& get_sorted_players();
+		// lock free read access for the UI and commands, may lag a moment behind changes
+		std::shared_ptr<const player_database_snapshot> get_snapshot();
 		std::shared_ptr<persistent_player> get_player_by_rockstar_id(uint64_t rockstar_id);
 		std::shared_ptr<persistent_player> get_or_create_player(player_ptr player);
 		void remove_filtered_players(bool filter_modder, bool filter_trust, bool filter_block_join, bool filter_track_player);
 		void update_rockstar_id(uint64_t old, uint64_t _new);
 		void remove_rockstar_id(uint64_t rockstar_id);
+		void remove_all_players();
 
 		void set_selected(std::shared_ptr<persistent_player> selected);
 		std::shared_ptr<persistent_player> get_selected();
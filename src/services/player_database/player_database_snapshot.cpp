@@ -0,0 +1,145 @@
+#include "player_database_snapshot.hpp"
+
+#include <bit>
+
+namespace big
+{
+	static uint32_t get_trigram(std::string_view str, size_t pos)
+	{
+		return static_cast<uint8_t>(str[pos]) | static_cast<uint8_t>(str[pos + 1]) << 8 | static_cast<uint8_t>(str[pos + 2]) << 16;
+	}
+
+	static bool test_bit(const std::vector<uint64_t>& bits, uint32_t index)
+	{
+		return bits[index / 64] & (1ull << (index % 64));
+	}
+
+	player_database_snapshot::entry player_database_snapshot::make_entry(std::shared_ptr<persistent_player> player)
+	{
+		uint32_t flags = 0;
+		if (player->is_modder)
+			flags |= static_cast<uint32_t>(flag::MODDER);
+		if (player->is_trusted)
+			flags |= static_cast<uint32_t>(flag::TRUSTED);
+		if (player->block_join)
+			flags |= static_cast<uint32_t>(flag::BLOCK_JOIN);
+		if (player->notify_online)
+			flags |= static_cast<uint32_t>(flag::NOTIFY_ONLINE);
+
+		entry result{nullptr, player->name, player->rockstar_id, flags, player->session_type, player->game_mode};
+		result.m_player = std::move(player);
+		return result;
+	}
+
+	player_database_snapshot::player_database_snapshot(std::vector<entry> players)
+	{
+		std::vector<std::string> lower_names;
+		lower_names.reserve(players.size());
+		for (const auto& player : players)
+			lower_names.push_back(to_lower(player.m_name));
+
+		std::vector<uint32_t> order(players.size());
+		for (uint32_t i = 0; i < order.size(); i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			if (const auto cmp = lower_names[a].compare(lower_names[b]); cmp != 0)
+				return cmp < 0;
+			return players[a].m_rockstar_id < players[b].m_rockstar_id;
+		});
+
+		m_players.reserve(players.size());
+		m_lower_names.reserve(players.size());
+		for (const auto i : order)
+		{
+			m_players.push_back(std::move(players[i]));
+			m_lower_names.push_back(std::move(lower_names[i]));
+		}
+
+		const auto words = (m_players.size() + 63) / 64;
+		for (auto& bits : m_flags)
+			bits.resize(words);
+
+		for (uint32_t i = 0; i < m_players.size(); i++)
+		{
+			const auto& name = m_lower_names[i];
+			for (size_t pos = 0; pos + 3 <= name.size(); pos++)
+			{
+				// indices only ever grow, so a repeated trigram within one name is always at the back
+				auto& postings = m_trigrams[get_trigram(name, pos)];
+				if (postings.empty() || postings.back() != i)
+					postings.push_back(i);
+			}
+
+			for (size_t flag = 0; flag < FLAG_COUNT; flag++)
+				if (m_players[i].m_flags & (1u << flag))
+					m_flags[flag][i / 64] |= 1ull << (i % 64);
+		}
+	}
+
+	std::vector<uint32_t> player_database_snapshot::search(std::string_view lower_search, uint32_t required_flags) const
+	{
+		const auto words = (m_players.size() + 63) / 64;
+
+		std::vector<uint64_t> candidates(words, ~0ull);
+		if (m_players.size() % 64)
+			candidates.back() = (1ull << (m_players.size() % 64)) - 1;
+
+		for (size_t flag = 0; flag < FLAG_COUNT; flag++)
+			if (required_flags & (1u << flag))
+				for (size_t word = 0; word < words; word++)
+					candidates[word] &= m_flags[flag][word];
+
+		std::vector<uint32_t> result;
+
+		if (lower_search.size() >= 3)
+		{
+			// walk the rarest trigram of the search, sharing every trigram doesn't make it a substring so the name still gets checked
+			const std::vector<uint32_t>* postings = nullptr;
+			for (size_t pos = 0; pos + 3 <= lower_search.size(); pos++)
+			{
+				const auto it = m_trigrams.find(get_trigram(lower_search, pos));
+				if (it == m_trigrams.end())
+					return result;
+
+				if (!postings || it->second.size() < postings->size())
+					postings = &it->second;
+			}
+
+			for (const auto index : *postings)
+				if (test_bit(candidates, index) && m_lower_names[index].find(lower_search) != std::string::npos)
+					result.push_back(index);
+
+			return result;
+		}
+
+		for (size_t word = 0; word < words; word++)
+		{
+			for (auto bits = candidates[word]; bits; bits &= bits - 1)
+			{
+				const auto index = static_cast<uint32_t>(word * 64 + std::countr_zero(bits));
+				if (lower_search.empty() || m_lower_names[index].find(lower_search) != std::string::npos)
+					result.push_back(index);
+			}
+		}
+
+		return result;
+	}
+
+	const player_database_snapshot::entry* player_database_snapshot::get_player_by_name(std::string_view lower_name) const
+	{
+		const auto it = std::lower_bound(m_lower_names.begin(), m_lower_names.end(), lower_name);
+		if (it == m_lower_names.end() || *it != lower_name)
+			return nullptr;
+
+		return &m_players[it - m_lower_names.begin()];
+	}
+
+	std::string player_database_snapshot::to_lower(std::string_view name)
+	{
+		std::string lower(name);
+		std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {
+			return static_cast<char>(std::tolower(c));
+		});
+		return lower;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "persistent_player.hpp"
+
+namespace big
+{
+	/**
+	 * @brief Immutable, searchable view of the player database.
+	 *
+	 * The service builds a new one after players were added, removed, saved or changed their online state and swaps it in,
+	 * readers keep using the one they got without ever locking the service.
+	 * Everything readers look at is copied out of the players while the service is locked, the players themselves keep
+	 * changing underneath and must only be touched through the service.
+	 * Players are ordered by lower cased name, names are indexed by trigram and the flags used for filtering are kept as bitsets.
+	 */
+	class player_database_snapshot final
+	{
+	public:
+		enum class flag : uint32_t
+		{
+			MODDER        = 1 << 0,
+			TRUSTED       = 1 << 1,
+			BLOCK_JOIN    = 1 << 2,
+			NOTIFY_ONLINE = 1 << 3
+		};
+
+		struct entry
+		{
+			std::shared_ptr<persistent_player> m_player;
+			std::string m_name;
+			uint64_t m_rockstar_id;
+			// bitmask of flag
+			uint32_t m_flags;
+			GSType m_session_type;
+			GameMode m_game_mode;
+		};
+
+		explicit player_database_snapshot(std::vector<entry> players);
+
+		// copies what the snapshot needs from player, the caller has to hold the lock guarding it
+		static entry make_entry(std::shared_ptr<persistent_player> player);
+
+		size_t size() const
+		{
+			return m_players.size();
+		}
+
+		const entry& get(uint32_t index) const
+		{
+			return m_players[index];
+		}
+
+		const std::string& get_lower_name(uint32_t index) const
+		{
+			return m_lower_names[index];
+		}
+
+		/**
+		 * @brief Finds the players whose name contains lower_search and that have every flag in required_flags set.
+		 *
+		 * @return Indices of the matches in name order.
+		 */
+		std::vector<uint32_t> search(std::string_view lower_search, uint32_t required_flags = 0) const;
+
+		// nullptr if no player has that name
+		const entry* get_player_by_name(std::string_view lower_name) const;
+
+		static std::string to_lower(std::string_view name);
+
+	private:
+		static constexpr size_t FLAG_COUNT = 4;
+
+		std::vector<entry> m_players;
+		std::vector<std::string> m_lower_names;
+		// sorted indices of the players whose name contains the trigram
+		std::unordered_map<uint32_t, std::vector<uint32_t>> m_trigrams;
+		std::array<std::vector<uint64_t>, FLAG_COUNT> m_flags;
+	};
+}
@@ -3,6 +3,7 @@
 #include "gta_util.hpp"
 #include "network/CNetGamePlayer.hpp"
 #include "services/friends/friends_service.hpp"
+#include "util/string_operations.hpp"
 
 #include <network/Network.hpp>
 #include <network/RemoteGamerInfoMsg.hpp>
@@ -28,6 +29,17 @@ namespace big
 		return get_net_game_player() == nullptr ? "" : m_net_game_player->get_name();
 	}
 
+	std::string_view player::get_lower_name(std::array<char, 64>& buffer) const
+	{
+		// names are at most 16 characters, folding them into the caller's buffer keeps lookups from allocating
+		const std::string_view name = get_name();
+		const auto size             = std::min(name.size(), buffer.size());
+		std::transform(name.begin(), name.begin() + size, buffer.begin(), [](char c) {
+			return string::operations::to_lower(c);
+		});
+		return {buffer.data(), size};
+	}
+
 	rage::rlGamerInfo* player::get_net_data() const
 	{
 		return get_net_game_player() == nullptr ? nullptr : m_net_game_player->get_net_data();
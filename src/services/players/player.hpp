@@ -36,6 +36,8 @@ namespace big
 
 		[[nodiscard]] CVehicle* get_current_vehicle() const;
 		[[nodiscard]] const char* get_name() const;
+		// folds the name into buffer, names can change during a session so it isn't cached
+		[[nodiscard]] std::string_view get_lower_name(std::array<char, 64>& buffer) const;
 		[[nodiscard]] rage::rlGamerInfo* get_net_data() const;
 		[[nodiscard]] int64_t get_rockstar_id() const;
 		[[nodiscard]] CNetGamePlayer* get_net_game_player() const;
@@ -65,12 +67,12 @@ namespace big
 		bool ragdoll_loop    = false;
 		bool rotate_cam_loop = false;
 
-		rate_limiter m_host_migration_rate_limit{2s, 15};
-		rate_limiter m_play_sound_rate_limit{1s, 10};
-		rate_limiter m_play_sound_rate_limit_tse{5s, 2};
-		rate_limiter m_invites_rate_limit{10s, 2};
-		rate_limiter m_radio_request_rate_limit{5s, 2};
-		rate_limiter m_radio_station_change_rate_limit{1s, 3};
+		rate_limiter m_host_migration_rate_limit{2s, 15, rate_limited_event::HOST_MIGRATION};
+		rate_limiter m_play_sound_rate_limit{1s, 10, rate_limited_event::PLAY_SOUND};
+		rate_limiter m_play_sound_rate_limit_tse{5s, 2, rate_limited_event::SCRIPT_SOUND};
+		rate_limiter m_invites_rate_limit{10s, 2, rate_limited_event::SOUND_SPAM};
+		rate_limiter m_radio_request_rate_limit{5s, 2, rate_limited_event::RADIO_REQUEST};
+		rate_limiter m_radio_station_change_rate_limit{1s, 3, rate_limited_event::RADIO_STATION_CHANGE};
 
 		bool block_radio_requests = false;
 		bool received_object_id_request = false;
@@ -2,6 +2,7 @@
 
 #include "gta_util.hpp"
 #include "util/math.hpp"
+#include "util/string_operations.hpp"
 
 
 namespace big
@@ -32,86 +33,163 @@ namespace big
 		m_players_sending_modder_beacons.clear();
 		m_selected_player = m_dummy;
 		m_players.clear();
+		m_players_by_id.fill(nullptr);
+		m_players_by_msg_id.clear();
+		m_players_by_host_token.clear();
+		m_players_by_rockstar_id.clear();
 	}
 
-	player_ptr player_service::get_by_msg_id(uint32_t msg_id) const
+	static std::optional<uint32_t> get_msg_id(const player& plyr)
 	{
-		for (const auto& [_, player] : m_players)
-		{
-			if (auto net_game_player = player->get_net_game_player())
-			{
-				if (net_game_player->m_msg_id == msg_id)
-				{
-					return player;
-				}
-			}
-		}
-		return nullptr;
+		if (auto net_game_player = plyr.get_net_game_player())
+			return net_game_player->m_msg_id;
+		return std::nullopt;
 	}
 
-	player_ptr player_service::get_by_id(uint32_t id) const
+	static std::optional<uint64_t> get_host_token(const player& plyr)
+	{
+		if (auto net_data = plyr.get_net_data())
+			return net_data->m_host_token;
+		return std::nullopt;
+	}
+
+	static std::optional<int64_t> get_rockstar_id(const player& plyr)
+	{
+		if (plyr.get_net_data())
+			return plyr.get_rockstar_id();
+		return std::nullopt;
+	}
+
+	template<typename K, typename F>
+	player_ptr player_service::find_indexed(const std::unordered_map<K, player_ptr>& index, K key, F get_key) const
 	{
-		for (const auto& [_, player] : m_players)
+		if (const auto it = index.find(key); it != index.end() && get_key(*it->second) == key)
+			return it->second;
+
+		for (const auto& player : m_players | std::ranges::views::values)
 		{
-			if (player && player->id() == id)
-			{
+			if (get_key(*player) == key)
 				return player;
-			}
 		}
 		return nullptr;
 	}
 
+	player_ptr player_service::get_by_msg_id(uint32_t msg_id) const
+	{
+		return find_indexed(m_players_by_msg_id, msg_id, get_msg_id);
+	}
+
+	player_ptr player_service::get_by_id(uint32_t id) const
+	{
+		if (id >= m_players_by_id.size())
+			return nullptr;
+		return m_players_by_id[id];
+	}
+
 	player_ptr player_service::get_by_host_token(uint64_t token) const
 	{
-		for (const auto& player : m_players | std::ranges::views::values)
-		{
-			if (auto net_data = player->get_net_data())
-			{
-				if (net_data->m_host_token == token)
-				{
-					return player;
-				}
-			}
-		}
-		return nullptr;
+		return find_indexed(m_players_by_host_token, token, get_host_token);
 	}
 
-		player_ptr player_service::get_by_name(std::string_view name) const
+	player_ptr player_service::get_by_rockstar_id(int64_t rockstar_id) const
 	{
-		std::string self_name  = g_player_service->get_self()->get_name();
-		std::string name_lower = name.data();
-		std::transform(self_name.begin(), self_name.end(), self_name.begin(), ::tolower);
-		std::transform(name_lower.begin(), name_lower.end(), name_lower.begin(), ::tolower);
+		return find_indexed(m_players_by_rockstar_id, rockstar_id, get_rockstar_id);
+	}
 
+	player_ptr player_service::get_by_name(std::string_view name) const
+	{
+		std::array<char, 64> buffer;
 		for (auto& [_, player] : m_players)
 		{
-			std::string player_name = player->get_name();
-			std::transform(player_name.begin(), player_name.end(), player_name.begin(), ::tolower);
-			if (player_name == name_lower)
+			if (string::operations::iequals(player->get_lower_name(buffer), name))
 				return player;
 		}
 		return nullptr;
 	}
 
+	// levenshtein distance ignoring the case of str, too long names are never considered close
+	static size_t get_edit_distance(std::string_view lower, std::string_view str)
+	{
+		constexpr size_t max_length = 63;
+		if (lower.size() > max_length || str.size() > max_length)
+			return std::numeric_limits<size_t>::max();
+
+		std::array<uint8_t, max_length + 1> previous, current;
+		for (size_t j = 0; j <= str.size(); j++)
+			previous[j] = static_cast<uint8_t>(j);
+
+		for (size_t i = 1; i <= lower.size(); i++)
+		{
+			current[0] = static_cast<uint8_t>(i);
+			for (size_t j = 1; j <= str.size(); j++)
+			{
+				const auto cost = lower[i - 1] == string::operations::to_lower(str[j - 1]) ? 0 : 1;
+				current[j]      = static_cast<uint8_t>(std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost}));
+			}
+			std::swap(previous, current);
+		}
+
+		return previous[str.size()];
+	}
+
 	player_ptr player_service::get_by_name_closest(std::string_view guess) const
 	{
-		std::string self_name   = g_player_service->get_self()->get_name();
-		std::string lower_guess = guess.data();
-		std::transform(self_name.begin(), self_name.end(), self_name.begin(), ::tolower);
-		std::transform(lower_guess.begin(), lower_guess.end(), lower_guess.begin(), ::tolower);
+		// exact matches win, then prefixes, then the name containing the guess, then names a typo or two away
+		enum class match
+		{
+			PREFIX,
+			SUBSTRING,
+			TYPO,
+			NONE
+		};
 
+		auto best_match   = match::NONE;
+		size_t best_score = std::numeric_limits<size_t>::max();
+		player_ptr best_player;
+
+		// anything shorter is within a typo of too many names to mean any of them
+		constexpr size_t min_typo_guess = 4;
+		const auto max_typos            = std::max<size_t>(1, guess.size() / 3);
+
+		std::array<char, 64> buffer;
 		for (auto& [_, player] : m_players)
 		{
-			std::string player_name = player->get_name();
-			std::transform(player_name.begin(), player_name.end(), player_name.begin(), ::tolower);
+			const auto name = player->get_lower_name(buffer);
+
+			auto player_match = match::NONE;
+			// a guess covering more of a name is the closer one
+			size_t score      = name.size();
 
-			if (player_name.find(lower_guess) != std::string::npos)
+			if (const auto pos = string::operations::ifind(name, guess); pos != std::string_view::npos)
 			{
-				return player;
+				if (name.size() == guess.size())
+					return player;
+
+				player_match = pos == 0 ? match::PREFIX : match::SUBSTRING;
+			}
+			else if (guess.size() >= min_typo_guess)
+			{
+				const auto distance = get_edit_distance(name, guess);
+				if (distance > max_typos)
+					continue;
+
+				player_match = match::TYPO;
+				score        = distance;
+			}
+			else
+			{
+				continue;
+			}
+
+			if (player_match < best_match || (player_match == best_match && score < best_score))
+			{
+				best_match  = player_match;
+				best_score  = score;
+				best_player = player;
 			}
 		}
 
-		return nullptr;
+		return best_player;
 	}
 
 	player_ptr player_service::get_closest(bool exclude_friends) const
@@ -161,26 +239,64 @@ namespace big
 			return;
 
 		auto plyr = std::make_shared<player>(net_game_player);
+
+		// a new player in a slot replaces whoever was there if their leave was missed
+		if (const auto id = net_game_player->m_player_id; id < m_players_by_id.size())
+		{
+			if (auto previous = m_players_by_id[id])
+				remove_player(previous);
+			m_players_by_id[id] = plyr;
+		}
+
+		if (const auto msg_id = get_msg_id(*plyr))
+			m_players_by_msg_id[*msg_id] = plyr;
+		if (const auto host_token = get_host_token(*plyr))
+			m_players_by_host_token[*host_token] = plyr;
+		if (const auto rockstar_id = get_rockstar_id(*plyr))
+			m_players_by_rockstar_id[*rockstar_id] = plyr;
+
 		m_players.insert({plyr->get_name(), std::move(plyr)});
 	}
 
-	void player_service::player_leave(CNetGamePlayer* net_game_player)
+	void player_service::remove_player(const player_ptr& plyr)
 	{
-		if (net_game_player == nullptr)
-			return;
-
-		if (m_selected_player && m_selected_player->equals(net_game_player))
+		if (m_selected_player == plyr)
 			m_selected_player = m_dummy;
 
 		if (auto it = std::find_if(m_players.begin(),
 		        m_players.end(),
-		        [net_game_player](const auto& p) {
-			        return p.second->id() == net_game_player->m_player_id;
+		        [&plyr](const auto& p) {
+			        return p.second == plyr;
 		        });
 		    it != m_players.end())
 		{
 			m_players.erase(it);
 		}
+
+		for (auto& slot : m_players_by_id)
+			if (slot == plyr)
+				slot = nullptr;
+
+		const auto remove = [&plyr](auto& index) {
+			std::erase_if(index, [&plyr](const auto& entry) {
+				return entry.second == plyr;
+			});
+		};
+		remove(m_players_by_msg_id);
+		remove(m_players_by_host_token);
+		remove(m_players_by_rockstar_id);
+	}
+
+	void player_service::player_leave(CNetGamePlayer* net_game_player)
+	{
+		if (net_game_player == nullptr)
+			return;
+
+		if (m_selected_player && m_selected_player->equals(net_game_player))
+			m_selected_player = m_dummy;
+
+		if (auto plyr = get_by_id(net_game_player->m_player_id))
+			remove_player(plyr);
 	}
 
 	void player_service::mark_player_as_sending_modder_beacons(std::uint64_t rid)
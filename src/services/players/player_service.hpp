@@ -15,8 +15,20 @@ namespace big
 
 		player_ptr m_self_ptr;
 
+		// ordered by name, the indices below are what lookups go through
 		players m_players;
 
+		std::array<player_ptr, 32> m_players_by_id;
+		// keys are read when a player joins and checked on every hit, a stale or missing key falls back to a scan
+		// lookups never write to these, they're also made from network hooks and the battleye thread
+		std::unordered_map<uint32_t, player_ptr> m_players_by_msg_id;
+		std::unordered_map<uint64_t, player_ptr> m_players_by_host_token;
+		std::unordered_map<int64_t, player_ptr> m_players_by_rockstar_id;
+
+		template<typename K, typename F>
+		player_ptr find_indexed(const std::unordered_map<K, player_ptr>& index, K key, F get_key) const;
+		void remove_player(const player_ptr& plyr);
+
 		player_ptr m_dummy = std::make_shared<player>(nullptr);
 		player_ptr m_selected_player;
 
@@ -38,6 +50,7 @@ namespace big
 		[[nodiscard]] player_ptr get_by_msg_id(uint32_t msg_id) const;
 		[[nodiscard]] player_ptr get_by_id(uint32_t id) const;
 		[[nodiscard]] player_ptr get_by_host_token(uint64_t token) const;
+		[[nodiscard]] player_ptr get_by_rockstar_id(int64_t rockstar_id) const;
 		[[nodiscard]] player_ptr get_selected() const;
 		[[nodiscard]] player_ptr get_by_name(const std::string_view name) const;
 		[[nodiscard]] player_ptr get_by_name_closest(const std::string_view name) const;
@@ -1,41 +1,175 @@
 #pragma once
+#include "gta/enums.hpp"
 
 namespace big
 {
-	class rate_limiter
+	// events that also have a limit shared by all players, so a flood spread over many senders still gets shed
+	enum class rate_limited_event : uint8_t
 	{
-		uint32_t m_attempts_allowed_in_time_period;
-		std::chrono::milliseconds m_time_period;
-		std::chrono::system_clock::time_point m_last_event_time{};
-		uint32_t m_num_attempts_allowed = 0;
+		NONE,
+		HOST_MIGRATION,
+		PLAY_SOUND,
+		SCRIPT_SOUND,
+		SOUND_SPAM,
+		RADIO_REQUEST,
+		RADIO_STATION_CHANGE,
+		COUNT
+	};
 
+	/**
+	 * @brief GCRA limiter, the token bucket expressed as the time the next event is expected at.
+	 *
+	 * Allows bursts of num_allowed_attempts and refills them evenly over time_period instead of all at once when a fixed window ends.
+	 * All state is a pair of atomics, so it can be used from any thread without locking.
+	 */
+	class rate_limiter
+	{
 	public:
-		rate_limiter(std::chrono::milliseconds time_period, uint32_t num_allowed_attempts) :
-		    m_attempts_allowed_in_time_period(num_allowed_attempts),
-		    m_time_period(time_period)
+		using clock = std::chrono::steady_clock;
+
+		rate_limiter(std::chrono::milliseconds time_period, uint32_t num_allowed_attempts, rate_limited_event event = rate_limited_event::NONE) :
+		    m_time_period(std::chrono::duration_cast<clock::duration>(time_period).count()),
+		    m_emission_interval(m_time_period / std::max<uint32_t>(num_allowed_attempts, 1)),
+		    m_burst_tolerance(m_time_period - m_emission_interval),
+		    m_event(event)
 		{
 		}
 
-		// Returns true if the rate limit has been exceeded
-		bool process()
-		{
-			if (std::chrono::system_clock::now() - m_last_event_time < m_time_period)
-			{
-				if (++m_num_attempts_allowed > m_attempts_allowed_in_time_period)
-					return true;
-			}
-			else
-			{
-				m_last_event_time      = std::chrono::system_clock::now();
-				m_num_attempts_allowed = 1;
-			}
-			return false;
+		rate_limiter(const rate_limiter& other) :
+		    m_time_period(other.m_time_period),
+		    m_emission_interval(other.m_emission_interval),
+		    m_burst_tolerance(other.m_burst_tolerance),
+		    m_event(other.m_event),
+		    m_theoretical_arrival(other.m_theoretical_arrival.load(std::memory_order_relaxed)),
+		    m_last_exceeded(other.m_last_exceeded.load(std::memory_order_relaxed))
+		{
 		}
 
+		// Returns true if the rate limit has been exceeded
+		bool process(clock::time_point time = clock::now());
+
 		// Check if the rate limit was exceeded by the last process() call. Use this to prevent the player from being flooded with notifications
-		bool exceeded_last_process()
+		// Only true for the first call exceeding the limit after a whole period without any, and never when the event was shed by the shared limit
+		bool exceeded_last_process() const
 		{
-			return (m_num_attempts_allowed - 1) == m_attempts_allowed_in_time_period;
+			return m_exceeded_last_process.load(std::memory_order_relaxed);
 		}
+
+	private:
+		bool try_acquire(int64_t now);
+
+		int64_t m_time_period;
+		int64_t m_emission_interval;
+		int64_t m_burst_tolerance;
+		rate_limited_event m_event;
+
+		std::atomic<int64_t> m_theoretical_arrival = 0;
+		std::atomic<int64_t> m_last_exceeded       = std::numeric_limits<int64_t>::min() / 2;
+		std::atomic_bool m_exceeded_last_process   = false;
 	};
-}
\ No newline at end of file
+
+	class rate_limits
+	{
+	public:
+		struct event_stats
+		{
+			// over the limit of the sender
+			std::atomic<uint64_t> m_dropped = 0;
+			// within the limit of the sender but over the one shared by all players
+			std::atomic<uint64_t> m_shed = 0;
+			std::atomic<uint64_t> m_allowed = 0;
+		};
+
+		rate_limiter& get_limiter(rate_limited_event event)
+		{
+			return m_limiters[static_cast<size_t>(event)];
+		}
+
+		event_stats& get_stats(rate_limited_event event)
+		{
+			return m_stats[static_cast<size_t>(event)];
+		}
+
+		// translation key of the event name
+		static const char* get_name(rate_limited_event event);
+
+	private:
+		static constexpr size_t COUNT = static_cast<size_t>(rate_limited_event::COUNT);
+
+		// Sized so a full session sending at the per player limits in player.hpp still gets through.
+		// What gets shed is traffic beyond that, from senders that rejoin for a fresh limiter or aren't known players at all.
+		std::array<rate_limiter, COUNT> m_limiters{{
+		    {std::chrono::seconds(1), 1},
+		    {std::chrono::seconds(2), 15 * MAX_PLAYERS},
+		    {std::chrono::seconds(1), 10 * MAX_PLAYERS},
+		    {std::chrono::seconds(5), 2 * MAX_PLAYERS},
+		    {std::chrono::seconds(10), 2 * MAX_PLAYERS},
+		    // plus the 5/s receive_net_message allows for radio requests from unknown players
+		    {std::chrono::seconds(5), 2 * MAX_PLAYERS + 5 * 5},
+		    {std::chrono::seconds(1), 3 * MAX_PLAYERS},
+		}};
+		std::array<event_stats, COUNT> m_stats;
+	};
+
+	inline rate_limits g_rate_limits;
+
+	inline bool rate_limiter::try_acquire(int64_t now)
+	{
+		auto theoretical_arrival = m_theoretical_arrival.load(std::memory_order_relaxed);
+		while (true)
+		{
+			const auto arrival = std::max(theoretical_arrival, now);
+			if (arrival - now > m_burst_tolerance)
+				return false;
+
+			if (m_theoretical_arrival.compare_exchange_weak(theoretical_arrival, arrival + m_emission_interval, std::memory_order_relaxed))
+				return true;
+		}
+	}
+
+	inline bool rate_limiter::process(clock::time_point time)
+	{
+		const auto now = time.time_since_epoch().count();
+
+		if (!try_acquire(now))
+		{
+			// only the first drop of a flood gets reported, another one only after a full period without drops
+			const auto last_exceeded = m_last_exceeded.exchange(now, std::memory_order_relaxed);
+			m_exceeded_last_process.store(now - last_exceeded > m_time_period, std::memory_order_relaxed);
+
+			if (m_event != rate_limited_event::NONE)
+				g_rate_limits.get_stats(m_event).m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		m_exceeded_last_process.store(false, std::memory_order_relaxed);
+
+		if (m_event == rate_limited_event::NONE)
+			return false;
+
+		auto& stats = g_rate_limits.get_stats(m_event);
+		if (!g_rate_limits.get_limiter(m_event).try_acquire(now))
+		{
+			stats.m_shed.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		stats.m_allowed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	inline const char* rate_limits::get_name(rate_limited_event event)
+	{
+		switch (event)
+		{
+		case rate_limited_event::HOST_MIGRATION: return "RATE_LIMIT_HOST_MIGRATION";
+		case rate_limited_event::PLAY_SOUND: return "RATE_LIMIT_PLAY_SOUND";
+		case rate_limited_event::SCRIPT_SOUND: return "RATE_LIMIT_SCRIPT_SOUND";
+		case rate_limited_event::SOUND_SPAM: return "RATE_LIMIT_SOUND_SPAM";
+		case rate_limited_event::RADIO_REQUEST: return "RATE_LIMIT_RADIO_REQUEST";
+		case rate_limited_event::RADIO_STATION_CHANGE: return "RATE_LIMIT_RADIO_STATION_CHANGE";
+		}
+
+		return "RATE_LIMIT_NONE";
+	}
+}
@@ -0,0 +1,45 @@
+#include "script_data.hpp"
+
+namespace big
+{
+	script_data::script_data(rage::scrProgram* program) :
+	    m_num_pages(program->get_num_code_pages()),
+	    m_private_pages(m_num_pages),
+	    m_program_pages(nullptr),
+	    m_code_size(program->m_code_size),
+	    m_bytecode(new uint8_t*[m_num_pages]),
+	    m_code_hash(0)
+	{
+		bind(program);
+	}
+
+	script_data::~script_data()
+	{
+		delete[] m_bytecode;
+		m_bytecode = nullptr;
+	}
+
+	void script_data::bind(rage::scrProgram* program)
+	{
+		m_program_pages = program->m_code_blocks;
+
+		for (auto i = 0u; i < m_num_pages; i++)
+			if (!m_private_pages[i])
+				m_bytecode[i] = program->get_code_page(i);
+	}
+
+	uint8_t* script_data::get_writable_code_address(uint32_t index)
+	{
+		const auto page = index >> 14;
+		if (!m_private_pages[page])
+		{
+			const auto page_size = std::min(0x4000u, m_code_size - (page << 14));
+
+			m_private_pages[page] = std::make_unique<uint8_t[]>(page_size);
+			std::memcpy(m_private_pages[page].get(), m_bytecode[page], page_size);
+			m_bytecode[page] = m_private_pages[page].get();
+		}
+
+		return &m_bytecode[page][index & 0x3FFF];
+	}
+}
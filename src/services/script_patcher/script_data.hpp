@@ -1,34 +1,42 @@
 #pragma once
 
+#include <script/scrProgram.hpp>
+
 namespace big
 {
+	/**
+	 * @brief Patched code of a script, handed to the VM in place of the code of the program.
+	 *
+	 * Pages only get copied once a patch writes to them, all others point into the code of the program.
+	 * Those have to be pointed at the new code with bind() every time the script gets loaded again.
+	 */
 	class script_data
 	{
 		uint32_t m_num_pages;
+		std::vector<std::unique_ptr<uint8_t[]>> m_private_pages;
+		// code pages of the program the shared pages currently point into
+		uint8_t** m_program_pages;
 
 	public:
 		uint32_t m_code_size;
 		uint8_t** m_bytecode;
+		// of the code before any patch was applied
+		uint64_t m_code_hash;
 
-		script_data(uint32_t code_size, uint8_t** bytecode, uint32_t num_pages) :
-		    m_code_size(code_size),
-		    m_bytecode(bytecode),
-		    m_num_pages(num_pages)
-		{
-		}
+		explicit script_data(rage::scrProgram* program);
 
 		script_data(const script_data& that)            = delete;
 		script_data& operator=(const script_data& that) = delete;
 
-		~script_data()
-		{
-			for (auto i = 0u; i < m_num_pages; i++)
-			{
-				delete[] m_bytecode[i];
-			}
+		~script_data();
 
-			delete[] m_bytecode;
-			m_bytecode = nullptr;
+		void bind(rage::scrProgram* program);
+		bool is_bound_to(rage::scrProgram* program) const
+		{
+			return program->m_code_blocks == m_program_pages;
 		}
+
+		// copies the page of index on the first write to it
+		uint8_t* get_writable_code_address(uint32_t index);
 	};
-}
\ No newline at end of file
+}
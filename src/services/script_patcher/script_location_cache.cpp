@@ -0,0 +1,158 @@
+#include "script_location_cache.hpp"
+
+#include "util/script_code_index.hpp"
+
+namespace big
+{
+	static bool matches(const uint8_t* const* pages, uint32_t code_size, const memory::pattern& pattern, uint32_t location)
+	{
+		if (uint64_t(location) + pattern.m_bytes.size() > code_size)
+			return false;
+
+		for (uint32_t i = 0; i < pattern.m_bytes.size(); i++)
+		{
+			const auto index = location + i;
+			if (pattern.m_bytes[i].has_value() && pattern.m_bytes[i].value() != pages[index / script_code_index::PAGE_SIZE][index % script_code_index::PAGE_SIZE])
+				return false;
+		}
+
+		return true;
+	}
+
+	script_location_cache::script_location_cache(file cache_file) :
+	    m_cache_file(cache_file, CACHE_FORMAT)
+	{
+		load();
+	}
+
+	void script_location_cache::load()
+	{
+		m_cache_file.load();
+
+		// the code hash already tells whether a location can be reused, so there's no game version to compare against
+		if (!m_cache_file.up_to_date(0) || m_cache_file.data_size() % sizeof(entry))
+		{
+			m_cache_file.free();
+			return;
+		}
+
+		const auto entries = reinterpret_cast<const entry*>(m_cache_file.data());
+		for (size_t i = 0; i < m_cache_file.data_size() / sizeof(entry); i++)
+			m_entries.emplace(get_key(entries[i].m_script, entries[i].m_pattern_hash), entries[i]);
+
+		m_cache_file.free();
+		LOG(VERBOSE) << "Loaded " << m_entries.size() << " script code locations from cache";
+	}
+
+	void script_location_cache::save()
+	{
+		const auto data_size = m_entries.size() * sizeof(entry);
+		auto data            = std::make_unique<uint8_t[]>(data_size);
+
+		auto entries = reinterpret_cast<entry*>(data.get());
+		for (const auto& [key, entry] : m_entries)
+			*entries++ = entry;
+
+		m_cache_file.set_header_version(0);
+		m_cache_file.set_data(std::move(data), data_size);
+		m_cache_file.write();
+		m_cache_file.free();
+	}
+
+	std::vector<std::optional<uint32_t>> script_location_cache::find(rage::joaat_t script, uint64_t code_hash, const uint8_t* const* pages, uint32_t code_size, std::span<const memory::pattern* const> patterns)
+	{
+		std::vector<std::optional<uint32_t>> result(patterns.size());
+		std::vector<uint32_t> pattern_hashes(patterns.size());
+		std::vector<size_t> rescan_indices;
+		std::vector<const memory::pattern*> rescan_patterns;
+
+		{
+			std::lock_guard lock(m_lock);
+
+			for (size_t i = 0; i < patterns.size(); i++)
+			{
+				pattern_hashes[i] = get_pattern_hash(*patterns[i]);
+
+				if (const auto it = m_entries.find(get_key(script, pattern_hashes[i])); it != m_entries.end())
+				{
+					const auto& entry = it->second;
+					if (entry.m_code_hash == code_hash && matches(pages, code_size, *patterns[i], entry.m_location))
+					{
+						result[i] = entry.m_location;
+						continue;
+					}
+				}
+
+				rescan_indices.push_back(i);
+				rescan_patterns.push_back(patterns[i]);
+			}
+		}
+
+		if (rescan_indices.empty())
+			return result;
+
+		LOG(VERBOSE) << (patterns.size() - rescan_indices.size()) << " script code locations still match their cached location, rescanning " << rescan_indices.size();
+
+		const auto scanned = script_code_index(pages, code_size).find(rescan_patterns);
+
+		std::lock_guard lock(m_lock);
+
+		bool changed = false;
+		for (size_t i = 0; i < rescan_indices.size(); i++)
+		{
+			const auto index = rescan_indices[i];
+			result[index]    = scanned[i];
+
+			// patterns that weren't found get scanned for again next time, they may show up with a script update
+			if (scanned[i])
+			{
+				m_entries[get_key(script, pattern_hashes[index])] = {script, pattern_hashes[index], code_hash, *scanned[i], 0};
+				changed = true;
+			}
+		}
+
+		if (changed)
+			save();
+
+		return result;
+	}
+
+	uint64_t script_location_cache::get_code_hash(const uint8_t* const* pages, uint32_t code_size)
+	{
+		constexpr uint64_t prime = 0x100000001B3;
+
+		// FNV-1a over whole words, scripts get updated without a game update so only their code tells whether a location is still valid
+		uint64_t hash = 0xCBF29CE484222325 ^ code_size;
+		for (uint32_t offset = 0; offset < code_size; offset += script_code_index::PAGE_SIZE)
+		{
+			const auto page = pages[offset / script_code_index::PAGE_SIZE];
+			const auto size = std::min(script_code_index::PAGE_SIZE, code_size - offset);
+
+			uint32_t i = 0;
+			for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+			{
+				uint64_t word;
+				std::memcpy(&word, page + i, sizeof(word));
+				hash = (hash ^ word) * prime;
+				hash ^= hash >> 32;
+			}
+
+			for (; i < size; i++)
+				hash = (hash ^ page[i]) * prime;
+		}
+
+		return hash;
+	}
+
+	uint32_t script_location_cache::get_pattern_hash(const memory::pattern& pattern)
+	{
+		uint32_t hash = 0x811C9DC5;
+		for (const auto& byte : pattern.m_bytes)
+		{
+			hash = (hash ^ byte.value_or(0)) * 0x01000193;
+			hash = (hash ^ byte.has_value()) * 0x01000193;
+		}
+
+		return hash;
+	}
+}
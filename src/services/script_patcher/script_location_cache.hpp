@@ -0,0 +1,56 @@
+#pragma once
+#include "memory/pattern.hpp"
+#include "services/gta_data/cache_file.hpp"
+
+#include <span>
+
+namespace big
+{
+	/**
+	 * @brief Remembers where patterns were found in the code of a script across game sessions.
+	 *
+	 * Locations are keyed by script and pattern and only reused while the code of the script hashes the same.
+	 * The pattern doubles as the fingerprint, a reused location still has to match in place or the pattern gets scanned for again.
+	 */
+	class script_location_cache final
+	{
+	public:
+		explicit script_location_cache(file cache_file);
+
+		/**
+		 * @brief Finds the first location of every pattern, scanning only for those without a valid cached location.
+		 *
+		 * @param code_hash get_code_hash() of the code as it was loaded, before anything got patched.
+		 * @return The locations in the order of the patterns, std::nullopt for those that weren't found.
+		 */
+		std::vector<std::optional<uint32_t>> find(rage::joaat_t script, uint64_t code_hash, const uint8_t* const* pages, uint32_t code_size, std::span<const memory::pattern* const> patterns);
+
+		static uint64_t get_code_hash(const uint8_t* const* pages, uint32_t code_size);
+
+	private:
+		// Bump when the layout of the cache data changes
+		static constexpr uint32_t CACHE_FORMAT = 1;
+
+		struct entry
+		{
+			rage::joaat_t m_script;
+			uint32_t m_pattern_hash;
+			uint64_t m_code_hash;
+			uint32_t m_location;
+			uint32_t m_reserved;
+		};
+
+		static uint32_t get_pattern_hash(const memory::pattern& pattern);
+		static uint64_t get_key(rage::joaat_t script, uint32_t pattern_hash)
+		{
+			return uint64_t(script) << 32 | pattern_hash;
+		}
+
+		void load();
+		void save();
+
+		cache_file m_cache_file;
+		std::mutex m_lock;
+		std::unordered_map<uint64_t, entry> m_entries;
+	};
+}
@@ -20,50 +20,45 @@ namespace big
 		return &data->m_bytecode[index >> 14][index & 0x3FFF];
 	}
 
-	const std::optional<uint32_t> script_patch::get_code_location_by_pattern(script_data* data, const memory::pattern& pattern)
+	void script_patch::enable(script_data* data)
 	{
-		uint32_t code_size = data->m_code_size;
-		for (uint32_t i = 0; i < (code_size - pattern.m_bytes.size()); i++)
-		{
-			for (uint32_t j = 0; j < pattern.m_bytes.size(); j++)
-				if (pattern.m_bytes[j].has_value())
-					if (pattern.m_bytes[j].value() != *get_code_address(data, i + j))
-						goto incorrect;
-
-			return i;
-		incorrect:
-			continue;
-		}
+		// a patch may cross into the next page
+		for (size_t i = 0; i < m_patch.size(); i++)
+			*data->get_writable_code_address(m_ip + i) = m_patch[i];
+	}
 
-		return std::nullopt;
+	void script_patch::disable(script_data* data)
+	{
+		for (size_t i = 0; i < m_original.size(); i++)
+			*data->get_writable_code_address(m_ip + i) = m_original[i];
 	}
 
-	void script_patch::enable(script_data* data)
+	void script_patch::resolve(script_data* data, std::optional<uint32_t> location)
 	{
-		std::memcpy(get_code_address(data, m_ip), m_patch.data(), m_patch.size());
+		if (!location.has_value())
+		{
+			LOG(FATAL) << "Failed to find pattern: " << m_name;
+			return;
+		}
+
+		m_ip = location.value() + m_offset;
+
+		m_original.clear();
+		for (int i = 0; i < m_patch.size(); i++)
+			m_original.push_back(*get_code_address(data, m_ip + i));
 	}
 
-	void script_patch::disable(script_data* data)
+	void script_patch::reset()
 	{
-		std::memcpy(get_code_address(data, m_ip), m_original.data(), m_original.size());
+		m_ip = 0;
+		m_original.clear();
 	}
 
 	void script_patch::update(script_data* data)
 	{
+		// resolved by the service while the script is loaded, the shared pages of data may be gone otherwise
 		if (m_ip == 0)
-		{
-			auto result = get_code_location_by_pattern(data, m_pattern);
-			if (!result.has_value())
-			{
-				LOG(FATAL) << "Failed to find pattern: " << m_name;
-				return;
-			}
-
-			m_ip = result.value() + m_offset;
-
-			for (int i = 0; i < m_patch.size(); i++)
-				m_original.push_back(*get_code_address(data, m_ip + i));
-		}
+			return;
 
 		if (!m_bool || *m_bool)
 			enable(data);
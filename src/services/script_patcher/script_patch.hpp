@@ -17,7 +17,6 @@ namespace big
 		int32_t m_ip;
 
 		static uint8_t* get_code_address(script_data* data, uint32_t index);
-		static const std::optional<uint32_t> get_code_location_by_pattern(script_data* data, const memory::pattern& pattern);
 
 	public:
 		void enable(script_data* data);
@@ -33,6 +32,21 @@ namespace big
 			return m_name;
 		}
 
+		inline const memory::pattern& get_pattern()
+		{
+			return m_pattern;
+		}
+
+		inline bool is_resolved()
+		{
+			return m_ip != 0;
+		}
+
+		// location is where the pattern was found in data, the service looks up all patches of a script at once
+		void resolve(script_data* data, std::optional<uint32_t> location);
+		// forgets the location, for when the code of the script changed
+		void reset();
+
 		script_patch(rage::joaat_t script, std::string name, const memory::pattern pattern, int32_t offset, std::vector<uint8_t> patch, bool* enable_bool);
 		void update(script_data* data);
 	};
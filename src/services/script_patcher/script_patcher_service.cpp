@@ -1,5 +1,6 @@
 #include "script_patcher_service.hpp"
 
+#include "file_manager.hpp"
 #include "script_data.hpp"
 #include "script_patch.hpp"
 
@@ -7,7 +8,18 @@
 
 namespace big
 {
-	script_patcher_service::script_patcher_service()
+	// of the code as the game loaded it, patches only ever go to copied pages
+	static uint64_t get_code_hash(rage::scrProgram* program)
+	{
+		std::vector<const uint8_t*> pages(program->get_num_code_pages());
+		for (auto i = 0u; i < pages.size(); i++)
+			pages[i] = program->get_code_page(i);
+
+		return script_location_cache::get_code_hash(pages.data(), program->m_code_size);
+	}
+
+	script_patcher_service::script_patcher_service() :
+	    m_location_cache(g_file_manager.get_project_file("./cache/script_locations.bin"))
 	{
 		g_script_patcher_service = this;
 	}
@@ -21,13 +33,8 @@ namespace big
 
 	script_data* script_patcher_service::get_data_for_script(rage::joaat_t script)
 	{
-		for (auto& p : m_script_data)
-		{
-			if (p.first == script)
-			{
-				return p.second.get();
-			}
-		}
+		if (const auto it = m_script_data.find(script); it != m_script_data.end())
+			return it->second.get();
 
 		return nullptr;
 	}
@@ -43,25 +50,38 @@ namespace big
 		return false;
 	}
 
-	void script_patcher_service::create_data_for_script(rage::scrProgram* program)
+	void script_patcher_service::create_data_for_script(rage::scrProgram* program, uint64_t code_hash)
 	{
-		auto pages = new uint8_t*[program->get_num_code_pages()];
-
-		for (auto i = 0u; i < program->get_num_code_pages(); i++)
-		{
-			pages[i] = new uint8_t[program->get_code_page_size(i)];
-			std::memcpy(pages[i], program->get_code_page(i), program->get_code_page_size(i));
-		}
-
-		m_script_data.emplace(program->m_name_hash, std::make_unique<script_data>(program->m_code_size, pages, program->get_num_code_pages()));
+		auto data         = std::make_unique<script_data>(program);
+		data->m_code_hash = code_hash;
+		m_script_data.emplace(program->m_name_hash, std::move(data));
 	}
 
 	void script_patcher_service::update_all_patches_for_script(rage::joaat_t script)
 	{
 		auto data = get_data_for_script(script);
 
+		// look up every patch added since the last load in one walk over the code instead of one per patch
+		std::vector<script_patch*> unresolved;
+		std::vector<const memory::pattern*> patterns;
 		for (auto& p : m_script_patches)
-			if (p.get_script() == script)
+		{
+			if (p.get_script() == script && !p.is_resolved())
+			{
+				unresolved.push_back(&p);
+				patterns.push_back(&p.get_pattern());
+			}
+		}
+
+		if (!unresolved.empty())
+		{
+			const auto locations = m_location_cache.find(script, data->m_code_hash, data->m_bytecode, data->m_code_size, patterns);
+			for (size_t i = 0; i < unresolved.size(); i++)
+				unresolved[i]->resolve(data, locations[i]);
+		}
+
+		for (auto& p : m_script_patches)
+			if (p.get_script() == script && p.is_resolved())
 				p.update(data);
 	}
 
@@ -90,16 +110,47 @@ namespace big
 		if (!does_script_have_patches(program->m_name_hash))
 			return;
 
-		if (get_data_for_script(program->m_name_hash) == nullptr)
-			create_data_for_script(program);
+		// script updates don't have to change the size, the copied pages and patch locations are only valid for the exact same code
+		const auto code_hash = get_code_hash(program);
+		auto data            = get_data_for_script(program->m_name_hash);
+		if (data && (data->m_code_size != program->m_code_size || data->m_code_hash != code_hash))
+		{
+			LOG(WARNING) << "Code of " << program->m_name << " changed since it was patched, looking up its patches again";
+
+			m_script_data.erase(program->m_name_hash);
+			for (auto& p : m_script_patches)
+				if (p.get_script() == program->m_name_hash)
+					p.reset();
+			data = nullptr;
+		}
+
+		if (data == nullptr)
+			create_data_for_script(program, code_hash);
+		else
+			data->bind(program);
 
 		update_all_patches_for_script(program->m_name_hash);
 	}
 
-	uint8_t** script_patcher_service::get_script_bytecode(rage::joaat_t script)
+	std::vector<std::optional<uint32_t>> script_patcher_service::find_code_locations(rage::scrProgram* program, std::span<const memory::pattern* const> patterns)
+	{
+		std::vector<const uint8_t*> pages(program->get_num_code_pages());
+		for (auto i = 0u; i < pages.size(); i++)
+			pages[i] = program->get_code_page(i);
+
+		return m_location_cache.find(program->m_name_hash, get_code_hash(program), pages.data(), program->m_code_size, patterns);
+	}
+
+	uint8_t** script_patcher_service::get_script_bytecode(rage::scrProgram* program)
 	{
-		if (auto data = get_data_for_script(script))
+		if (auto data = get_data_for_script(program->m_name_hash))
+		{
+			// the code blocks are already ours when the VM is entered again from within a script
+			if (program->m_code_blocks != data->m_bytecode && !data->is_bound_to(program))
+				data->bind(program);
+
 			return data->m_bytecode;
+		}
 
 		return nullptr;
 	}
@@ -109,7 +160,7 @@ namespace big
 		for (auto& p : m_script_patches)
 		{
 			auto data = get_data_for_script(p.get_script());
-			if (data)
+			if (data && p.is_resolved())
 			{
 				p.update(data);
 			}
@@ -1,6 +1,7 @@
 #pragma once
 #include "memory/pattern.hpp"
 #include "script_data.hpp"
+#include "script_location_cache.hpp"
 #include "script_patch.hpp"
 
 #include <script/scrProgram.hpp>
@@ -11,9 +12,10 @@ namespace big
 	{
 		std::list<script_patch> m_script_patches;
 		std::unordered_map<rage::joaat_t, std::unique_ptr<script_data>> m_script_data;
+		script_location_cache m_location_cache;
 		script_data* get_data_for_script(rage::joaat_t script);
 		bool does_script_have_patches(rage::joaat_t script);
-		void create_data_for_script(rage::scrProgram* program);
+		void create_data_for_script(rage::scrProgram* program, uint64_t code_hash);
 
 	public:
 		script_patcher_service();
@@ -22,7 +24,9 @@ namespace big
 		void add_patch(script_patch&& patch);
 		void remove_patch(std::string_view patch_name);
 		void on_script_load(rage::scrProgram* program);
-		uint8_t** get_script_bytecode(rage::joaat_t script);
+		// first location of every pattern in the code of program, reusing the locations found in earlier sessions
+		std::vector<std::optional<uint32_t>> find_code_locations(rage::scrProgram* program, std::span<const memory::pattern* const> patterns);
+		uint8_t** get_script_bytecode(rage::scrProgram* program);
 		void update_all_patches_for_script(rage::joaat_t script);
 		void update();
 	};
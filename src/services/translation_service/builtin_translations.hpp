@@ -0,0 +1,32 @@
+#pragma once
+
+namespace big
+{
+	// English strings for keys that haven't made it into the published language packs yet.
+	// They only fill in keys the loaded packs are missing, an entry can be removed once its key is upstream.
+	inline constexpr std::pair<std::string_view, std::string_view> builtin_translations[] = {
+	    {"VIEW_DEBUG_MISC_FIBER_POOL_QUEUE_DEPTH", "Fiber Pool Queue Depth (High/Normal/Low)"},
+	    {"VIEW_DEBUG_MISC_FIBER_POOL_WAIT_TIME", "Fiber Pool Wait Time"},
+	    {"DEBUG_LOG_TEXT_FILE", "Text Log File"},
+	    {"DEBUG_LOG_BINARY_FILE", "Binary Log File"},
+	    {"DEBUG_LOG_BINARY_FILE_DESC", "Writes cout.ylog, a memory mapped log that is cheaper to write than the text log. Decode it with scripts/decode_binary_log.py. Both log files take effect the next time the menu is injected."},
+	    {"DEBUG_TAB_PROFILER", "Profiler"},
+	    {"VIEW_DEBUG_PROFILER_ENABLE", "Enable Profiler"},
+	    {"VIEW_DEBUG_PROFILER_NAME", "Name"},
+	    {"VIEW_DEBUG_PROFILER_KIND", "Kind"},
+	    {"VIEW_DEBUG_PROFILER_YIELDS", "Yields / Frame"},
+	    {"DEBUG_TAB_RATE_LIMITS", "Rate Limits"},
+	    {"VIEW_DEBUG_RATE_LIMITS_EVENT", "Event"},
+	    {"VIEW_DEBUG_RATE_LIMITS_ALLOWED", "Allowed/s"},
+	    {"VIEW_DEBUG_RATE_LIMITS_DROPPED", "Dropped/s"},
+	    {"VIEW_DEBUG_RATE_LIMITS_SHED", "Shed/s"},
+	    {"VIEW_DEBUG_RATE_LIMITS_DROPPED_TOTAL", "Dropped total"},
+	    {"RATE_LIMIT_NONE", "None"},
+	    {"RATE_LIMIT_HOST_MIGRATION", "Host Migration"},
+	    {"RATE_LIMIT_PLAY_SOUND", "Play Sound"},
+	    {"RATE_LIMIT_SCRIPT_SOUND", "Script Sound"},
+	    {"RATE_LIMIT_SOUND_SPAM", "Sound Spam"},
+	    {"RATE_LIMIT_RADIO_REQUEST", "Radio Request"},
+	    {"RATE_LIMIT_RADIO_STATION_CHANGE", "Radio Station Change"},
+	};
+}
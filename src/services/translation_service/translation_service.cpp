@@ -1,5 +1,6 @@
 #include "translation_service.hpp"
 
+#include "builtin_translations.hpp"
 #include "core/data/block_join_reasons.hpp"
 #include "fiber_pool.hpp"
 #include "file_manager.hpp"
@@ -132,6 +133,11 @@ namespace big
 			m_translations.insert({rage::joaat(key), value.get<std::string>()});
 		}
 
+		for (const auto& [key, value] : builtin_translations)
+		{
+			m_translations.emplace(rage::joaat(key), value);
+		}
+
 		// Don't load selected language if it's the same as default
 		if (m_local_index.selected_language != m_remote_index.default_lang)
 		{
@@ -0,0 +1,99 @@
+#pragma once
+#include <bit>
+#include <span>
+
+namespace big
+{
+#pragma pack(push, 1)
+	struct tunable_save_struct
+	{
+		rage::joaat_t hash;
+		uint32_t offset;
+	};
+#pragma pack(pop)
+
+	/**
+	 * @brief Open addressing table from tunable hash to the global holding it.
+	 *
+	 * Slots are probed linearly from the hash, an offset of 0 marks an empty one since no tunable lives below TUNABLE_BASE_ADDRESS.
+	 * The slots get saved to the cache as they are, so loading it doesn't have to rehash anything.
+	 */
+	class tunable_table final
+	{
+	public:
+		// the first of duplicate hashes wins
+		void build(std::span<const tunable_save_struct> tunables)
+		{
+			m_slots.assign(std::bit_ceil(std::max<size_t>(tunables.size() * 2, 16)), {});
+			m_size = 0;
+
+			for (const auto& tunable : tunables)
+			{
+				auto& slot = m_slots[probe(tunable.hash)];
+				if (slot.offset == 0)
+				{
+					slot = tunable;
+					m_size++;
+				}
+			}
+		}
+
+		// slots as returned by get_slots(), false if they can't be from a table
+		bool load(std::span<const tunable_save_struct> slots)
+		{
+			if (slots.size() < 16 || !std::has_single_bit(slots.size()))
+				return false;
+
+			m_slots.assign(slots.begin(), slots.end());
+			m_size = std::count_if(m_slots.begin(), m_slots.end(), [](const tunable_save_struct& slot) {
+				return slot.offset != 0;
+			});
+
+			// a probe only ends at an empty slot
+			if (m_size * 2 > m_slots.size())
+			{
+				m_slots.clear();
+				m_size = 0;
+				return false;
+			}
+
+			return true;
+		}
+
+		// offset of the global, 0 if the tunable isn't known
+		uint32_t find(rage::joaat_t hash) const
+		{
+			if (m_slots.empty())
+				return 0;
+
+			return m_slots[probe(hash)].offset;
+		}
+
+		size_t size() const
+		{
+			return m_size;
+		}
+
+		std::span<const tunable_save_struct> get_slots() const
+		{
+			return m_slots;
+		}
+
+	private:
+		// slot holding hash, or the empty one ending its probe sequence
+		size_t probe(rage::joaat_t hash) const
+		{
+			const auto mask = m_slots.size() - 1;
+
+			// fibonacci hashing, hashes that only differ in their high bits still start probing apart
+			auto index = static_cast<size_t>((hash * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+			while (m_slots[index].offset != 0 && m_slots[index].hash != hash)
+				index = (index + 1) & mask;
+
+			return index;
+		}
+
+		std::vector<tunable_save_struct> m_slots;
+		size_t m_size = 0;
+	};
+}
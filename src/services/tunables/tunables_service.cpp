@@ -9,10 +9,42 @@
 #include "thread_pool.hpp"
 #include "util/scripts.hpp"
 
+#include <intrin.h>
+
 namespace big
 {
+	// calls on_found(index, junk index) for every global whose value is one of the junk values, four globals at a time
+	template<typename F>
+	static void find_junk_values(const uint64_t* globals, size_t count, uint32_t first_junk_value, uint32_t junk_value_count, F&& on_found)
+	{
+		// unsigned range check through a signed compare, SSE2 has no unsigned one
+		const auto first = _mm_set1_epi32(static_cast<int>(first_junk_value));
+		const auto sign  = _mm_set1_epi32(INT_MIN);
+		const auto limit = _mm_set1_epi32(static_cast<int>(junk_value_count ^ 0x80000000u));
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const auto low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(globals + i));
+			const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(globals + i + 2));
+			// the values are ints, so only the low dword of each global matters
+			const auto values   = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high), _MM_SHUFFLE(2, 0, 2, 0)));
+			const auto in_range = _mm_cmplt_epi32(_mm_xor_si128(_mm_sub_epi32(values, first), sign), limit);
+
+			for (auto mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(in_range))); mask; mask &= mask - 1)
+			{
+				const auto index = i + std::countr_zero(mask);
+				on_found(index, static_cast<uint32_t>(globals[index]) - first_junk_value);
+			}
+		}
+
+		for (; i < count; i++)
+			if (const auto junk_index = static_cast<uint32_t>(globals[i]) - first_junk_value; junk_index < junk_value_count)
+				on_found(i, junk_index);
+	}
+
 	tunables_service::tunables_service() :
-	    m_cache_file(g_file_manager.get_project_file("./cache/tunables.bin"), 1)
+	    m_cache_file(g_file_manager.get_project_file("./cache/tunables.bin"), 2)
 	{
 		g_tunables_service = this;
 	}
@@ -25,18 +57,24 @@ namespace big
 
 	void tunables_service::run_script()
 	{
+		bool checked_cache = false;
+
 		while (true)
 		{
 			script::get_current()->yield();
 
-			m_cache_file.load();
-
-			if (m_cache_file.up_to_date(memory::module("GTA5.exe").timestamp()))
+			if (!checked_cache)
 			{
-				LOG(INFO) << "Loading tunables from cache";
-				m_loading = true;
+				checked_cache = true;
+				m_cache_file.load();
 
-				load();
+				if (m_cache_file.up_to_date(memory::module("GTA5.exe").timestamp()))
+				{
+					LOG(INFO) << "Loading tunables from cache";
+					m_loading = true;
+
+					load();
+				}
 			}
 
 			if (m_initialized || m_loading)
@@ -76,14 +114,7 @@ namespace big
 			{
 				if (SCRIPT::GET_NUMBER_OF_THREADS_RUNNING_THE_SCRIPT_WITH_THIS_HASH("tuneables_processing"_J) == 0)
 				{
-					for (int i = 0; i < m_num_tunables; i++)
-					{
-						auto value = *script_global(TUNABLE_BASE_ADDRESS).at(i).as<int*>();
-						if (auto it = m_junk_values.find(value); it != m_junk_values.end())
-						{
-							m_tunables.emplace(it->second, TUNABLE_BASE_ADDRESS + i);
-						}
-					}
+					find_tunables();
 					memcpy(script_global(TUNABLE_BASE_ADDRESS).as<void*>(), m_tunables_backup.get(), m_num_tunables * 8);
 
 					if (m_tunables.size() == 0)
@@ -102,22 +133,29 @@ namespace big
 		}
 	}
 
-	void tunables_service::save()
+	void tunables_service::find_tunables()
 	{
-		auto data_size = sizeof(uint32_t) + sizeof(tunable_save_struct) * m_tunables.size();
-		auto data      = std::make_unique<uint8_t[]>(data_size);
-		auto data_ptr  = data.get();
+		// the globals tunables_registration wrote to are contiguous, the backup above copies them the same way
+		const auto globals = script_global(TUNABLE_BASE_ADDRESS).as<const uint64_t*>();
 
-		*(uint32_t*)data_ptr = m_tunables.size();
-		data_ptr += sizeof(uint32_t);
+		std::vector<tunable_save_struct> tunables;
+		tunables.reserve(m_junk_values.size());
+		find_junk_values(globals, m_num_tunables, FIRST_JUNK_VALUE, static_cast<uint32_t>(m_junk_values.size()), [&](size_t index, uint32_t junk_index) {
+			tunables.push_back({m_junk_values[junk_index], static_cast<uint32_t>(TUNABLE_BASE_ADDRESS + index)});
+		});
 
-		for (auto& [hash, val] : m_tunables)
-		{
-			auto save_struct    = (tunable_save_struct*)data_ptr;
-			save_struct->hash   = hash;
-			save_struct->offset = val;
-			data_ptr += sizeof(tunable_save_struct);
-		}
+		m_tunables.build(tunables);
+	}
+
+	void tunables_service::save()
+	{
+		// the slots of the table as they are
+		const auto slots = m_tunables.get_slots();
+		auto data_size   = sizeof(uint32_t) + slots.size_bytes();
+		auto data        = std::make_unique<uint8_t[]>(data_size);
+
+		*(uint32_t*)data.get() = static_cast<uint32_t>(slots.size());
+		memcpy(data.get() + sizeof(uint32_t), slots.data(), slots.size_bytes());
 
 		m_cache_file.set_header_version(memory::module("GTA5.exe").timestamp());
 		m_cache_file.set_data(std::move(data), data_size);
@@ -126,18 +164,20 @@ namespace big
 
 	void tunables_service::load()
 	{
-		auto data = m_cache_file.data();
-
-		auto num_tunables = *(uint32_t*)data;
-		data += sizeof(uint32_t);
+		auto data      = m_cache_file.data();
+		auto data_size = m_cache_file.data_size();
 
-		for (int i = 0; i < num_tunables; i++)
+		auto num_slots = data_size >= sizeof(uint32_t) ? *(uint32_t*)data : 0;
+		if (data_size != sizeof(uint32_t) + num_slots * sizeof(tunable_save_struct)
+		    || !m_tunables.load({reinterpret_cast<const tunable_save_struct*>(data + sizeof(uint32_t)), num_slots}))
 		{
-			auto save_struct = (tunable_save_struct*)data;
-			m_tunables.emplace(save_struct->hash, save_struct->offset);
-			data += sizeof(tunable_save_struct);
+			LOG(WARNING) << "Tunables cache is corrupt, caching tunables again";
+			m_cache_file.free();
+			m_loading = false;
+			return;
 		}
 
+		m_cache_file.free();
 		m_initialized = true;
 		m_loading     = false;
 	}
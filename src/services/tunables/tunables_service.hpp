@@ -3,19 +3,12 @@
 #include "script.hpp"
 #include "services/gta_data/cache_file.hpp"
 #include "script_global.hpp"
+#include "tunable_table.hpp"
 
 namespace big
 {
 	constexpr int TUNABLE_BASE_ADDRESS = 0x40001; // This never changes
 
-#pragma pack(push, 1)
-	struct tunable_save_struct
-	{
-		rage::joaat_t hash;
-		uint32_t offset;
-	};
-#pragma pack(pop)
-
 	class tunables_service
 	{
 	public:
@@ -36,12 +29,41 @@ namespace big
 		template<typename T>
 		inline std::enable_if_t<std::is_pointer_v<T>, T> get_tunable(rage::joaat_t hash)
 		{
-			if (auto it = m_tunables.find(hash); it != m_tunables.end())
-				return reinterpret_cast<T>(script_global(it->second).as<void*>());
+			if (auto offset = m_tunables.find(hash))
+				return reinterpret_cast<T>(script_global(offset).as<void*>());
 
 			return nullptr;
 		}
 
+		/**
+		 * @brief Looks up several tunables at once, for callers that touch the same set every tick.
+		 *
+		 * @param tunables Receives the tunable of each hash, nullptr for those that aren't known.
+		 * @return How many of the tunables were found.
+		 */
+		template<typename T>
+		inline std::enable_if_t<std::is_pointer_v<T>, size_t> get_tunables(std::span<const rage::joaat_t> hashes, std::span<T> tunables)
+		{
+			// all tunables are in the same block of globals, the block only has to be looked up once
+			const auto base = script_global(TUNABLE_BASE_ADDRESS).as<uint64_t*>();
+
+			size_t found = 0;
+			for (size_t i = 0; i < hashes.size() && i < tunables.size(); i++)
+			{
+				if (auto offset = m_tunables.find(hashes[i]))
+				{
+					tunables[i] = reinterpret_cast<T>(base + (offset - TUNABLE_BASE_ADDRESS));
+					found++;
+				}
+				else
+				{
+					tunables[i] = nullptr;
+				}
+			}
+
+			return found;
+		}
+
 		// wrapper around get_tunable(), may not set the tunable immediately if the service isn't initialized yet
 		template<typename T>
 		inline void set_tunable(rage::joaat_t hash, T value)
@@ -73,10 +95,8 @@ namespace big
 
 		inline int get_tunable_offset(rage::joaat_t hash)
 		{
-			if (auto it = m_tunables.find(hash); it != m_tunables.end())
+			if (int offset = m_tunables.find(hash))
 			{
-				auto offset = it->second;
-
 				if (offset > TUNABLE_BASE_ADDRESS)
 					return (offset - TUNABLE_BASE_ADDRESS);
 
@@ -86,20 +106,29 @@ namespace big
 			return 0;
 		}
 
-		int m_current_junk_val = 0x1000000;
-		std::unordered_map<int, rage::joaat_t> m_junk_values{};
+		// stands in for the value of a tunable while tunables_registration runs, so the globals it writes to can be told apart
+		inline int add_junk_value(rage::joaat_t hash)
+		{
+			m_junk_values.push_back(hash);
+			return static_cast<int>(FIRST_JUNK_VALUE + m_junk_values.size() - 1);
+		}
 
 	private:
+		static constexpr uint32_t FIRST_JUNK_VALUE = 0x1000000;
+
 		bool m_initialized    = false;
 		bool m_loading        = false;
 		bool m_script_started = false;
 
 		cache_file m_cache_file;
 
-		std::unordered_map<rage::joaat_t, int> m_tunables{};
+		// hash of each junk value handed out, indexed from FIRST_JUNK_VALUE
+		std::vector<rage::joaat_t> m_junk_values{};
+		tunable_table m_tunables{};
 		std::unique_ptr<uint64_t[]> m_tunables_backup; 
 		int m_num_tunables;
 
+		void find_tunables();
 		void save();
 		void load();
 	};
@@ -4,8 +4,11 @@ namespace big
 {
 	thread_pool::thread_pool(const std::size_t preallocated_thread_count) :
 	    m_accept_jobs(true),
+	    m_worker_count(0),
 	    m_allocated_thread_count(preallocated_thread_count),
-	    m_busy_threads(0)
+	    m_busy_threads(0),
+	    m_sleeping_threads(0),
+	    m_pending_jobs(0)
 	{
 		rescale_thread_pool();
 
@@ -17,15 +20,19 @@ namespace big
 		g_thread_pool = nullptr;
 	}
 
+	// only called from the constructor or with m_lock held
 	void thread_pool::rescale_thread_pool()
 	{
-		LOG(VERBOSE) << "Resizing thread pool from " << m_thread_pool.size() << " to " << m_allocated_thread_count;
-		m_thread_pool.reserve(m_allocated_thread_count);
+		LOG(VERBOSE) << "Resizing thread pool from " << m_worker_count << " to " << m_allocated_thread_count;
 
-		if (m_thread_pool.size() < m_allocated_thread_count)
+		for (auto i = m_worker_count.load(); i < m_allocated_thread_count; i++)
 		{
-			for (auto i = m_thread_pool.size(); i < m_allocated_thread_count; i++)
-				m_thread_pool.emplace_back(std::thread(&thread_pool::run, this));
+			auto& slot = m_workers[i];
+			slot       = std::make_unique<worker>();
+
+			// publish the worker before its thread starts so other threads can steal from it right away
+			m_worker_count.store(i + 1, std::memory_order_release);
+			slot->m_thread = std::thread(&thread_pool::run, this, slot.get());
 		}
 	}
 
@@ -37,56 +44,129 @@ namespace big
 		}
 		m_data_condition.notify_all();
 
-		for (auto& thread : m_thread_pool)
-			thread.join();
+		for (size_t i = 0; i < m_worker_count; i++)
+			m_workers[i]->m_thread.join();
 
-		m_thread_pool.clear();
+		for (auto& worker : m_workers)
+			worker.reset();
+		m_worker_count = 0;
 	}
 
-	void thread_pool::push(std::function<void()> func, std::source_location location)
+	void thread_pool::enqueue(thread_pool_job job)
 	{
-		if (func)
+		if (!job.m_func)
+			return;
+
+		if (t_current_worker)
 		{
+			// jobs pushed from a job stay on this thread unless someone idle steals them
+			std::unique_lock lock(t_current_worker->m_lock);
+			t_current_worker->m_jobs.push_back(std::move(job));
+			++m_pending_jobs;
+		}
+
+		std::unique_lock lock(m_lock);
+		if (!t_current_worker)
+		{
+			m_job_queue.push_back(std::move(job));
+			++m_pending_jobs;
+		}
+
+		if (m_sleeping_threads > 0)
+		{
+			lock.unlock();
+			m_data_condition.notify_one();
+			return;
+		}
+
+		if (m_allocated_thread_count - m_busy_threads < m_pending_jobs) [[unlikely]]
+		{
+			LOG(WARNING) << "Thread pool potentially starved, resizing to accommodate for load.";
+
+			if (m_allocated_thread_count >= MAX_POOL_SIZE)
 			{
-				std::unique_lock lock(m_lock);
-				m_job_stack.push({func, location});
-
-				if (m_allocated_thread_count - m_busy_threads < m_job_stack.size()) [[unlikely]]
-				{
-					LOG(WARNING) << "Thread pool potentially starved, resizing to accommodate for load.";
-
-					if (m_allocated_thread_count >= MAX_POOL_SIZE)
-					{
-						LOG(FATAL) << "The thread pool limit has been reached, whatever you did this should not occur in production.";
-					}
-					if (m_accept_jobs && m_allocated_thread_count + 1 <= MAX_POOL_SIZE)
-					{
-						++m_allocated_thread_count;
-						rescale_thread_pool();
-					}
-				}
+				LOG(FATAL) << "The thread pool limit has been reached, whatever you did this should not occur in production.";
+			}
+			if (m_accept_jobs && m_allocated_thread_count + 1 <= MAX_POOL_SIZE)
+			{
+				++m_allocated_thread_count;
+				rescale_thread_pool();
 			}
-			m_data_condition.notify_all();
 		}
 	}
 
-	void thread_pool::run()
+	bool thread_pool::try_pop(thread_pool_job& job)
 	{
-		for (;;)
+		// own queue first, newest job since its data is most likely still in cache
+		if (auto self = t_current_worker)
+		{
+			std::unique_lock lock(self->m_lock);
+			if (!self->m_jobs.empty())
+			{
+				job = std::move(self->m_jobs.back());
+				self->m_jobs.pop_back();
+				--m_pending_jobs;
+				return true;
+			}
+		}
+
 		{
 			std::unique_lock lock(m_lock);
-			m_data_condition.wait(lock, [this]() {
-				return !m_job_stack.empty() || !m_accept_jobs;
-			});
+			if (!m_job_queue.empty())
+			{
+				job = std::move(m_job_queue.front());
+				m_job_queue.pop_front();
+				--m_pending_jobs;
+				return true;
+			}
+		}
 
-			if (!m_accept_jobs) [[unlikely]]
-				break;
-			if (m_job_stack.empty()) [[likely]]
+		// steal the oldest job of another thread
+		const auto worker_count = m_worker_count.load(std::memory_order_acquire);
+		for (size_t i = 0; i < worker_count; i++)
+		{
+			const auto victim = m_workers[i].get();
+			if (victim == t_current_worker)
 				continue;
 
-			thread_pool_job job = m_job_stack.top();
-			m_job_stack.pop();
-			lock.unlock();
+			std::unique_lock lock(victim->m_lock);
+			if (victim->m_jobs.empty())
+				continue;
+
+			job = std::move(victim->m_jobs.front());
+			victim->m_jobs.pop_front();
+			--m_pending_jobs;
+			return true;
+		}
+
+		return false;
+	}
+
+	void thread_pool::run(worker* self)
+	{
+		t_current_worker = self;
+
+		for (;;)
+		{
+			thread_pool_job job;
+			if (!try_pop(job))
+			{
+				std::unique_lock lock(m_lock);
+
+				++m_sleeping_threads;
+				m_data_condition.wait(lock, [this]() {
+					return m_pending_jobs > 0 || !m_accept_jobs;
+				});
+				--m_sleeping_threads;
+
+				if (!m_accept_jobs) [[unlikely]]
+					break;
+
+				continue;
+			}
+
+			if (!m_accept_jobs) [[unlikely]]
+				break;
 
 			++m_busy_threads;
 
@@ -102,6 +182,10 @@ namespace big
 			{
 				LOG(WARNING) << "Exception thrown while executing job in thread:" << std::endl << e.what();
 			}
+			catch (...)
+			{
+				LOG(WARNING) << "Unknown exception thrown while executing job in thread.";
+			}
 
 			--m_busy_threads;
 		}
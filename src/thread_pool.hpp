@@ -1,4 +1,7 @@
 #pragma once
+#include <array>
+#include <deque>
+#include <future>
 
 namespace big
 {
@@ -7,23 +10,41 @@ namespace big
 
 	struct thread_pool_job
 	{
-		std::function<void()> m_func;
+		std::move_only_function<void()> m_func;
 		std::source_location m_source_location;
 	};
 
 	class thread_pool
 	{
+		struct worker
+		{
+			std::mutex m_lock;
+			// the owner pops from the back, thieves take from the front
+			std::deque<thread_pool_job> m_jobs;
+			std::thread m_thread;
+		};
+
 		std::atomic<bool> m_accept_jobs;
 		std::condition_variable m_data_condition;
 
-		std::stack<thread_pool_job> m_job_stack;
+		// jobs pushed from outside the pool, ran in submission order
+		std::deque<thread_pool_job> m_job_queue;
 		std::mutex m_lock;
-		std::vector<std::thread> m_thread_pool;
+
+		std::array<std::unique_ptr<worker>, MAX_POOL_SIZE> m_workers;
+		// the amount of workers that have been published in m_workers
+		std::atomic<size_t> m_worker_count;
 
 		// the amount of threads active in the pool
 		std::atomic<size_t> m_allocated_thread_count;
 		// the amount of threads currently on a job
 		std::atomic<size_t> m_busy_threads;
+		// the amount of threads waiting for a job
+		std::atomic<size_t> m_sleeping_threads;
+		// jobs sitting in any of the queues
+		std::atomic<size_t> m_pending_jobs;
+
+		static inline thread_local worker* t_current_worker{};
 
 	public:
 		// YimMenu only has 2 blocking threads, 4 should be sufficient but the pool should automatically allocate more if needed
@@ -31,13 +52,122 @@ namespace big
 		~thread_pool();
 
 		void destroy();
-		void push(std::function<void()> func, std::source_location location = std::source_location::current());
+
+		/**
+		 * @brief Queues a job on the pool.
+		 *
+		 * Jobs pushed from outside the pool run in submission order, jobs pushed from a pool thread go to that thread's own queue
+		 * and are stolen by idle threads if it stays busy.
+		 * Exceptions of any type are logged and forwarded to the returned future.
+		 */
+		template<typename F>
+		auto push(F&& func, std::source_location location = std::source_location::current())
+		{
+			using result_t = std::invoke_result_t<std::decay_t<F>&>;
+
+			std::promise<result_t> promise;
+			auto future = promise.get_future();
+
+			enqueue({[func = std::forward<F>(func), promise = std::move(promise), location]() mutable {
+				try
+				{
+					if constexpr (std::is_void_v<result_t>)
+					{
+						std::invoke(func);
+						promise.set_value();
+					}
+					else
+					{
+						promise.set_value(std::invoke(func));
+					}
+				}
+				catch (const std::exception& e)
+				{
+					LOG(WARNING) << "Exception thrown while executing job in thread:" << std::endl << e.what();
+					promise.set_exception(std::current_exception());
+				}
+				catch (...)
+				{
+					LOG(WARNING) << "Unknown exception thrown while executing job in thread.";
+					promise.set_exception(std::current_exception());
+				}
+			},
+			    location});
+
+			return future;
+		}
+
+		/**
+		 * @brief Queues a job and a continuation that receives its result.
+		 *
+		 * The continuation is queued on the thread that ran the job once it finishes, it doesn't hold up the pool in between.
+		 */
+		template<typename F, typename C>
+		    requires(!std::is_same_v<std::decay_t<C>, std::source_location>)
+		auto push(F&& func, C&& continuation, std::source_location location = std::source_location::current())
+		{
+			using result_t       = std::invoke_result_t<std::decay_t<F>&>;
+			using continuation_t = typename std::conditional_t<std::is_void_v<result_t>, std::invoke_result<std::decay_t<C>&>, std::invoke_result<std::decay_t<C>&, result_t>>::type;
+
+			auto promise = std::make_shared<std::promise<continuation_t>>();
+			auto future  = promise->get_future();
+
+			push(
+			    [this, func = std::forward<F>(func), continuation = std::forward<C>(continuation), promise, location]() mutable {
+				    auto run_continuation = [&](auto&&... result) {
+					    push(
+					        [continuation = std::move(continuation), promise, ... result = std::forward<decltype(result)>(result)]() mutable {
+						        try
+						        {
+							        if constexpr (std::is_void_v<continuation_t>)
+							        {
+								        std::invoke(continuation, std::move(result)...);
+								        promise->set_value();
+							        }
+							        else
+							        {
+								        promise->set_value(std::invoke(continuation, std::move(result)...));
+							        }
+						        }
+						        catch (...)
+						        {
+							        promise->set_exception(std::current_exception());
+							        throw;
+						        }
+					        },
+					        location);
+				    };
+
+				    try
+				    {
+					    if constexpr (std::is_void_v<result_t>)
+					    {
+						    std::invoke(func);
+						    run_continuation();
+					    }
+					    else
+					    {
+						    run_continuation(std::invoke(func));
+					    }
+				    }
+				    catch (...)
+				    {
+					    promise->set_exception(std::current_exception());
+					    throw;
+				    }
+			    },
+			    location);
+
+			return future;
+		}
 
 		std::pair<size_t, size_t> usage() const
 		{ return { m_busy_threads, m_allocated_thread_count }; }
 
 	private:
-		void run();
+		void enqueue(thread_pool_job job);
+		bool try_pop(thread_pool_job& job);
+		void run(worker* self);
 		void rescale_thread_pool();
 	};
 
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace big
+{
+	/**
+	 * @brief Bounded lock-free multi producer, single consumer FIFO ring.
+	 *
+	 * Every slot carries a sequence number that tells producers whether it's free and the consumer whether it has been published,
+	 * producers only contend on the tail index. See https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+	 *
+	 * @tparam T Element type, has to be default constructible and movable.
+	 * @tparam capacity Amount of slots, has to be a power of two.
+	 */
+	template<typename T, std::size_t capacity>
+	class mpsc_ring
+	{
+		static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "capacity has to be a power of two");
+
+		struct slot
+		{
+			std::atomic<std::size_t> m_sequence;
+			T m_value;
+		};
+
+	public:
+		mpsc_ring() :
+		    m_slots(std::make_unique<slot[]>(capacity))
+		{
+			for (std::size_t i = 0; i < capacity; i++)
+				m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Can be called from any thread.
+		 *
+		 * @return False if the ring is full, value is left untouched in that case.
+		 */
+		bool try_push(T&& value)
+		{
+			auto pos = m_tail.load(std::memory_order_relaxed);
+			slot* target;
+			for (;;)
+			{
+				target          = &m_slots[pos & (capacity - 1)];
+				const auto seq  = target->m_sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+				if (diff == 0)
+				{
+					if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = m_tail.load(std::memory_order_relaxed);
+				}
+			}
+
+			target->m_value = std::move(value);
+			target->m_sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Only ever call this from the consumer.
+		 */
+		std::optional<T> try_pop()
+		{
+			const auto pos = m_head.load(std::memory_order_relaxed);
+			auto& source   = m_slots[pos & (capacity - 1)];
+			if (source.m_sequence.load(std::memory_order_acquire) != pos + 1)
+				return std::nullopt;
+
+			std::optional<T> value(std::move(source.m_value));
+			source.m_value = T{};
+			source.m_sequence.store(pos + capacity, std::memory_order_release);
+			m_head.store(pos + 1, std::memory_order_relaxed);
+
+			return value;
+		}
+
+		/**
+		 * @brief Approximate amount of queued elements, safe to call from any thread.
+		 */
+		std::size_t size() const
+		{
+			const auto tail = m_tail.load(std::memory_order_relaxed);
+			const auto head = m_head.load(std::memory_order_relaxed);
+			return tail > head ? tail - head : 0;
+		}
+
+	private:
+		std::unique_ptr<slot[]> m_slots;
+
+		alignas(64) std::atomic<std::size_t> m_tail{0};
+		// only written by the consumer, atomic so size() can be called from other threads
+		alignas(64) std::atomic<std::size_t> m_head{0};
+	};
+}
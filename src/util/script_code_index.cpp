@@ -0,0 +1,116 @@
+#include "script_code_index.hpp"
+
+#include <bitset>
+
+namespace big
+{
+	script_code_index::script_code_index(const uint8_t* const* pages, uint32_t code_size) :
+	    m_code(code_size)
+	{
+		for (uint32_t offset = 0; offset < code_size; offset += PAGE_SIZE)
+			std::memcpy(m_code.data() + offset, pages[offset / PAGE_SIZE], std::min(PAGE_SIZE, code_size - offset));
+	}
+
+	script_code_index::script_code_index(rage::scrProgram* program) :
+	    m_code(program->m_code_size)
+	{
+		// not get_code_page_size(), that is 0 for the last page when the code size is a multiple of the page size
+		for (uint32_t offset = 0; offset < program->m_code_size; offset += PAGE_SIZE)
+			std::memcpy(m_code.data() + offset, program->get_code_page(offset / PAGE_SIZE), std::min(PAGE_SIZE, program->m_code_size - offset));
+	}
+
+	bool script_code_index::matches(const memory::pattern& pattern, size_t location) const
+	{
+		if (location + pattern.m_bytes.size() > m_code.size())
+			return false;
+
+		for (size_t i = 0; i < pattern.m_bytes.size(); i++)
+			if (pattern.m_bytes[i].has_value() && pattern.m_bytes[i].value() != m_code[location + i])
+				return false;
+
+		return true;
+	}
+
+	std::optional<uint32_t> script_code_index::scan(const memory::pattern& pattern) const
+	{
+		for (size_t i = 0; i + pattern.m_bytes.size() <= m_code.size(); i++)
+			if (matches(pattern, i))
+				return static_cast<uint32_t>(i);
+
+		return std::nullopt;
+	}
+
+	std::vector<std::optional<uint32_t>> script_code_index::find(std::span<const memory::pattern* const> patterns) const
+	{
+		struct anchor
+		{
+			uint32_t m_pattern;
+			uint32_t m_offset;
+		};
+
+		std::vector<std::optional<uint32_t>> result(patterns.size());
+		std::unordered_map<uint16_t, std::vector<anchor>> anchors;
+		std::bitset<0x10000> anchored_pairs;
+		size_t remaining = 0;
+
+		for (uint32_t i = 0; i < patterns.size(); i++)
+		{
+			const auto& bytes = patterns[i]->m_bytes;
+
+			// the first pair of fixed bytes in the longest run of them, opcodes repeat a lot so longer runs tend to be rarer
+			size_t best_start = 0, best_length = 0;
+			for (size_t start = 0; start < bytes.size();)
+			{
+				size_t length = 0;
+				while (start + length < bytes.size() && bytes[start + length].has_value())
+					length++;
+
+				if (length > best_length)
+				{
+					best_start  = start;
+					best_length = length;
+				}
+				start += length + 1;
+			}
+
+			if (best_length < 2)
+			{
+				result[i] = scan(*patterns[i]);
+				continue;
+			}
+
+			const uint16_t pair = bytes[best_start].value() | bytes[best_start + 1].value() << 8;
+			anchors[pair].push_back({i, static_cast<uint32_t>(best_start)});
+			anchored_pairs.set(pair);
+			remaining++;
+		}
+
+		// a pattern only ever gets checked at increasing locations, so the first match is also the lowest
+		for (size_t i = 0; remaining && i + 1 < m_code.size(); i++)
+		{
+			const uint16_t pair = m_code[i] | m_code[i + 1] << 8;
+			if (!anchored_pairs.test(pair))
+				continue;
+
+			for (const auto& anchor : anchors[pair])
+			{
+				if (result[anchor.m_pattern] || i < anchor.m_offset)
+					continue;
+
+				if (matches(*patterns[anchor.m_pattern], i - anchor.m_offset))
+				{
+					result[anchor.m_pattern] = static_cast<uint32_t>(i - anchor.m_offset);
+					remaining--;
+				}
+			}
+		}
+
+		return result;
+	}
+
+	std::optional<uint32_t> script_code_index::find(const memory::pattern& pattern) const
+	{
+		const memory::pattern* patterns[]{&pattern};
+		return find(patterns)[0];
+	}
+}
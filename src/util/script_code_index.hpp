@@ -0,0 +1,36 @@
+#pragma once
+#include <memory/pattern.hpp>
+#include <script/scrProgram.hpp>
+#include <span>
+
+namespace big
+{
+	/**
+	 * @brief Contiguous copy of the code pages of a script that finds any number of patterns in a single pass.
+	 *
+	 * Every pattern is anchored on a pair of fixed bytes, a walk over the code only has to look at the patterns anchored on the pair at hand.
+	 * Build one per program load and resolve everything wanted from it at once, freemode is several megabytes.
+	 */
+	class script_code_index final
+	{
+	public:
+		static constexpr uint32_t PAGE_SIZE = 0x4000;
+
+		script_code_index(const uint8_t* const* pages, uint32_t code_size);
+		explicit script_code_index(rage::scrProgram* program);
+
+		/**
+		 * @brief Finds the first location of every pattern.
+		 *
+		 * @return The locations in the order of the patterns, std::nullopt for those that weren't found.
+		 */
+		std::vector<std::optional<uint32_t>> find(std::span<const memory::pattern* const> patterns) const;
+		std::optional<uint32_t> find(const memory::pattern& pattern) const;
+
+	private:
+		bool matches(const memory::pattern& pattern, size_t location) const;
+		std::optional<uint32_t> scan(const memory::pattern& pattern) const;
+
+		std::vector<uint8_t> m_code;
+	};
+}
@@ -10,6 +10,7 @@
 #include "script.hpp"
 #include "script_local.hpp"
 #include "services/players/player_service.hpp"
+#include "util/script_code_index.hpp"
 
 #include <memory/pattern.hpp>
 #include <script/globals/GPBD_FM_3.hpp>
@@ -226,20 +227,7 @@ namespace big::scripts
 
 	inline const std::optional<uint32_t> get_code_location_by_pattern(rage::scrProgram* program, const memory::pattern& pattern)
 	{
-		uint32_t code_size = program->m_code_size;
-		for (uint32_t i = 0; i < (code_size - pattern.m_bytes.size()); i++)
-		{
-			for (uint32_t j = 0; j < pattern.m_bytes.size(); j++)
-				if (pattern.m_bytes[j].has_value())
-					if (pattern.m_bytes[j].value() != *program->get_code_address(i + j))
-						goto incorrect;
-
-			return i;
-		incorrect:
-			continue;
-		}
-
-		return std::nullopt;
+		return script_code_index(program).find(pattern);
 	}
 
 	// we can't use the script patch service for this
@@ -284,17 +272,23 @@ namespace big::scripts
 
 		if (auto program = gta_util::find_script_program(hash))
 		{
+			const memory::pattern place_anywhere("2D 02 04 00 ? 38 01 38 00 42 13");
+			const memory::pattern network_mode_bail("71 08 2A 56 ? ? 2C ? ? ? 1F 56 ? ? 72");
+			const memory::pattern fast_zoom("39 04 5D ? ? ? 71");
+			const memory::pattern* patterns[]{&place_anywhere, &network_mode_bail, &fast_zoom};
+			const auto locations = script_code_index(program).find(patterns);
+
 			patch_script(program,
-			    get_code_location_by_pattern(program, "2D 02 04 00 ? 38 01 38 00 42 13"),
+			    locations[0],
 			    {
 			        0x72, // PUSH_CONST_1
 			        0x00  // NOP
 			    },
 			    5); // place anywhere
 
-			patch_script(program, get_code_location_by_pattern(program, "71 08 2A 56 ? ? 2C ? ? ? 1F 56 ? ? 72"), {0x00, 0x00, 0x00, 0x00, 0x00}, 0xE); // don't bail on network mode
+			patch_script(program, locations[1], {0x00, 0x00, 0x00, 0x00, 0x00}, 0xE); // don't bail on network mode
 
-			if (auto loc = get_code_location_by_pattern(program, "39 04 5D ? ? ? 71"))
+			if (auto loc = locations[2])
 			{
 				patch_script(program,
 				    read_uint24_t(program->get_code_address(loc.value() + 3)),
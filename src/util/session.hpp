@@ -175,19 +175,25 @@ namespace big::session
 		if ((player->is_friend() && g.session.trust_friends) || player->is_trusted || g.session.trust_session)
 			return;
 
-		auto plyr = g_player_database_service->get_or_create_player(player);
-		if (!plyr->infractions.contains((int)infraction))
-		{
-			plyr->is_modder   = true;
-			player->is_modder = true;
+		auto plyr  = g_player_database_service->get_or_create_player(player);
+		bool added = false;
+		g_player_database_service->update_player(plyr, [&](persistent_player& entry) {
+			if (!entry.infractions.insert((int)infraction).second)
+				return;
 
-			plyr->infractions.insert((int)infraction);
+			added           = true;
+			entry.is_modder = true;
 			if (infraction == Infraction::CUSTOM_REASON)
 			{
-				plyr->custom_infraction_reason += plyr->custom_infraction_reason.size() ? (std::string(", ") + custom_reason) : custom_reason;
+				entry.custom_infraction_reason += entry.custom_infraction_reason.size() ? (std::string(", ") + custom_reason) : custom_reason;
 			}
+		});
+
+		if (added)
+		{
+			player->is_modder = true;
 
-			g_player_database_service->save();
+			g_player_database_service->save(plyr);
 
 			g.reactions.modder_detection.process(player);
 		}
@@ -10,6 +10,32 @@ namespace big::string::operations
 		return result;
 	}
 
+	inline char to_lower(char c)
+	{
+		return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+	}
+
+	// lower has to be lower cased already, str is folded while comparing so nothing gets copied
+	inline bool iequals(std::string_view lower, std::string_view str)
+	{
+		return lower.size() == str.size() && std::equal(lower.begin(), lower.end(), str.begin(), [](char a, char b) {
+			return a == to_lower(b);
+		});
+	}
+
+	// position of str in lower ignoring the case of str, lower has to be lower cased already
+	inline size_t ifind(std::string_view lower, std::string_view str)
+	{
+		if (str.size() > lower.size())
+			return std::string_view::npos;
+
+		for (size_t pos = 0; pos + str.size() <= lower.size(); pos++)
+			if (iequals(lower.substr(pos, str.size()), str))
+				return pos;
+
+		return std::string_view::npos;
+	}
+
 	inline std::string to_upper(std::string& str)
 	{
 		std::string result = str;
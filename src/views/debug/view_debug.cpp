@@ -20,6 +20,8 @@ namespace big
 			script_events();
 			scripts();
 			threads();
+			profiler();
+			rate_limits();
 		}
 		ImGui::End();
 	}
@@ -10,6 +10,8 @@ namespace big::debug
 	extern void script_events();
 	extern void scripts();
 	extern void threads();
+	extern void profiler();
+	extern void rate_limits();
 
 	extern void main();
 }
\ No newline at end of file
@@ -29,6 +29,20 @@ namespace big
 				g_fiber_pool->reset();
 			}
 
+			const auto fiber_stats = g_fiber_pool->get_stats();
+			ImGui::Text(std::format("{}: {}/{}/{}",
+			    "VIEW_DEBUG_MISC_FIBER_POOL_QUEUE_DEPTH"_T,
+			    fiber_stats.m_queue_depth[static_cast<size_t>(fiber_job_priority::HIGH)],
+			    fiber_stats.m_queue_depth[static_cast<size_t>(fiber_job_priority::NORMAL)],
+			    fiber_stats.m_queue_depth[static_cast<size_t>(fiber_job_priority::LOW)])
+			                .c_str());
+			ImGui::Text(std::format("{}: p50 {} / p90 {} / p99 {}",
+			    "VIEW_DEBUG_MISC_FIBER_POOL_WAIT_TIME"_T,
+			    fiber_stats.m_wait_p50,
+			    fiber_stats.m_wait_p90,
+			    fiber_stats.m_wait_p99)
+			                .c_str());
+
 			if (components::button("VIEW_DEBUG_MISC_TRIGGER_GTA_ERROR_BOX"_T))
 			{
 				hooks::log_error_message_box(0xBAFD530B, 1);
@@ -0,0 +1,56 @@
+#include "gui/components/components.hpp"
+#include "script_profiler.hpp"
+#include "view_debug.hpp"
+
+namespace big
+{
+	void debug::profiler()
+	{
+		if (ImGui::BeginTabItem("DEBUG_TAB_PROFILER"_T.data()))
+		{
+			ImGui::Checkbox("VIEW_DEBUG_PROFILER_ENABLE"_T.data(), &g.debug.script_profiler);
+			ImGui::SameLine();
+			components::command_button<"dumpscriptprofile">();
+			ImGui::SameLine();
+			if (components::button("RESET"_T))
+			{
+				g_script_profiler.reset();
+			}
+
+			static constexpr const char* kind_names[] = {"Script", "Lua", "Looped"};
+
+			if (ImGui::BeginTable("##script_profiler", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp))
+			{
+				ImGui::TableSetupScrollFreeze(0, 1);
+				ImGui::TableSetupColumn("VIEW_DEBUG_PROFILER_NAME"_T.data());
+				ImGui::TableSetupColumn("VIEW_DEBUG_PROFILER_KIND"_T.data());
+				ImGui::TableSetupColumn("min (us)");
+				ImGui::TableSetupColumn("avg (us)");
+				ImGui::TableSetupColumn("p99 (us)");
+				ImGui::TableSetupColumn("VIEW_DEBUG_PROFILER_YIELDS"_T.data());
+				ImGui::TableHeadersRow();
+
+				for (const auto& stat : g_script_profiler.get_stats())
+				{
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(stat.m_name.c_str());
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(kind_names[static_cast<int>(stat.m_kind)]);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.1f", stat.m_min_us);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.1f", stat.m_avg_us);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.1f", stat.m_p99_us);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.2f", stat.m_yields_per_frame);
+				}
+
+				ImGui::EndTable();
+			}
+
+			ImGui::EndTabItem();
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#include "gui/components/components.hpp"
+#include "services/players/rate_limiter.hpp"
+#include "view_debug.hpp"
+
+namespace big
+{
+	void debug::rate_limits()
+	{
+		if (ImGui::BeginTabItem("DEBUG_TAB_RATE_LIMITS"_T.data()))
+		{
+			constexpr auto event_count = static_cast<size_t>(rate_limited_event::COUNT);
+
+			struct sample
+			{
+				uint64_t m_dropped;
+				uint64_t m_shed;
+				uint64_t m_allowed;
+			};
+
+			// the counters only ever grow, rates come from the difference to the last sample
+			static std::array<sample, event_count> last_sample{};
+			static std::array<sample, event_count> rates{};
+			static auto last_sample_time = std::chrono::steady_clock::now();
+
+			if (const auto now = std::chrono::steady_clock::now(); now - last_sample_time >= 1s)
+			{
+				const auto seconds = std::chrono::duration<double>(now - last_sample_time).count();
+				for (size_t i = 1; i < event_count; i++)
+				{
+					const auto& stats = g_rate_limits.get_stats(static_cast<rate_limited_event>(i));
+					const sample current{stats.m_dropped.load(), stats.m_shed.load(), stats.m_allowed.load()};
+
+					rates[i] = {static_cast<uint64_t>((current.m_dropped - last_sample[i].m_dropped) / seconds),
+					    static_cast<uint64_t>((current.m_shed - last_sample[i].m_shed) / seconds),
+					    static_cast<uint64_t>((current.m_allowed - last_sample[i].m_allowed) / seconds)};
+					last_sample[i] = current;
+				}
+				last_sample_time = now;
+			}
+
+			if (ImGui::BeginTable("##rate_limits", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+			{
+				ImGui::TableSetupColumn("VIEW_DEBUG_RATE_LIMITS_EVENT"_T.data());
+				ImGui::TableSetupColumn("VIEW_DEBUG_RATE_LIMITS_ALLOWED"_T.data());
+				ImGui::TableSetupColumn("VIEW_DEBUG_RATE_LIMITS_DROPPED"_T.data());
+				ImGui::TableSetupColumn("VIEW_DEBUG_RATE_LIMITS_SHED"_T.data());
+				ImGui::TableSetupColumn("VIEW_DEBUG_RATE_LIMITS_DROPPED_TOTAL"_T.data());
+				ImGui::TableHeadersRow();
+
+				for (size_t i = 1; i < event_count; i++)
+				{
+					const auto event = static_cast<rate_limited_event>(i);
+
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(g_translation_service.get_translation(big::rate_limits::get_name(event)).data());
+					ImGui::TableNextColumn();
+					ImGui::Text("%llu", rates[i].m_allowed);
+					ImGui::TableNextColumn();
+					ImGui::Text("%llu", rates[i].m_dropped);
+					ImGui::TableNextColumn();
+					ImGui::Text("%llu", rates[i].m_shed);
+					ImGui::TableNextColumn();
+					ImGui::Text("%llu", g_rate_limits.get_stats(event).m_dropped.load() + g_rate_limits.get_stats(event).m_shed.load());
+				}
+
+				ImGui::EndTable();
+			}
+
+			ImGui::EndTabItem();
+		}
+	}
+}
@@ -13,6 +13,11 @@ namespace big
 			ImGui::Combo("VIEW_DEBUG_LOGS_LOG_PACKETS"_T.data(), (int*)&g.debug.logs.packet_logs, options, IM_ARRAYSIZE(options));
 			ImGui::Checkbox("DEBUG_LOG_HTTP_START_REQUESTS"_T.data(), &g.debug.logs.http_start_request_logs);
 			ImGui::Checkbox("DEBUG_LOG_NATIVE_SCRIPT_HOOKS"_T.data(), &g.debug.logs.script_hook_logs);
+			ImGui::Checkbox("DEBUG_LOG_TEXT_FILE"_T.data(), &g.debug.logs.text_file_log);
+			ImGui::SameLine();
+			ImGui::Checkbox("DEBUG_LOG_BINARY_FILE"_T.data(), &g.debug.logs.binary_file_log);
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("DEBUG_LOG_BINARY_FILE_DESC"_T.data());
 
 			if (ImGui::TreeNode("DEBUG_LOG_TREE_SCRIPT_EVENT"_T.data()))
 			{
@@ -19,70 +19,73 @@ namespace big
 	bool filter_block_join                        = false;
 	bool filter_track_player                      = false;
 
-	ImVec4 get_player_color(persistent_player& player)
+	// search results only change with the snapshot, the search or the filters
+	std::shared_ptr<const player_database_snapshot> searched_snapshot;
+	std::string searched_name;
+	uint32_t searched_flags = 0;
+	std::vector<uint32_t> search_results;
+
+	ImVec4 get_player_color(GSType session_type, GameMode game_mode)
 	{
-		if (player.session_type == GSType::Unknown)
+		if (session_type == GSType::Unknown)
 			return ImVec4(.5f, .5f, .5f, 1.0f);
-		else if (player.session_type == GSType::Invalid)
+		else if (session_type == GSType::Invalid)
 			return ImVec4(1.f, 0.f, 0.f, 1.f);
-		else if (!player_database_service::is_joinable_session(player.session_type, player.game_mode))
+		else if (!player_database_service::is_joinable_session(session_type, game_mode))
 			return ImVec4(1.f, 1.f, 0.f, 1.f);
 		else
 			return ImVec4(0.f, 1.f, 0.f, 1.f);
 	}
 
-	bool apply_filters(const std::shared_ptr<persistent_player>& player)
+	uint32_t get_required_flags()
 	{
-		if (filter_modder && !player->is_modder)
-			return false;
-		if (filter_trust && !player->is_trusted)
-			return false;
-		if (filter_block_join && !player->block_join)
-			return false;
-		if (filter_track_player && !player->notify_online)
-			return false;
-		return true;
+		using flag = player_database_snapshot::flag;
+
+		uint32_t flags = 0;
+		if (filter_modder)
+			flags |= static_cast<uint32_t>(flag::MODDER);
+		if (filter_trust)
+			flags |= static_cast<uint32_t>(flag::TRUSTED);
+		if (filter_block_join)
+			flags |= static_cast<uint32_t>(flag::BLOCK_JOIN);
+		if (filter_track_player)
+			flags |= static_cast<uint32_t>(flag::NOTIFY_ONLINE);
+		return flags;
 	}
 
-	void draw_player_db_entry(const std::shared_ptr<persistent_player>& player, const std::string& lower_search)
+	void draw_player_db_entry(const player_database_snapshot::entry& entry)
 	{
-		std::string name = player->name;
-		std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-
-		if ((lower_search.empty() || name.find(lower_search) != std::string::npos) && apply_filters(player))
-		{
-			ImGui::PushID(player->rockstar_id);
+		ImGui::PushID(entry.m_rockstar_id);
 
-			float circle_size = 7.5f;
-			auto cursor_pos   = ImGui::GetCursorScreenPos();
+		float circle_size = 7.5f;
+		auto cursor_pos   = ImGui::GetCursorScreenPos();
 
-			//render status circle
-			ImGui::GetWindowDrawList()->AddCircleFilled(ImVec2(cursor_pos.x + 4.f + circle_size, cursor_pos.y + 4.f + circle_size), circle_size, ImColor(get_player_color(*player)));
+		//render status circle
+		ImGui::GetWindowDrawList()->AddCircleFilled(ImVec2(cursor_pos.x + 4.f + circle_size, cursor_pos.y + 4.f + circle_size), circle_size, ImColor(get_player_color(entry.m_session_type, entry.m_game_mode)));
 
-			//we need some padding
-			ImVec2 cursor = ImGui::GetCursorPos();
-			ImGui::SetCursorPos(ImVec2(cursor.x + 25.f, cursor.y));
+		//we need some padding
+		ImVec2 cursor = ImGui::GetCursorPos();
+		ImGui::SetCursorPos(ImVec2(cursor.x + 25.f, cursor.y));
 
-			if (components::selectable(player->name, player == g_player_database_service->get_selected()))
+		if (components::selectable(entry.m_name, entry.m_player == g_player_database_service->get_selected()))
+		{
+			if (notes_dirty)
 			{
-				if (notes_dirty)
-				{
-					// Ensure notes are saved
-					g_player_database_service->save();
-					notes_dirty = false;
-				}
-
-				g_player_database_service->set_selected(player);
-				current_player = player;
-				strncpy(name_buf, current_player->name.data(), sizeof(name_buf));
-				strncpy(note_buffer, current_player->notes.data(), sizeof(note_buffer));
+				// Ensure notes are saved
+				g_player_database_service->save(current_player);
+				notes_dirty = false;
 			}
 
-			if (ImGui::IsItemHovered())
-				ImGui::SetTooltip(player_database_service::get_session_type_str(player->session_type));
-
-			ImGui::PopID();
+			g_player_database_service->set_selected(entry.m_player);
+			current_player = entry.m_player;
+			strncpy(name_buf, entry.m_name.data(), sizeof(name_buf));
+			strncpy(note_buffer, g_player_database_service->get_player_copy(current_player).notes.data(), sizeof(note_buffer));
 		}
+
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip(player_database_service::get_session_type_str(entry.m_session_type));
+
+		ImGui::PopID();
 	}
 
 	void view::player_database()
@@ -92,30 +95,50 @@ namespace big
 
 		if (ImGui::BeginListBox("###players", {180, static_cast<float>(*g_pointers->m_gta.m_resolution_y - 400 - 38 * 4)}))
 		{
-			auto& item_arr = g_player_database_service->get_sorted_players();
-			if (item_arr.size() > 0)
+			const auto snapshot = g_player_database_service->get_snapshot();
+			if (snapshot->size() > 0)
 			{
-				std::string lower_search = search;
-				std::transform(lower_search.begin(), lower_search.end(), lower_search.begin(), tolower);
-
-				for (auto& player : item_arr | std::ranges::views::values)
+				const auto lower_search   = player_database_snapshot::to_lower(search);
+				const auto required_flags = get_required_flags();
+				if (snapshot != searched_snapshot || lower_search != searched_name || required_flags != searched_flags)
 				{
-					if (player_database_service::is_joinable_session(player->session_type, player->game_mode))
-						draw_player_db_entry(player, lower_search);
-				}
+					const auto matches = snapshot->search(lower_search, required_flags);
+					searched_snapshot  = snapshot;
+					searched_name      = lower_search;
+					searched_flags     = required_flags;
 
-				for (auto& player : item_arr | std::ranges::views::values)
-				{
-					if (!player_database_service::is_joinable_session(player->session_type, player->game_mode) && player->session_type != GSType::Invalid
-					    && player->session_type != GSType::Unknown)
-						draw_player_db_entry(player, lower_search);
-				}
+					// session states are part of the snapshot, joinable players first and offline ones last
+					search_results.clear();
+					search_results.reserve(matches.size());
 
-				for (auto& player : item_arr | std::ranges::views::values)
-				{
-					if (player->session_type == GSType::Invalid || player->session_type == GSType::Unknown)
-						draw_player_db_entry(player, lower_search);
+					for (const auto index : matches)
+					{
+						const auto& player = snapshot->get(index);
+						if (player_database_service::is_joinable_session(player.m_session_type, player.m_game_mode))
+							search_results.push_back(index);
+					}
+
+					for (const auto index : matches)
+					{
+						const auto& player = snapshot->get(index);
+						if (!player_database_service::is_joinable_session(player.m_session_type, player.m_game_mode)
+						    && player.m_session_type != GSType::Invalid && player.m_session_type != GSType::Unknown)
+							search_results.push_back(index);
+					}
+
+					for (const auto index : matches)
+					{
+						const auto& player = snapshot->get(index);
+						if (player.m_session_type == GSType::Invalid || player.m_session_type == GSType::Unknown)
+							search_results.push_back(index);
+					}
 				}
+
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(search_results.size()));
+				while (clipper.Step())
+					for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+						draw_player_db_entry(snapshot->get(search_results[i]));
 			}
 			else
 			{
@@ -125,43 +148,55 @@ namespace big
 			ImGui::EndListBox();
 		}
 
-		if (auto selected = g_player_database_service->get_selected())
+		if (g_player_database_service->get_selected())
 		{
+			// the update loop writes to the player from a fiber, so it's read through a copy and edited through the service
+			auto player            = g_player_database_service->get_player_copy(current_player);
+			const auto rockstar_id = player.rockstar_id;
+
 			ImGui::SameLine();
 			if (ImGui::BeginChild("###selected_player", {500, static_cast<float>(*g_pointers->m_gta.m_resolution_y - 388 - 38 * 4)}, false, ImGuiWindowFlags_NoBackground))
 			{
 				if (ImGui::InputText("NAME"_T.data(), name_buf, sizeof(name_buf)))
 				{
-					current_player->name = name_buf;
+					g_player_database_service->set_name(current_player, name_buf);
 				}
 				if (ImGui::IsItemActive())
 					g.self.hud.typing = TYPING_TICKS;
 
-				if (ImGui::InputScalar("RID"_T.data(), ImGuiDataType_S64, &current_player->rockstar_id)
-				    || ImGui::Checkbox("IS_MODDER"_T.data(), &current_player->is_modder)
-				    || ImGui::Checkbox("TRUST"_T.data(), &current_player->is_trusted)
-				    || ImGui::Checkbox("BLOCK_JOIN"_T.data(), &current_player->block_join)
-				    || ImGui::Checkbox("VIEW_NET_PLAYER_DB_TRACK_PLAYER"_T.data(), &current_player->notify_online))
+				if (ImGui::InputScalar("RID"_T.data(), ImGuiDataType_S64, &player.rockstar_id)
+				    || ImGui::Checkbox("IS_MODDER"_T.data(), &player.is_modder)
+				    || ImGui::Checkbox("TRUST"_T.data(), &player.is_trusted)
+				    || ImGui::Checkbox("BLOCK_JOIN"_T.data(), &player.block_join)
+				    || ImGui::Checkbox("VIEW_NET_PLAYER_DB_TRACK_PLAYER"_T.data(), &player.notify_online))
 				{
-					if (current_player->rockstar_id != selected->rockstar_id)
-						g_player_database_service->update_rockstar_id(selected->rockstar_id, current_player->rockstar_id);
-					g_player_database_service->save();
+					g_player_database_service->update_player(current_player, [&player](persistent_player& stored) {
+						stored.is_modder     = player.is_modder;
+						stored.is_trusted    = player.is_trusted;
+						stored.block_join    = player.block_join;
+						stored.notify_online = player.notify_online;
+					});
+					if (player.rockstar_id != rockstar_id)
+						g_player_database_service->update_rockstar_id(rockstar_id, player.rockstar_id);
+					g_player_database_service->save(current_player);
 				}
 
 				ImGui::SetNextItemWidth(250);
-				if (ImGui::BeginCombo("BLOCK_JOIN_ALERT"_T.data(), block_join_reasons[current_player->block_join_reason]))
+				if (ImGui::BeginCombo("BLOCK_JOIN_ALERT"_T.data(), block_join_reasons[player.block_join_reason]))
 				{
 					block_join_reason_t i = block_join_reason_t::UNK_0;
 					for (const auto& reason_str : block_join_reasons)
 					{
 						if (reason_str != "")
 						{
-							const bool is_selected = current_player->block_join_reason == i;
+							const bool is_selected = player.block_join_reason == i;
 
 							if (ImGui::Selectable(reason_str, is_selected))
 							{
-								current_player->block_join_reason = i;
-								g_player_database_service->save();
+								g_player_database_service->update_player(current_player, [i](persistent_player& stored) {
+									stored.block_join_reason = i;
+								});
+								g_player_database_service->save(current_player);
 							}
 
 							if (is_selected)
@@ -182,17 +217,19 @@ namespace big
 
 				ImGui::SetNextItemWidth(250);
 				if (ImGui::BeginCombo("CHAT_COMMAND_PERMISSIONS"_T.data(),
-				        COMMAND_ACCESS_LEVELS[current_player->command_access_level.value_or(g.session.chat_command_default_access_level)]))
+				        COMMAND_ACCESS_LEVELS[player.command_access_level.value_or(g.session.chat_command_default_access_level)]))
 				{
 					for (const auto& [type, name] : COMMAND_ACCESS_LEVELS)
 					{
-						if (ImGui::Selectable(name, type == current_player->command_access_level.value_or(g.session.chat_command_default_access_level)))
+						if (ImGui::Selectable(name, type == player.command_access_level.value_or(g.session.chat_command_default_access_level)))
 						{
-							current_player->command_access_level = type;
-							g_player_database_service->save();
+							g_player_database_service->update_player(current_player, [type](persistent_player& stored) {
+								stored.command_access_level = type;
+							});
+							g_player_database_service->save(current_player);
 						}
 
-						if (type == current_player->command_access_level.value_or(g.session.chat_command_default_access_level))
+						if (type == player.command_access_level.value_or(g.session.chat_command_default_access_level))
 						{
 							ImGui::SetItemDefaultFocus();
 						}
@@ -201,64 +238,75 @@ namespace big
 					ImGui::EndCombo();
 				}
 
-				if (!current_player->infractions.empty())
+				if (!player.infractions.empty())
 				{
 					ImGui::Text("INFRACTIONS"_T.data());
 
-					for (auto& infraction : current_player->infractions)
+					for (auto& infraction : player.infractions)
 					{
-						ImGui::BulletText(current_player->get_infraction_description(infraction));
+						ImGui::BulletText(player.get_infraction_description(infraction));
 					}
 				}
 
 				if (ImGui::InputTextMultiline("VIEW_NET_PLAYER_DB_NOTES"_T.data(), note_buffer, sizeof(note_buffer)))
 				{
-					current_player->notes = note_buffer;
-					notes_dirty           = true;
+					g_player_database_service->update_player(current_player, [](persistent_player& stored) {
+						stored.notes = note_buffer;
+					});
+					notes_dirty = true;
 				}
 				if (ImGui::IsItemActive())
 					g.self.hud.typing = TYPING_TICKS;
 
-				ImGui::Checkbox("VIEW_NET_PLAYER_DB_JOIN_REDIRECT"_T.data(), &current_player->join_redirect);
+				if (ImGui::Checkbox("VIEW_NET_PLAYER_DB_JOIN_REDIRECT"_T.data(), &player.join_redirect))
+				{
+					g_player_database_service->update_player(current_player, [&player](persistent_player& stored) {
+						stored.join_redirect = player.join_redirect;
+					});
+				}
 				if (ImGui::IsItemHovered())
 					ImGui::SetTooltip("VIEW_NET_PLAYER_DB_JOIN_REDIRECT_DESC"_T.data());
 
-				if (current_player->join_redirect)
+				if (player.join_redirect)
 				{
-					ImGui::SliderInt("VIEW_NET_PLAYER_DB_PREFERENCE"_T.data(), &current_player->join_redirect_preference, 1, 10);
+					if (ImGui::SliderInt("VIEW_NET_PLAYER_DB_PREFERENCE"_T.data(), &player.join_redirect_preference, 1, 10))
+					{
+						g_player_database_service->update_player(current_player, [&player](persistent_player& stored) {
+							stored.join_redirect_preference = player.join_redirect_preference;
+						});
+					}
 				}
 
-				bool joinable =
-				    player_database_service::is_joinable_session(current_player->session_type, current_player->game_mode);
+				bool joinable = player_database_service::is_joinable_session(player.session_type, player.game_mode);
 
 				ImGui::BeginDisabled(!joinable);
-				components::button("JOIN_SESSION"_T, [] {
-					session::join_by_rockstar_id(current_player->rockstar_id);
+				components::button("JOIN_SESSION"_T, [rockstar_id] {
+					session::join_by_rockstar_id(rockstar_id);
 				});
 				ImGui::EndDisabled();
 
 				ImGui::SameLine();
 
-				components::button("INVITE_PLAYER"_T, [] {
-					session::invite_by_rockstar_id(current_player->rockstar_id);
+				components::button("INVITE_PLAYER"_T, [rockstar_id] {
+					session::invite_by_rockstar_id(rockstar_id);
 				});
 
-				components::button("VIEW_PLAYER_INFO_SC_PROFILE"_T, [] {
-					session::show_profile_by_rockstar_id(current_player->rockstar_id);
+				components::button("VIEW_PLAYER_INFO_SC_PROFILE"_T, [rockstar_id] {
+					session::show_profile_by_rockstar_id(rockstar_id);
 				});
 
 				ImGui::SameLine();
 
-				components::button("SEND_FRIEND_REQUEST"_T, [] {
-					session::add_friend_by_rockstar_id(current_player->rockstar_id);
+				components::button("SEND_FRIEND_REQUEST"_T, [rockstar_id] {
+					session::add_friend_by_rockstar_id(rockstar_id);
 				});
 
 				static char message[256];
 				components::input_text("INPUT_MSG"_T, message, sizeof(message));
 				if (components::button("SEND_MSG"_T))
 				{
-					g_thread_pool->push([selected] {
-						if (g_api_service->send_socialclub_message(selected->rockstar_id, message))
+					g_thread_pool->push([rockstar_id] {
+						if (g_api_service->send_socialclub_message(rockstar_id, message))
 						{
 							g_notification_service.push_success("SCAPI"_T.data(), "MSG_SENT_SUCCESS"_T.data());
 							return;
@@ -267,25 +315,27 @@ namespace big
 					});
 				};
 
-				ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_SESSION_TYPE"_T, player_database_service::get_session_type_str(selected->session_type)).c_str());
+				ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_SESSION_TYPE"_T, player_database_service::get_session_type_str(player.session_type)).c_str());
 
-				if (selected->session_type != GSType::Invalid && selected->session_type != GSType::Unknown)
+				if (player.session_type != GSType::Invalid && player.session_type != GSType::Unknown)
 				{
-					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IS_HOST_OF_SESSION"_T, selected->is_host_of_session ? "YES"_T : "NO"_T).c_str());
-					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IS_SPECTATING"_T, selected->is_spectating ? "YES"_T : "NO"_T).c_str());
-					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IN_JOB_LOBBY"_T, selected->transition_session_id != -1 ? "YES"_T : "NO"_T).c_str());
-					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IS_HOST_OF_JOB_LOBBY"_T, selected->is_host_of_transition_session ? "YES"_T : "NO"_T).c_str());
-					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_CURRENT_MISSION_TYPE"_T, player_database_service::get_game_mode_str(selected->game_mode)).c_str());
-					if (selected->game_mode != GameMode::None && player_database_service::can_fetch_name(selected->game_mode))
+					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IS_HOST_OF_SESSION"_T, player.is_host_of_session ? "YES"_T : "NO"_T).c_str());
+					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IS_SPECTATING"_T, player.is_spectating ? "YES"_T : "NO"_T).c_str());
+					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IN_JOB_LOBBY"_T, player.transition_session_id != -1 ? "YES"_T : "NO"_T).c_str());
+					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_IS_HOST_OF_JOB_LOBBY"_T, player.is_host_of_transition_session ? "YES"_T : "NO"_T).c_str());
+					ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_CURRENT_MISSION_TYPE"_T, player_database_service::get_game_mode_str(player.game_mode)).c_str());
+					if (player.game_mode != GameMode::None && player_database_service::can_fetch_name(player.game_mode))
 					{
-						ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_CURRENT_MISSION_NAME"_T.data(), selected->game_mode_name.c_str()).c_str());
-						if ((selected->game_mode_name == "VIEW_NET_PLAYER_DB_GAME_MODE_UNKNOWN"_T.data() || selected->game_mode_name.empty())
-						    && !selected->game_mode_id.empty())
+						ImGui::Text(std::format("{}: {}", "VIEW_NET_PLAYER_DB_CURRENT_MISSION_NAME"_T.data(), player.game_mode_name.c_str()).c_str());
+						if ((player.game_mode_name == "VIEW_NET_PLAYER_DB_GAME_MODE_UNKNOWN"_T.data() || player.game_mode_name.empty())
+						    && !player.game_mode_id.empty())
 						{
 							ImGui::SameLine();
-							components::button("VIEW_DEBUG_LOCALS_FETCH"_T, [] {
-								current_player->game_mode_name =
-								    player_database_service::get_name_by_content_id(current_player->game_mode_id);
+							components::button("VIEW_DEBUG_LOCALS_FETCH"_T, [selected = current_player, game_mode_id = player.game_mode_id] {
+								std::string game_mode_name = player_database_service::get_name_by_content_id(game_mode_id);
+								g_player_database_service->update_player(selected, [&game_mode_name](persistent_player& stored) {
+									stored.game_mode_name = std::move(game_mode_name);
+								});
 							});
 						}
 					}
@@ -293,18 +343,14 @@ namespace big
 
 				if (ImGui::Button("SAVE"_T.data()))
 				{
-					if (current_player->rockstar_id != selected->rockstar_id)
-						g_player_database_service->update_rockstar_id(selected->rockstar_id, current_player->rockstar_id);
-
-					selected = current_player;
-					g_player_database_service->save();
+					g_player_database_service->save(current_player);
 				}
 
 				ImGui::SameLine();
 
 				if (ImGui::Button("REMOVE"_T.data()))
 				{
-					g_player_database_service->remove_rockstar_id(selected->rockstar_id);
+					g_player_database_service->remove_rockstar_id(rockstar_id);
 				}
 			}
 			ImGui::EndChild();
@@ -323,7 +369,6 @@ namespace big
 			{
 				g_player_database_service->set_selected(nullptr);
 				g_player_database_service->remove_filtered_players(filter_modder, filter_trust, filter_block_join, filter_track_player);
-				g_player_database_service->save();
 				ImGui::CloseCurrentPopup();
 			}
 			ImGui::SameLine();
@@ -348,10 +393,7 @@ namespace big
 
 			if (ImGui::Button("YES"_T.data()))
 			{
-				g_player_database_service->set_selected(nullptr);
-				g_player_database_service->get_players().clear();
-				g_player_database_service->get_sorted_players().clear();
-				g_player_database_service->save();
+				g_player_database_service->remove_all_players();
 				ImGui::CloseCurrentPopup();
 			}
 			ImGui::SameLine();
@@ -406,7 +448,7 @@ namespace big
 		if (ImGui::Button("ADD"_T.data()))
 		{
 			current_player = g_player_database_service->add_player(new_rockstar_id, new_name);
-			g_player_database_service->save();
+			g_player_database_service->save(current_player);
 		}
 		ImGui::SameLine();
 		if (ImGui::Button("SEARCH"_T.data()))
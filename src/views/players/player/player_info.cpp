@@ -152,8 +152,10 @@ namespace big
 			    if (ImGui::Checkbox("TRUST"_T.data(), &g_player_service->get_selected()->is_trusted))
 			    {
 				    auto entry = g_player_database_service->get_or_create_player(g_player_service->get_selected());
-				    entry->is_trusted = g_player_service->get_selected()->is_trusted;
-				    g_player_database_service->save();
+				    g_player_database_service->update_player(entry, [is_trusted = g_player_service->get_selected()->is_trusted](persistent_player& stored) {
+					    stored.is_trusted = is_trusted;
+				    });
+				    g_player_database_service->save(entry);
 			    }
 			    ImGui::Checkbox("VIEW_PLAYER_INFO_BLOCK_EXPLOSIONS"_T.data(), &g_player_service->get_selected()->block_explosions);
 			    ImGui::Checkbox("VIEW_PLAYER_INFO_BLOCK_CLONE_CREATE"_T.data(), &g_player_service->get_selected()->block_clone_create);
@@ -172,8 +174,11 @@ namespace big
 					            type == g_player_service->get_selected()->command_access_level.value_or(g.session.chat_command_default_access_level)))
 					    {
 						    g.session.chat_command_default_access_level = type;
-						    g_player_database_service->get_or_create_player(g_player_service->get_selected())->command_access_level = type;
-						    g_player_database_service->save();
+						    auto entry = g_player_database_service->get_or_create_player(g_player_service->get_selected());
+						    g_player_database_service->update_player(entry, [type](persistent_player& stored) {
+							    stored.command_access_level = type;
+						    });
+						    g_player_database_service->save(entry);
 					    }
 
 					    if (type == g_player_service->get_selected()->command_access_level.value_or(g.session.chat_command_default_access_level))
@@ -246,7 +251,7 @@ namespace big
 
 				if (CVehicleModelInfo* vehicle_model_info = static_cast<CVehicleModelInfo*>(vehicle->m_model_info))
 				{
-					vehicle_name = g_gta_data_service.vehicles()[vehicle_model_info->m_name].m_display_name; // TODO
+					vehicle_name = g_gta_data_service.vehicle_by_hash(vehicle_model_info->m_hash).m_display_name;
 				}
 
 				if (veh_damage_bits & (uint32_t)eEntityProofs::GOD)
@@ -63,14 +63,14 @@ namespace big
 			g_gui_service->set_selected(tabs::PLAYER);
 			g.window.switched_view = true;
 		}
-		if (auto rockstar_id = plyr->get_rockstar_id(); ImGui::IsItemHovered() && g_player_database_service->get_player_by_rockstar_id(rockstar_id) != nullptr)
+		if (auto entry = ImGui::IsItemHovered() ? g_player_database_service->get_player_by_rockstar_id(plyr->get_rockstar_id()) : nullptr)
 		{
-			auto sorted_player = g_player_database_service->get_player_by_rockstar_id(rockstar_id);
-			if (!sorted_player->infractions.empty())
+			auto sorted_player = g_player_database_service->get_player_copy(entry);
+			if (!sorted_player.infractions.empty())
 			{
 				ImGui::BeginTooltip();
-				for (auto infraction : sorted_player->infractions)
-					ImGui::BulletText(sorted_player->get_infraction_description(infraction));
+				for (auto infraction : sorted_player.infractions)
+					ImGui::BulletText(sorted_player.get_infraction_description(infraction));
 				ImGui::EndTooltip();
 			}
 		}
@@ -70,7 +70,7 @@ namespace big
 		if (ImGui::BeginPopup("##weapons_popup", ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove))
 		{
 			std::map<std::string, weapon_item> sorted_map;
-			for (const auto& [_, weapon] : g_gta_data_service.weapons())
+			for (const auto& weapon : g_gta_data_service.weapons())
 			{
 				sorted_map.emplace(weapon.m_display_name, weapon);
 			}
@@ -275,12 +275,12 @@ namespace big
 				if (ImGui::BeginCombo("GUI_TAB_WEAPONS"_T.data(), weapon.m_display_name.c_str()))
 				{
 					std::map<std::string, weapon_item> sorted_map;
-					for (const auto& [_, weapon_iter] : g_gta_data_service.weapons())
+					for (const auto& weapon_iter : g_gta_data_service.weapons())
 					{
 						sorted_map.emplace(weapon_iter.m_display_name, weapon_iter);
 					}
 
-					for (const auto& [_, weapon_iter] : g_gta_data_service.weapons())
+					for (const auto& weapon_iter : g_gta_data_service.weapons())
 					{
 						if (weapon_iter.m_display_name == "NULL")
 							continue;
@@ -100,7 +100,7 @@ namespace big
 		components::command_checkbox<"nosway">();
 
 		components::button("GET_ALL_WEAPONS"_T, [] {
-			for (const auto& [_, weapon] : g_gta_data_service.weapons())
+			for (const auto& weapon : g_gta_data_service.weapons())
 			{
 				WEAPON::GIVE_DELAYED_WEAPON_TO_PED(self::ped, weapon.m_hash, 9999, false);
 			}
@@ -108,7 +108,7 @@ namespace big
 		});
 		ImGui::SameLine();
 		components::button("REMOVE_ALL_WEAPONS"_T, [] {
-			for (const auto& [_, weapon] : g_gta_data_service.weapons())
+			for (const auto& weapon : g_gta_data_service.weapons())
 			{
 				if (weapon.m_hash != "WEAPON_UNARMED"_J)
 					WEAPON::REMOVE_WEAPON_FROM_PED(self::ped, weapon.m_hash);
@@ -64,14 +64,12 @@ namespace big
 		ImGui::SetNextItemWidth(300.f);
 		components::input_text_with_hint("MODEL_NAME"_T, "SEARCH"_T, search, sizeof(search), ImGuiInputTextFlags_None);
 
-		vehicle_map calculated_map{};
+		std::vector<const vehicle_item*> calculated_map{};
 
 		if (g_gta_data_service.vehicles().size() > 0)
 		{
-			for (auto& item : g_gta_data_service.vehicles())
+			for (const auto& vehicle : g_gta_data_service.vehicles())
 			{
-				const auto& vehicle = item.second;
-
 				std::string display_name         = vehicle.m_display_name;
 				std::string display_manufacturer = vehicle.m_display_manufacturer;
 				std::string clazz                = vehicle.m_vehicle_class;
@@ -85,7 +83,7 @@ namespace big
 				if ((selected_class == -1 || class_arr[selected_class] == clazz)
 				    && (display_name.find(lower_search) != std::string::npos || display_manufacturer.find(lower_search) != std::string::npos))
 				{
-					calculated_map.emplace(item);
+					calculated_map.push_back(&vehicle);
 				}
 			}
 		}
@@ -162,9 +160,9 @@ namespace big
 
 			if (calculated_map.size() > 0)
 			{
-				for (auto& item : calculated_map)
+				for (const auto item : calculated_map)
 				{
-					const auto& vehicle = item.second;
+					const auto& vehicle = *item;
 					const auto vehicle_hash = vehicle.m_hash;
 					ImGui::PushID(vehicle_hash);
 					components::selectable(vehicle.m_display_name, false, [vehicle_hash] {
@@ -29,7 +29,7 @@ namespace big
 		}
 
 		const auto& weapon_type_arr = g_gta_data_service.weapon_types();
-		for (auto& [_, weapon] : g_gta_data_service.weapons())
+		for (const auto& weapon : g_gta_data_service.weapons())
 		{
 			if (selected_ped_weapon_type == SPAWN_PED_ALL_WEAPONS || weapon.m_weapon_type == weapon_type_arr[selected_ped_weapon_type])
 			{
@@ -195,10 +195,10 @@ namespace big
 		static Player selected_ped_player_id = -1;
 
 		auto& ped_type_arr = g_gta_data_service.ped_types();
-		auto& ped_arr      = g_gta_data_service.peds();
+		const auto ped_arr = g_gta_data_service.peds();
 
-		auto& weapon_type_arr = g_gta_data_service.weapon_types();
-		auto& weapon_arr      = g_gta_data_service.weapons();
+		auto& weapon_type_arr  = g_gta_data_service.weapon_types();
+		const auto& weapon_arr = g_gta_data_service.weapons();
 
 		static Player selected_ped_for_player_id = -1;
 		auto& player_arr                         = g_player_service->players();
@@ -378,7 +378,7 @@ namespace big
 							ImGui::BringWindowToDisplayFront(ImGui::GetCurrentWindow());
 							ped_model_dropdown_focused |= ImGui::IsWindowFocused();
 
-							for (const auto& [_, item] : ped_arr)
+							for (const auto& item : ped_arr)
 							{
 								std::string ped_type = item.m_ped_type;
 								std::string name     = item.m_name;
@@ -503,7 +503,7 @@ namespace big
 							ImGui::SetItemDefaultFocus();
 						}
 
-						for (const auto& [_, weapon] : weapon_arr)
+						for (const auto& weapon : weapon_arr)
 						{
 							if (selected_ped_weapon_type == SPAWN_PED_ALL_WEAPONS || weapon.m_weapon_type == weapon_type_arr[selected_ped_weapon_type])
 							{
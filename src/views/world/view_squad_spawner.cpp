@@ -121,15 +121,15 @@ namespace big
 		components::input_text_with_hint("##name", "NAME"_T, new_template.m_name);
 		components::input_text_with_hint("##pedmodel", "PED_MODEL"_T, new_template.m_ped_model);
 
-		auto ped_found = std::find_if(g_gta_data_service.peds().begin(), g_gta_data_service.peds().end(), [=](const auto& pair) {
-			return pair.second.m_name == new_template.m_ped_model;
+		const auto ped_found = std::ranges::any_of(g_gta_data_service.peds(), [&](const ped_item& item) {
+			return item.m_name == new_template.m_ped_model;
 		});
 
-		if (!new_template.m_ped_model.empty() && ped_found == g_gta_data_service.peds().end())
+		if (!new_template.m_ped_model.empty() && !ped_found)
 		{
 			if (ImGui::BeginListBox("##pedlist", ImVec2(250, 200)))
 			{
-				for (auto& p : g_gta_data_service.peds() | std::ranges::views::values)
+				for (const auto& p : g_gta_data_service.peds())
 				{
 					std::string p_model = p.m_name;
 					std::string filter  = new_template.m_ped_model;
@@ -149,15 +149,15 @@ namespace big
 		if (ImGui::IsItemHovered())
 			ImGui::SetTooltip("VIEW_SQUAD_SPAWNER_VEHICLE_TOOLTIP"_T.data());
 
-		auto veh_found = std::find_if(g_gta_data_service.vehicles().begin(), g_gta_data_service.vehicles().end(), [=](const auto& pair) {
-			return pair.second.m_name == new_template.m_vehicle_model;
+		const auto veh_found = std::ranges::any_of(g_gta_data_service.vehicles(), [&](const vehicle_item& item) {
+			return item.m_name == new_template.m_vehicle_model;
 		});
 
-		if (!new_template.m_vehicle_model.empty() && veh_found == g_gta_data_service.vehicles().end())
+		if (!new_template.m_vehicle_model.empty() && !veh_found)
 		{
 			if (ImGui::BeginListBox("##vehlist", ImVec2(250, 200)))
 			{
-				for (auto& p : g_gta_data_service.vehicles() | std::ranges::views::values)
+				for (const auto& p : g_gta_data_service.vehicles())
 				{
 					std::string p_model = p.m_name;
 					std::string filter  = new_template.m_vehicle_model;
@@ -177,15 +177,15 @@ namespace big
 		if (ImGui::IsItemHovered())
 			ImGui::SetTooltip("VIEW_SQUAD_SPAWNER_WEAPON_MODEL_TOOLTIP"_T.data());
 
-		auto weap_found = std::find_if(g_gta_data_service.weapons().begin(), g_gta_data_service.weapons().end(), [=](const auto& pair) {
-			return pair.second.m_name == new_template.m_weapon_model;
+		const auto weap_found = std::ranges::any_of(g_gta_data_service.weapons(), [&](const weapon_item& item) {
+			return item.m_name == new_template.m_weapon_model;
 		});
 
-		if (!new_template.m_weapon_model.empty() && weap_found == g_gta_data_service.weapons().end())
+		if (!new_template.m_weapon_model.empty() && !weap_found)
 		{
 			if (ImGui::BeginListBox("##weaplist", ImVec2(250, 200)))
 			{
-				for (auto& p : g_gta_data_service.weapons() | std::ranges::views::values)
+				for (const auto& p : g_gta_data_service.weapons())
 				{
 					std::string p_model = p.m_name;
 					std::string filter  = new_template.m_weapon_model;
@@ -0,0 +1,84 @@
+// Per lookup cost of vehicle_by_hash and friends: the linear scan over name keyed maps they used to do
+// against the hash_index stored in the gta data cache, for hits and for hashes that aren't in the data.
+
+#include "services/gta_data/hash_index.hpp"
+#include "services/gta_data/vehicle_item.hpp"
+#include "test.hpp"
+
+#include <random>
+
+using namespace big;
+
+// about as many vehicles as the game currently has, the other item types are in the same range
+static constexpr std::size_t ITEM_COUNT = 900;
+static constexpr std::size_t LOOKUPS    = 200'000;
+
+int main()
+{
+	std::mt19937 rng(1);
+
+	std::map<std::string, vehicle_item> by_name;
+	std::vector<uint32_t> hashes;
+	while (by_name.size() < ITEM_COUNT)
+	{
+		vehicle_item item{};
+		item.m_hash = rng();
+		std::snprintf(item.m_name, sizeof(item.m_name), "veh%08x", item.m_hash);
+		if (by_name.emplace(item.m_name, item).second)
+			hashes.push_back(item.m_hash);
+	}
+
+	// a second name with an existing hash, the first one in name order has to win like it did with the linear scan
+	vehicle_item duplicate = by_name.begin()->second;
+	std::strcpy(duplicate.m_name, "zzz_duplicate");
+	by_name.emplace(duplicate.m_name, duplicate);
+
+	// name sorted array plus index, the layout of the cache sections
+	std::vector<vehicle_item> items;
+	for (const auto& [name, item] : by_name)
+		items.push_back(item);
+	const auto entries = hash_index<vehicle_item>::build(items);
+	const hash_index<vehicle_item> index(items, entries);
+
+	auto linear_find = [&](uint32_t hash) -> const vehicle_item* {
+		for (const auto& [name, item] : by_name)
+			if (item.m_hash == hash)
+				return &item;
+		return nullptr;
+	};
+
+	for (auto hash : hashes)
+	{
+		const auto expected = linear_find(hash);
+		const auto found    = index.find(hash);
+		CHECK(found && expected && !std::strcmp(found->m_name, expected->m_name));
+	}
+
+	std::vector<uint32_t> misses;
+	while (misses.size() < 1000)
+		if (const auto hash = static_cast<uint32_t>(rng()); !linear_find(hash))
+			misses.push_back(hash);
+
+	for (auto hash : misses)
+		CHECK(!index.find(hash));
+
+	std::printf("%-8s %12s %12s %8s\n", "lookup", "linear ns", "index ns", "speedup");
+	for (const auto& [name, keys] : {std::pair{"hit", &hashes}, std::pair{"miss", &misses}})
+	{
+		volatile uintptr_t sink = 0;
+
+		std::size_t i       = 0;
+		const auto linear_ns = test::time_ns([&] {
+			sink = sink + reinterpret_cast<uintptr_t>(linear_find((*keys)[i++ % keys->size()]));
+		}, LOOKUPS / 20);
+
+		i                   = 0;
+		const auto index_ns = test::time_ns([&] {
+			sink = sink + reinterpret_cast<uintptr_t>(index.find((*keys)[i++ % keys->size()]));
+		}, LOOKUPS);
+
+		std::printf("%-8s %12.1f %12.1f %7.0fx\n", name, linear_ns, index_ns, linear_ns / index_ns);
+	}
+
+	return test::result();
+}
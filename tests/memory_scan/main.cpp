@@ -0,0 +1,133 @@
+// Benchmarks range::scan and range::scan_all on a synthetic 100 MB buffer against the scalar scanners
+// they replaced, and checks that every path reports the same offsets.
+
+#include "memory/pattern.hpp"
+#include "memory/range.hpp"
+#include "memory/static_pattern.hpp"
+#include "test.hpp"
+
+#include <random>
+
+namespace memory
+{
+	// Boyer-Moore-Horspool scanner in range.cpp, the fallback for cpus without vector support
+	std::optional<handle> scan_pattern(const std::optional<uint8_t>* sig, std::size_t length, handle begin, std::size_t module_size);
+}
+
+using namespace big;
+
+static constexpr std::size_t BUFFER_SIZE = 100 * 1024 * 1024;
+
+static std::vector<std::size_t> brute_force_all(const std::vector<uint8_t>& buffer, const memory::pattern& sig)
+{
+	std::vector<std::size_t> result;
+	const auto length = sig.m_bytes.size();
+	for (std::size_t i = 0; i + length <= buffer.size(); ++i)
+	{
+		bool match = true;
+		for (std::size_t j = 0; j < length && match; ++j)
+			match = !sig.m_bytes[j] || *sig.m_bytes[j] == buffer[i + j];
+
+		if (match)
+			result.push_back(i);
+	}
+	return result;
+}
+
+static std::optional<std::size_t> offset_of(const memory::range& range, std::optional<memory::handle> result)
+{
+	if (!result)
+		return std::nullopt;
+	return result->as<uint8_t*>() - range.begin().as<uint8_t*>();
+}
+
+int main()
+{
+	// x86 like byte distribution: plenty of 0x48/0x8B/0xE8 so the anchor bytes keep hitting
+	std::mt19937 rng(1);
+	std::vector<uint8_t> buffer(BUFFER_SIZE);
+	constexpr uint8_t common_bytes[] = {0x48, 0x8B, 0x89, 0xE8, 0x00, 0xFF, 0x83, 0xC4};
+	for (auto& byte : buffer)
+		byte = rng() % 3 ? common_bytes[rng() % std::size(common_bytes)] : static_cast<uint8_t>(rng());
+
+	const memory::range range(buffer.data(), buffer.size());
+
+	// planted once close to the end so the whole buffer has to be walked
+	const char* planted = "48 8D 0D ? ? ? ? E8 ? ? ? ? 45 33 C9 41 B0 ? B2";
+	const auto planted_offset = BUFFER_SIZE - 4096;
+	{
+		const memory::pattern sig(planted);
+		for (std::size_t i = 0; i < sig.m_bytes.size(); ++i)
+			buffer[planted_offset + i] = sig.m_bytes[i].value_or(0x90);
+	}
+
+	struct scan_case
+	{
+		const char* m_name;
+		const char* m_sig;
+	};
+	const scan_case cases[] = {
+	    {"planted", planted},
+	    {"absent", "48 8B 0D ? ? ? ? 4C 8B CE E8 ? ? ? ? 48 85 C0 74 05 40 32 FF"},
+	    {"wildcard near tail", "48 89 5C 24 08 57 48 83 EC 20 8B ? 11"},
+	    {"short", "E8 ? ? ? ? 8A 57 39"},
+	};
+
+	std::printf("%-20s %12s %12s %8s\n", "pattern", "scalar ms", "vector ms", "speedup");
+	for (const auto& c : cases)
+	{
+		const memory::pattern sig(c.m_sig);
+
+		std::optional<memory::handle> scalar_result, vector_result;
+		const auto scalar_ns = test::time_ns([&] {
+			scalar_result = memory::scan_pattern(sig.m_bytes.data(), sig.m_bytes.size(), range.begin(), range.size());
+		});
+		const auto vector_ns = test::time_ns([&] {
+			vector_result = range.scan(sig);
+		});
+
+		CHECK(offset_of(range, scalar_result) == offset_of(range, vector_result));
+		std::printf("%-20s %12.2f %12.2f %7.1fx\n", c.m_name, scalar_ns / 1e6, vector_ns / 1e6, scalar_ns / vector_ns);
+	}
+	CHECK(offset_of(range, range.scan(memory::pattern(planted))) == planted_offset);
+
+	// scan_all against the byte by byte loop it replaced
+	{
+		const memory::pattern sig("48 8B ? 89");
+
+		std::vector<std::size_t> expected;
+		std::vector<memory::handle> found;
+		const auto scalar_ns = test::time_ns([&] {
+			expected = brute_force_all(buffer, sig);
+		});
+		const auto vector_ns = test::time_ns([&] {
+			found = range.scan_all(sig);
+		});
+
+		CHECK(found.size() == expected.size());
+		for (std::size_t i = 0; i < std::min(found.size(), expected.size()); ++i)
+			CHECK(offset_of(range, found[i]) == expected[i]);
+
+		std::printf("%-20s %12.2f %12.2f %7.1fx (%zu hits)\n", "scan_all", scalar_ns / 1e6, vector_ns / 1e6, scalar_ns / vector_ns, found.size());
+	}
+
+	// patterns with less than two fixed bytes take the scalar fallback, which has to reach the very last offset
+	{
+		std::vector<uint8_t> small{0x01, 0x02, 0x03, 0x04};
+		const memory::range small_range(small.data(), small.size());
+
+		const auto tail = small_range.scan_all(memory::pattern("? 04"));
+		CHECK(tail.size() == 1 && offset_of(small_range, tail[0]) == 2);
+		memory::pattern wildcards("01");
+		wildcards.m_bytes.assign(2, std::nullopt);
+		CHECK(small_range.scan_all(wildcards).size() == 3);
+		CHECK(small_range.scan_all(memory::pattern("? ? ? ? 05")).empty());
+		CHECK(!small_range.scan(memory::pattern("? ? ? ? 05")));
+		CHECK(!memory::scan_pattern(memory::pattern("01 02 03 04 05").m_bytes.data(), 5, small_range.begin(), small_range.size()));
+
+		const auto simd_tail = small_range.scan_all(memory::pattern("03 04"));
+		CHECK(simd_tail.size() == 1 && offset_of(small_range, simd_tail[0]) == 2);
+	}
+
+	return test::result();
+}
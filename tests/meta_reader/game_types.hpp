@@ -0,0 +1,5 @@
+#pragma once
+
+// Force included next to the common.hpp stand-in, the game types the gta data headers expect to be around.
+
+using Hash = std::uint32_t;
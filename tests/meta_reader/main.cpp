@@ -0,0 +1,143 @@
+// Parses the sample .meta files in fixtures/ with meta_reader and parse_meta_files and checks what comes out,
+// then measures the parse time of a synthetic vehicles.meta about the size of the largest ones in the game.
+
+#include "gta/joaat.hpp"
+#include "services/gta_data/meta_parser.hpp"
+#include "services/gta_data/meta_reader.hpp"
+#include "test.hpp"
+
+using namespace big;
+
+static meta_file load(meta_file_kind kind, const char* path, RPFDatafileSource source = RPFDatafileSource::UNKNOWN)
+{
+	std::ifstream file(std::filesystem::path("fixtures") / path, std::ios::binary);
+	CHECK(file.is_open());
+
+	meta_file result{kind, 0, source};
+	result.m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return result;
+}
+
+static void check_fixtures()
+{
+	std::vector<meta_file> files;
+	files.push_back(load(meta_file_kind::VEHICLES, "vehicles.meta"));
+	files.push_back(load(meta_file_kind::WEAPON_COMPONENTS, "weaponcomponents.meta"));
+	files.push_back(load(meta_file_kind::WEAPONS, "weapons.meta", RPFDatafileSource::DLC));
+	files.push_back(load(meta_file_kind::PEDS, "peds.meta"));
+	// malformed files are dropped as a whole
+	files.push_back(load(meta_file_kind::PEDS, "peds_truncated.meta"));
+	files.push_back(load(meta_file_kind::PEDS, "peds_mismatched.meta"));
+	files.push_back({meta_file_kind::PED_MODEL, 1, RPFDatafileSource::UNKNOWN, "mp_m_freemode_01"});
+
+	const auto results = parse_meta_files(std::move(files));
+	CHECK(results.size() == 2);
+	if (results.size() != 2)
+		return;
+
+	const auto& result = results[0];
+
+	CHECK(result.m_vehicles.size() == 2);
+	if (result.m_vehicles.size() == 2)
+	{
+		const auto& adder = result.m_vehicles[0];
+		CHECK(!std::strcmp(adder.m_name, "ADDER"));
+		CHECK(!std::strcmp(adder.m_display_name, "ADDER"));
+		CHECK(!std::strcmp(adder.m_display_manufacturer, "TRUFFADE"));
+		CHECK(!std::strcmp(adder.m_vehicle_class, "SUPER"));
+		CHECK(adder.m_hash == "adder"_J);
+		// entities are decoded and only the first modelName counts
+		CHECK(!std::strcmp(result.m_vehicles[1].m_name, "T&20"));
+	}
+
+	CHECK(result.m_weapon_components.size() == 2);
+	if (result.m_weapon_components.size() == 2)
+	{
+		CHECK(result.m_weapon_components[0].m_name == "COMPONENT_PISTOL_CLIP_01");
+		CHECK(result.m_weapon_components[0].m_loc_desc == "WCD_P_CLIP1");
+		CHECK(result.m_weapon_components[1].m_name == "COMPONENT_AT_SCOPE");
+		CHECK(result.m_weapon_components[1].m_loc_desc.empty());
+	}
+
+	CHECK(result.m_weapons.size() == 3);
+	if (result.m_weapons.size() == 3)
+	{
+		const auto& pistol = result.m_weapons[0];
+		CHECK(pistol.m_name == "WEAPON_PISTOL");
+		CHECK(pistol.m_weapon_type == "PISTOL");
+		CHECK(pistol.m_display_name == "WT_PIST");
+		CHECK(pistol.rpf_file_type == RPFDatafileSource::DLC);
+		CHECK(!pistol.m_throwable);
+		CHECK((pistol.m_attachments == std::vector<std::string>{"COMPONENT_PISTOL_CLIP_01", "COMPONENT_PISTOL_CLIP_02", "COMPONENT_AT_PI_FLSH"}));
+		CHECK(pistol.m_reward_hash == "REWARD_WEAPON_PISTOL"_J);
+		CHECK(pistol.m_reward_ammo_hash == "REWARD_AMMO_PISTOL"_J);
+
+		const auto& grenade = result.m_weapons[1];
+		CHECK(grenade.m_throwable);
+		CHECK(grenade.m_reward_hash == "REWARD_WEAPON_GRENADE"_J);
+		CHECK(grenade.m_reward_ammo_hash == 0);
+
+		CHECK(result.m_weapons[2].m_weapon_type == "MELEE");
+		CHECK(result.m_weapons[2].m_reward_hash == "REWARD_WEAPON_KNIFE"_J);
+	}
+
+	CHECK(result.m_peds.size() == 1 && !std::strcmp(result.m_peds[0].m_ped_type, "ANIMAL"));
+	CHECK(results[1].m_rpf == 1 && results[1].m_peds.size() == 1);
+	CHECK(!results[1].m_peds.empty() && !std::strcmp(results[1].m_peds[0].m_name, "mp_m_freemode_01"));
+}
+
+static void check_reader()
+{
+	{
+		meta_reader reader("<a x = 'y &amp;' z=\"1\"><![CDATA[<raw>]]>tail&#x41;&#66;</a>");
+		CHECK(reader.next_child() && reader.name() == "a");
+		// attributes are returned raw
+		CHECK(reader.attribute("x") == "y &amp;");
+		CHECK(reader.attribute("z") == "1");
+		CHECK(reader.attribute("w").empty());
+		CHECK(reader.text() == "<raw>");
+		CHECK(!reader.next_child() && !reader.failed());
+	}
+	{
+		meta_reader reader("<a>x&#65;\r\ny</a>");
+		CHECK(reader.next_child());
+		CHECK(reader.text() == "xA\ny");
+	}
+	{
+		meta_reader reader("junk<a/>");
+		CHECK(!reader.next_child() && reader.failed());
+	}
+}
+
+static void benchmark()
+{
+	constexpr size_t ITEMS = 20'000;
+
+	std::string data = "<CVehicleModelInfo__InitDataList><InitDatas>";
+	for (size_t i = 0; i < ITEMS; ++i)
+		data += "<Item><modelName>veh" + std::to_string(i)
+		    + "</modelName><txdName>x</txdName><handlingId>H</handlingId><gameName>G</gameName><vehicleMakeName>M</vehicleMakeName>"
+		      "<lodDistances content=\"float_array\">1 2 3 4 5 6</lodDistances><flags>FLAG_A FLAG_B</flags><vehicleClass>VC_SPORT</vehicleClass>"
+		      "<firstPersonDrivebyData><Item>A</Item><Item>B</Item></firstPersonDrivebyData></Item>";
+	data += "</InitDatas></CVehicleModelInfo__InitDataList>";
+
+	size_t parsed = 0;
+	const auto ns = test::time_ns([&] {
+		std::vector<meta_file> files;
+		files.push_back({meta_file_kind::VEHICLES});
+		files.back().m_data.assign(data.begin(), data.end());
+		parsed = parse_meta_files(std::move(files))[0].m_vehicles.size();
+	});
+	CHECK(parsed == ITEMS);
+
+	std::printf("%zu vehicles, %zu KB in %.2f ms (%.0f MB/s)\n", ITEMS, data.size() / 1024, ns / 1e6, data.size() / (ns / 1e9) / (1024 * 1024));
+}
+
+int main()
+{
+	check_fixtures();
+	check_reader();
+	benchmark();
+
+	return test::result();
+}
@@ -0,0 +1,186 @@
+// Simulates crashes at every point player_database_journal can be interrupted at and checks that loading afterwards
+// gives back every change that was completely written, plus coalescing and compaction of queued writes.
+
+#include "services/player_database/player_database_journal.hpp"
+#include "test.hpp"
+#include "thread_pool.hpp"
+
+using namespace big;
+
+static const auto g_directory     = std::filesystem::temp_directory_path() / "yim_player_database_journal";
+static const auto g_snapshot_path = g_directory / "players.json";
+static const auto g_journal_path  = g_directory / "players.journal";
+
+static std::string read_file(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+static void write_file(const std::filesystem::path& path, std::string_view data)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(data.data(), data.size());
+}
+
+static std::unordered_map<uint64_t, nlohmann::json> load()
+{
+	player_database_journal journal(g_snapshot_path, g_journal_path);
+	return journal.load();
+}
+
+static nlohmann::json player(std::string name)
+{
+	return {{"name", std::move(name)}};
+}
+
+static void check_name(const std::unordered_map<uint64_t, nlohmann::json>& players, uint64_t rockstar_id, std::string_view name)
+{
+	const auto it = players.find(rockstar_id);
+	CHECK(it != players.end() && it->second.value("name", "") == name);
+}
+
+static void check_coalescing(thread_pool& pool)
+{
+	// the snapshot format predates the journal, an existing database has to be picked up as is
+	write_file(g_snapshot_path, R"({"1":{"name":"a"},"2":{"name":"b"}})");
+
+	player_database_journal journal(g_snapshot_path, g_journal_path);
+	const auto players = journal.load();
+	CHECK(players.size() == 2);
+	check_name(players, 1, "a");
+
+	journal.put(3, player("c"));
+	journal.put(3, player("c2"));
+	journal.remove(1);
+	CHECK(pool.pending() == 1);
+	pool.run();
+
+	// only the last change to a player is written
+	const auto data = read_file(g_journal_path);
+	CHECK(std::count(data.begin(), data.end(), '\n') == 2);
+
+	// left queued, the destructor has to write it
+	journal.put(4, player("d"));
+}
+
+static void check_torn_entry()
+{
+	{
+		player_database_journal journal(g_snapshot_path, g_journal_path);
+		journal.load();
+		journal.put(10, player("complete"));
+		journal.flush();
+		journal.put(11, player("torn"));
+		journal.flush();
+	}
+
+	// crash halfway through writing the last entry
+	const auto journal_size = std::filesystem::file_size(g_journal_path);
+	const auto last_entry   = read_file(g_journal_path).rfind('{', journal_size - 2);
+	std::filesystem::resize_file(g_journal_path, last_entry + (journal_size - last_entry) / 2);
+	// and a half written snapshot from an interrupted compaction
+	write_file(g_snapshot_path.string() + ".tmp", "{\"1\":{\"na");
+
+	{
+		player_database_journal journal(g_snapshot_path, g_journal_path);
+		const auto players = journal.load();
+		check_name(players, 10, "complete");
+		CHECK(!players.contains(11));
+
+		// whatever comes after the torn entry must not get glued to it
+		journal.put(12, player("after"));
+		journal.flush();
+	}
+
+	const auto players = load();
+	check_name(players, 10, "complete");
+	check_name(players, 12, "after");
+	CHECK(!players.contains(11));
+}
+
+static void check_rename_before_truncate()
+{
+	{
+		player_database_journal journal(g_snapshot_path, g_journal_path);
+		journal.load();
+		journal.put(20, player("kept"));
+		journal.put(21, player("removed later"));
+		journal.flush();
+		journal.remove(21);
+		journal.put(22, player("renamed"));
+		journal.flush();
+		journal.put(22, player("renamed again"));
+		journal.flush();
+	}
+	const auto journal_before = read_file(g_journal_path);
+	CHECK(!journal_before.empty());
+
+	// loading folds the journal into a new snapshot
+	const auto expected = load();
+	CHECK(read_file(g_journal_path).empty());
+
+	// crash after the new snapshot got renamed into place but before the journal was truncated
+	write_file(g_journal_path, journal_before);
+
+	const auto players = load();
+	CHECK(players == expected);
+	check_name(players, 20, "kept");
+	check_name(players, 22, "renamed again");
+	CHECK(!players.contains(21));
+}
+
+static void check_compaction(thread_pool& pool)
+{
+	player_database_journal journal(g_snapshot_path, g_journal_path);
+	journal.load();
+
+	const std::string notes(1000, 'x');
+	for (uint64_t i = 0; i < 200; i++)
+	{
+		journal.put(100 + i, {{"name", "p" + std::to_string(i)}, {"notes", notes}});
+		pool.run();
+	}
+	CHECK(std::filesystem::file_size(g_journal_path) < std::filesystem::file_size(g_snapshot_path));
+
+	journal.reset({{7, player("only")}});
+	pool.run();
+	CHECK(std::filesystem::file_size(g_journal_path) == 0);
+}
+
+int main()
+{
+	thread_pool pool;
+	g_thread_pool = &pool;
+
+	std::filesystem::remove_all(g_directory);
+	std::filesystem::create_directories(g_directory);
+
+	check_coalescing(pool);
+	pool.discard();
+	{
+		const auto players = load();
+		CHECK(players.size() == 3);
+		check_name(players, 3, "c2");
+		check_name(players, 4, "d");
+		CHECK(!players.contains(1));
+		// folded into the snapshot while loading
+		CHECK(read_file(g_journal_path).empty());
+	}
+
+	check_torn_entry();
+	pool.discard();
+
+	check_rename_before_truncate();
+	pool.discard();
+
+	check_compaction(pool);
+	{
+		const auto players = load();
+		CHECK(players.size() == 1);
+		check_name(players, 7, "only");
+	}
+
+	std::filesystem::remove_all(g_directory);
+	return test::result();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// Stand-in for the thread pool that queues jobs until the test runs them, so it decides when writes hit the disk.
+
+namespace big
+{
+	class thread_pool
+	{
+		std::vector<std::function<void()>> m_jobs;
+
+	public:
+		template<typename F>
+		void push(F&& func)
+		{
+			m_jobs.emplace_back(std::forward<F>(func));
+		}
+
+		size_t pending() const
+		{
+			return m_jobs.size();
+		}
+
+		void run()
+		{
+			auto jobs = std::move(m_jobs);
+			m_jobs.clear();
+			for (auto& job : jobs)
+				job();
+		}
+
+		void discard()
+		{
+			m_jobs.clear();
+		}
+	};
+
+	inline thread_pool* g_thread_pool{};
+}
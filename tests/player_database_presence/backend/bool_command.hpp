@@ -0,0 +1,12 @@
+#pragma once
+
+namespace big
+{
+	class bool_command
+	{
+	public:
+		bool_command(const char*, const char*, const char*, bool&)
+		{
+		}
+	};
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace big
+{
+	// project files end up in a temporary directory
+	class file_manager
+	{
+	public:
+		class file
+		{
+			std::filesystem::path m_path;
+
+		public:
+			explicit file(std::filesystem::path path) :
+			    m_path(std::move(path))
+			{
+			}
+
+			const std::filesystem::path& get_path() const
+			{
+				return m_path;
+			}
+		};
+
+		std::filesystem::path m_base = std::filesystem::temp_directory_path() / "yim_player_database_presence";
+
+		file get_project_file(std::filesystem::path path) const
+		{
+			return file(m_base / path.filename());
+		}
+	};
+	inline file_manager g_file_manager;
+}
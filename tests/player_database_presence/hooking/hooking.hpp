@@ -0,0 +1,28 @@
+#pragma once
+
+namespace big
+{
+	struct hooks
+	{
+		static bool update_presence_attribute_int(void*, int, char*, uint64_t)
+		{
+			return true;
+		}
+
+		static bool update_presence_attribute_string(void*, int, char*, char*)
+		{
+			return true;
+		}
+	};
+
+	class hooking
+	{
+	public:
+		template<auto detour>
+		static auto get_original()
+		{
+			return detour;
+		}
+	};
+	inline hooking* g_hooking{};
+}
@@ -0,0 +1,206 @@
+// Drives player_database_service::update_player_states against a stand-in for the presence attribute endpoint
+// that answers with canned results, and checks the online states and update intervals that come out of it,
+// including queries that fail to start or come back failed.
+
+#include "file_manager.hpp"
+#include "gta/enums.hpp"
+#include "pointers.hpp"
+#include "services/player_database/player_database_service.hpp"
+#include "test.hpp"
+#include "util/session.hpp"
+
+using namespace big;
+using clock_type = std::chrono::steady_clock;
+
+// what the endpoint answers for a player
+struct presence
+{
+	GSType m_session_type = GSType::Invalid;
+	// empty when not in a session, decoded as the session token otherwise
+	std::string m_session_info;
+	bool m_is_host = false;
+};
+
+struct fake_endpoint
+{
+	struct request
+	{
+		std::vector<uint64_t> m_rockstar_ids;
+		rage::rlQueryPresenceAttributesContext** m_contexts;
+		rage::rlScTaskStatus* m_status;
+	};
+
+	std::unordered_map<uint64_t, presence> m_presence;
+	bool m_start_fails = false;
+	// status a request finishes with, 3 is success
+	int m_result_status = 3;
+
+	size_t m_started = 0;
+	std::vector<request> m_pending;
+
+	void answer()
+	{
+		for (auto& request : m_pending)
+		{
+			for (size_t i = 0; i < request.m_rockstar_ids.size(); i++)
+			{
+				const auto& state = m_presence[request.m_rockstar_ids[i]];
+				auto contexts     = request.m_contexts[i];
+
+				CHECK(!std::strcmp(contexts[0].m_presence_attribute_key, "gstype"));
+				CHECK(!std::strcmp(contexts[1].m_presence_attribute_key, "gsinfo"));
+
+				contexts[0].m_presence_attribute_int_value = static_cast<int>(state.m_session_type);
+				std::strcpy(contexts[1].m_presence_attribute_string_value, state.m_session_info.c_str());
+				contexts[3].m_presence_attribute_int_value = state.m_is_host;
+				contexts[8].m_presence_attribute_int_value = static_cast<int>(GameMode::None);
+			}
+			request.m_status->status = m_result_status;
+		}
+		m_pending.clear();
+	}
+};
+static fake_endpoint g_endpoint;
+
+static bool start_get_presence_attributes(int, rage::rlScHandle* handles, int count, rage::rlQueryPresenceAttributesContext** contexts, int, rage::rlScTaskStatus* status)
+{
+	g_endpoint.m_started++;
+	if (g_endpoint.m_start_fails)
+		return false;
+
+	fake_endpoint::request request{{}, contexts, status};
+	for (int i = 0; i < count; i++)
+		request.m_rockstar_ids.push_back(handles[i].m_rockstar_id);
+
+	status->status = 1;
+	g_endpoint.m_pending.push_back(std::move(request));
+	return true;
+}
+
+static bool decode_session_info(rage::rlSessionInfo* info, char* buffer, int*)
+{
+	info->m_session_token = std::strtoull(buffer, nullptr, 10);
+	return true;
+}
+
+static persistent_player get(player_database_service& service, uint64_t rockstar_id)
+{
+	return service.get_player_copy(service.get_player_by_rockstar_id(rockstar_id));
+}
+
+// next_state_update has to be interval after the query finished, somewhere between before and now
+static void check_next_update(const persistent_player& player, clock_type::time_point before, std::chrono::seconds interval)
+{
+	CHECK(player.next_state_update >= before + interval);
+	CHECK(player.next_state_update <= clock_type::now() + interval);
+}
+
+static std::shared_ptr<persistent_player> add_tracked(player_database_service& service, uint64_t rockstar_id, const char* name)
+{
+	auto player = service.add_player(rockstar_id, name);
+	service.update_player(player, [](persistent_player& player) {
+		player.notify_online = true;
+	});
+	return player;
+}
+
+int main()
+{
+	thread_pool pool;
+	g_thread_pool = &pool;
+
+	void* presence_data = nullptr;
+	pointers fakes{};
+	fakes.m_gta.m_decode_session_info          = decode_session_info;
+	fakes.m_gta.m_presence_data                = &presence_data;
+	fakes.m_sc.m_start_get_presence_attributes = start_get_presence_attributes;
+	g_pointers                                 = &fakes;
+
+	script::s_on_yield = [] {
+		g_endpoint.answer();
+	};
+
+	std::filesystem::remove_all(g_file_manager.m_base);
+	std::filesystem::create_directories(g_file_manager.m_base);
+	{
+		player_database_service service;
+
+		add_tracked(service, 1, "online");
+		add_tracked(service, 2, "offline");
+		service.add_player(3, "untracked");
+		g_endpoint.m_presence[1] = {GSType::Public, "100", true};
+		g_endpoint.m_presence[2] = {GSType::Invalid, ""};
+
+		// first answer for everyone that is tracked
+		auto before = clock_type::now();
+		service.update_player_states(true);
+		CHECK(g_endpoint.m_started == 1);
+
+		const auto online = get(service, 1);
+		CHECK(online.session_type == GSType::Public);
+		CHECK(online.session_id == 100);
+		CHECK(online.is_host_of_session);
+		check_next_update(online, before, std::chrono::seconds(45));
+
+		// offline since forever, asked for at the longest interval
+		const auto offline = get(service, 2);
+		CHECK(offline.session_type == GSType::Invalid);
+		check_next_update(offline, before, std::chrono::seconds(300));
+
+		CHECK(get(service, 3).session_type == GSType::Unknown);
+		CHECK(g_notification_service.m_messages.size() == 1 && g_notification_service.m_messages[0] == "online is now in a joinable session");
+
+		// nobody is due yet
+		service.update_player_states(true);
+		CHECK(g_endpoint.m_started == 1);
+
+		// a change shortens the interval and shows up in the snapshot once it has been rebuilt
+		g_endpoint.m_presence[1] = {GSType::Invalid, ""};
+		before                   = clock_type::now();
+		service.update_player_states(false);
+		CHECK(g_endpoint.m_started == 2);
+		check_next_update(get(service, 1), before, std::chrono::seconds(15));
+		CHECK(get(service, 3).session_type == GSType::Invalid);
+
+		pool.run();
+		const auto snapshot = service.get_snapshot();
+		CHECK(snapshot->size() == 3);
+		for (uint32_t i = 0; i < snapshot->size(); i++)
+			CHECK(snapshot->get(i).m_session_type == GSType::Invalid);
+
+		// a query that can't be started pushes its players back instead of being retried on every tick
+		add_tracked(service, 4, "start fails");
+		g_endpoint.m_start_fails = true;
+		before                   = clock_type::now();
+		service.update_player_states(true);
+		CHECK(g_endpoint.m_started == 3);
+		check_next_update(get(service, 4), before, std::chrono::seconds(45));
+		CHECK(get(service, 4).session_type == GSType::Unknown);
+
+		service.update_player_states(true);
+		CHECK(g_endpoint.m_started == 3);
+		g_endpoint.m_start_fails = false;
+
+		// same for one that fails on the endpoint
+		add_tracked(service, 5, "request fails");
+		g_endpoint.m_result_status = 2;
+		before                     = clock_type::now();
+		service.update_player_states(true);
+		CHECK(g_endpoint.m_started == 4);
+		check_next_update(get(service, 5), before, std::chrono::seconds(45));
+
+		service.update_player_states(true);
+		CHECK(g_endpoint.m_started == 4);
+
+		// postponing never brings a longer interval forward
+		const auto offline_update = get(service, 2).next_state_update;
+		service.update_player_states(false);
+		CHECK(get(service, 2).next_state_update == offline_update);
+		g_endpoint.m_result_status = 3;
+
+		pool.discard();
+	}
+	std::filesystem::remove_all(g_file_manager.m_base);
+
+	return test::result();
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+// Force included after the common.hpp stand-in, what the real common.hpp pulls in for the player database service:
+// the settings, notifications, translations and the few game types the presence query is made of.
+
+#define WM_KEYDOWN 0x0100
+#define WM_KEYUP 0x0101
+
+#include "core/enums.hpp"
+
+namespace rage
+{
+	using joaat_t = std::uint32_t;
+
+	struct rlScHandle
+	{
+		rlScHandle(uint64_t rockstar_id) :
+		    m_rockstar_id(rockstar_id)
+		{
+		}
+
+		uint64_t m_rockstar_id;
+	};
+
+	struct rlScTaskStatus
+	{
+		int status;
+		int error_code;
+	};
+
+	struct rlQueryPresenceAttributesContext
+	{
+		char m_presence_attribute_key[64];
+		char m_presence_attribute_string_value[256];
+		uint64_t m_presence_attribute_int_value;
+		uint32_t m_presence_attibute_type;
+	};
+
+	struct rlSessionInfo
+	{
+		uint64_t m_unk;
+		uint64_t m_session_token;
+	};
+}
+
+#if !__has_include(<format>)
+// GCC before 13 has no <format>, the service only ever formats with plain {} placeholders
+namespace std
+{
+	template<typename T>
+	void format_next(std::ostringstream& out, std::string_view& rest, const T& arg)
+	{
+		const auto pos = rest.find("{}");
+		out << rest.substr(0, pos) << arg;
+		rest.remove_prefix(pos + 2);
+	}
+
+	template<typename... Args>
+	std::string format(std::string_view fmt, const Args&... args)
+	{
+		std::ostringstream out;
+		(format_next(out, fmt, args), ...);
+		out << fmt;
+		return out.str();
+	}
+}
+#endif
+
+namespace big
+{
+	struct menu_settings
+	{
+		struct player_db
+		{
+			bool update_player_online_states   = false;
+			bool notify_when_online            = false;
+			bool notify_when_joinable          = true;
+			bool notify_when_unjoinable        = false;
+			bool notify_when_offline           = false;
+			bool notify_on_session_type_change = false;
+			bool notify_on_session_change      = false;
+			bool notify_on_spectator_change    = false;
+			bool notify_on_become_host         = false;
+			bool notify_on_transition_change   = false;
+			bool notify_on_mission_change      = false;
+		} player_db{};
+	};
+	inline menu_settings g{};
+
+	// keeps every notification so the test can check what the user would have seen
+	class notification_service
+	{
+	public:
+		std::vector<std::string> m_messages;
+
+		void push(const std::string&, const std::string& message)
+		{
+			m_messages.push_back(message);
+		}
+
+		void push_success(const std::string& title, const std::string& message)
+		{
+			push(title, message);
+		}
+	};
+	inline notification_service g_notification_service;
+
+	template<size_t N>
+	struct translation_key
+	{
+		constexpr translation_key(const char (&key)[N])
+		{
+			std::copy_n(key, N, m_key);
+		}
+
+		char m_key[N];
+	};
+
+	// no translations loaded, keys come back as is
+	template<translation_key T>
+	constexpr std::string_view operator""_T()
+	{
+		return T.m_key;
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+// Only the functions the player database service calls, the test points them at its fakes.
+
+namespace big
+{
+	struct pointers
+	{
+		struct
+		{
+			bool (*m_encode_session_info)(rage::rlSessionInfo* info, char* buffer, int buffer_size, int* bytes_written);
+			bool (*m_decode_session_info)(rage::rlSessionInfo* out_info, char* buffer, int* bytes_read);
+			void** m_presence_data;
+		} m_gta{};
+
+		struct
+		{
+			bool (*m_start_get_presence_attributes)(int profile_index, rage::rlScHandle* handle, int num_handles, rage::rlQueryPresenceAttributesContext** contexts, int count, rage::rlScTaskStatus* state);
+		} m_sc{};
+	};
+	inline pointers* g_pointers{};
+}
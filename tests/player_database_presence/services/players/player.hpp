@@ -0,0 +1,19 @@
+#pragma once
+
+namespace big
+{
+	class player
+	{
+	public:
+		uint64_t get_rockstar_id() const
+		{
+			return 0;
+		}
+
+		const char* get_name() const
+		{
+			return "";
+		}
+	};
+	using player_ptr = std::shared_ptr<player>;
+}
@@ -0,0 +1,3 @@
+#pragma once
+// the journal and the snapshot rebuild only run when the test asks for it
+#include "../player_database_journal/thread_pool.hpp"
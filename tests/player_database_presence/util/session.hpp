@@ -0,0 +1,64 @@
+#pragma once
+#include "thread_pool.hpp"
+
+// Fiber and native stand-ins, the update loop is driven by calling update_player_states from the test.
+
+namespace big
+{
+	class script
+	{
+	public:
+		// called wherever the service yields, the test answers the presence queries in flight from here
+		inline static std::function<void()> s_on_yield;
+
+		static script* get_current()
+		{
+			static script current;
+			return &current;
+		}
+
+		void yield()
+		{
+			if (s_on_yield)
+				s_on_yield();
+		}
+	};
+
+	enum class fiber_job_priority
+	{
+		LOW
+	};
+
+	class fiber_pool
+	{
+	public:
+		template<typename F>
+		void queue_job(F&&, fiber_job_priority)
+		{
+		}
+	};
+	inline fiber_pool* g_fiber_pool{};
+}
+
+namespace NETWORK
+{
+	inline bool UGC_QUERY_BY_CONTENT_ID(const char*, bool, const char*)
+	{
+		return false;
+	}
+
+	inline bool UGC_IS_GETTING()
+	{
+		return false;
+	}
+
+	inline bool UGC_DID_GET_SUCCEED()
+	{
+		return false;
+	}
+
+	inline const char* UGC_GET_CONTENT_NAME(int)
+	{
+		return "";
+	}
+}
@@ -0,0 +1,150 @@
+// Drives rate_limiter with a fake clock and checks bursts, the even refill, flood reporting and the limits
+// shared by all players, then measures the cost of process() on the allowed and the dropped path.
+
+#include "services/players/rate_limiter.hpp"
+#include "test.hpp"
+
+using namespace big;
+
+static const auto start = rate_limiter::clock::time_point(100h);
+
+static void check_burst_and_refill()
+{
+	rate_limiter limiter{1s, 3};
+
+	// the whole burst is available at once
+	CHECK(!limiter.process(start));
+	CHECK(!limiter.process(start));
+	CHECK(!limiter.process(start));
+	CHECK(limiter.process(start));
+
+	// and comes back one attempt every period / attempts instead of all at once after a full period
+	CHECK(limiter.process(start + 300ms));
+	CHECK(!limiter.process(start + 334ms));
+	CHECK(limiter.process(start + 400ms));
+	CHECK(!limiter.process(start + 667ms));
+	CHECK(!limiter.process(start + 1000ms));
+	CHECK(limiter.process(start + 1000ms));
+
+	// a quiet period refills the burst but never beyond it
+	CHECK(!limiter.process(start + 10s));
+	CHECK(!limiter.process(start + 10s));
+	CHECK(!limiter.process(start + 10s));
+	CHECK(limiter.process(start + 10s));
+}
+
+static void check_flood_reporting()
+{
+	rate_limiter limiter{1s, 2};
+
+	CHECK(!limiter.process(start));
+	CHECK(!limiter.exceeded_last_process());
+	CHECK(!limiter.process(start));
+
+	// only the first drop of a flood is reported
+	CHECK(limiter.process(start) && limiter.exceeded_last_process());
+	CHECK(limiter.process(start + 100ms) && !limiter.exceeded_last_process());
+
+	// allowed attempts in between don't end the flood, drops keep coming within a period of each other
+	CHECK(!limiter.process(start + 600ms) && !limiter.exceeded_last_process());
+	CHECK(limiter.process(start + 700ms) && !limiter.exceeded_last_process());
+
+	// a full period without drops starts a new flood that gets reported again
+	CHECK(!limiter.process(start + 5s));
+	CHECK(!limiter.process(start + 5s));
+	CHECK(limiter.process(start + 5s) && limiter.exceeded_last_process());
+}
+
+static void check_shared_limit()
+{
+	const auto event  = rate_limited_event::RADIO_REQUEST;
+	const auto& stats = g_rate_limits.get_stats(event);
+
+	// a full session bursting at its per player limit gets through
+	std::vector<rate_limiter> players(MAX_PLAYERS, rate_limiter{5s, 2, event});
+	for (auto& player : players)
+	{
+		CHECK(!player.process(start));
+		CHECK(!player.process(start));
+	}
+	CHECK(stats.m_allowed == 2 * MAX_PLAYERS);
+
+	// so do 25 more from senders without a player, what receive_net_message allows for unknown players over 5 seconds
+	// anything beyond that is within the limit of its sender but gets shed, without being reported as flooding
+	std::vector<rate_limiter> unknown(35, rate_limiter{5s, 2, event});
+	for (size_t i = 0; i < unknown.size(); i++)
+	{
+		CHECK(unknown[i].process(start) == (i >= 25));
+		CHECK(!unknown[i].exceeded_last_process());
+	}
+	CHECK(stats.m_allowed == 2 * MAX_PLAYERS + 25);
+	CHECK(stats.m_shed == 10);
+	CHECK(stats.m_dropped == 0);
+
+	// going over the own limit counts as dropped and never reaches the shared one
+	CHECK(players[0].process(start + 1s));
+	CHECK(players[0].exceeded_last_process());
+	CHECK(stats.m_dropped == 1);
+	CHECK(stats.m_shed == 10);
+
+	// other events have their own shared limit and counters
+	CHECK(g_rate_limits.get_stats(rate_limited_event::PLAY_SOUND).m_allowed == 0);
+
+	// limiters without an event are never counted
+	rate_limiter plain{1s, 1};
+	CHECK(!plain.process(start));
+	CHECK(plain.process(start));
+	CHECK(stats.m_allowed == 2 * MAX_PLAYERS + 25);
+	CHECK(stats.m_dropped == 1);
+}
+
+static void check_concurrent()
+{
+	rate_limiter limiter{10s, 1000};
+
+	std::atomic<int> allowed = 0;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 8; i++)
+		threads.emplace_back([&] {
+			for (int j = 0; j < 1000; j++)
+				if (!limiter.process(start))
+					allowed++;
+		});
+	for (auto& thread : threads)
+		thread.join();
+
+	// every attempt of the burst is handed out exactly once
+	CHECK(allowed == 1000);
+}
+
+int main()
+{
+	check_burst_and_refill();
+	check_flood_reporting();
+	check_shared_limit();
+	check_concurrent();
+
+	constexpr size_t ITERATIONS = 1'000'000;
+
+	rate_limiter allowing{1s, 1, rate_limited_event::PLAY_SOUND};
+	auto now = start;
+	const auto allowed_ns = test::time_ns([&] {
+		for (size_t i = 0; i < ITERATIONS; i++)
+		{
+			now += 1s;
+			allowing.process(now);
+		}
+	});
+
+	rate_limiter dropping{1s, 1, rate_limited_event::PLAY_SOUND};
+	const auto dropped_ns = test::time_ns([&] {
+		for (size_t i = 0; i < ITERATIONS; i++)
+			dropping.process(start);
+	});
+
+	std::printf("%-10s %10s\n", "path", "ns/call");
+	std::printf("%-10s %10.1f\n", "allowed", allowed_ns / ITERATIONS);
+	std::printf("%-10s %10.1f\n", "dropped", dropped_ns / ITERATIONS);
+
+	return test::result();
+}
@@ -0,0 +1,76 @@
+#!/usr/bin/env bash
+# Builds and runs the standalone tests and benchmarks with the system compiler (GCC or Clang on Linux).
+# The menu itself only builds with MSVC, these cover the parts that don't depend on the game.
+#
+# usage: tests/run.sh [test...]
+#   CXX           compiler to use, defaults to g++
+#   JSON_INCLUDE  include directory containing nlohmann/json.hpp when it isn't installed system wide
+
+set -euo pipefail
+
+root="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+build="$root/tests/_build"
+cxx="${CXX:-g++}"
+
+# name -> sources under src/ compiled into the test
+declare -A sources=(
+	[gta_data_hash_index]=""
+	[memory_scan]="memory/range.cpp memory/pattern.cpp"
+	[meta_reader]="services/gta_data/meta_reader.cpp services/gta_data/meta_parser.cpp"
+	[player_database_journal]="services/player_database/player_database_journal.cpp"
+	[player_database_presence]="services/player_database/player_database_service.cpp services/player_database/player_database_journal.cpp services/player_database/player_database_snapshot.cpp"
+	[rate_limiter]=""
+	[script_code_index]="util/script_code_index.cpp memory/pattern.cpp"
+	[script_location_cache]="services/script_patcher/script_location_cache.cpp services/gta_data/cache_file.cpp util/script_code_index.cpp memory/pattern.cpp file_manager/file.cpp"
+	[thread_pool]="thread_pool.cpp"
+)
+
+# name -> extra compiler flags
+declare -A flags=(
+	[memory_scan]="-mavx2 -msse4.2 -mxsave"
+	[meta_reader]="-include game_types.hpp"
+	[player_database_presence]="-include menu_stubs.hpp"
+	[script_location_cache]="-include game_types.hpp"
+	[thread_pool]="-std=c++23"
+)
+
+common_flags=(-std=c++20 -O2 -g -pthread -I"$root/tests/support" -I"$root/src" -include "$root/tests/support/common.hpp")
+if [[ -n "${JSON_INCLUDE:-}" ]]; then
+	common_flags+=(-I"$JSON_INCLUDE")
+fi
+
+tests=("$@")
+if [[ ${#tests[@]} -eq 0 ]]; then
+	mapfile -t tests < <(printf '%s\n' "${!sources[@]}" | sort)
+fi
+
+mkdir -p "$build"
+failed=()
+for name in "${tests[@]}"; do
+	if [[ -z "${sources[$name]+x}" ]]; then
+		echo "unknown test: $name" >&2
+		exit 1
+	fi
+
+	echo "== $name"
+	files=("$root/tests/$name/main.cpp")
+	for file in ${sources[$name]}; do
+		files+=("$root/src/$file")
+	done
+
+	# the test directory comes first so stubs placed there replace headers from src
+	# shellcheck disable=SC2086
+	if ! "$cxx" -I"$root/tests/$name" "${common_flags[@]}" ${flags[$name]:-} "${files[@]}" -o "$build/$name"; then
+		failed+=("$name")
+		continue
+	fi
+
+	if ! (cd "$root/tests/$name" && "$build/$name"); then
+		failed+=("$name")
+	fi
+done
+
+if [[ ${#failed[@]} -ne 0 ]]; then
+	echo "failed: ${failed[*]}" >&2
+	exit 1
+fi
@@ -0,0 +1,189 @@
+// Compares resolving a script's patterns through script_code_index against the per pattern scan over the code pages
+// it replaced, and checks that both find the same first locations, also for patterns crossing page boundaries.
+
+#include "util/script_code_index.hpp"
+#include "test.hpp"
+
+#include <random>
+
+using namespace big;
+
+static constexpr uint32_t PAGE_SIZE = script_code_index::PAGE_SIZE;
+
+// code split into separately allocated pages like the game does
+struct program
+{
+	std::vector<std::unique_ptr<uint8_t[]>> m_pages;
+	std::vector<uint8_t*> m_page_pointers;
+	rage::scrProgram m_program{};
+
+	explicit program(const std::vector<uint8_t>& code)
+	{
+		for (uint32_t offset = 0; offset < code.size(); offset += PAGE_SIZE)
+		{
+			m_pages.push_back(std::make_unique<uint8_t[]>(PAGE_SIZE));
+			std::memcpy(m_pages.back().get(), code.data() + offset, std::min<size_t>(PAGE_SIZE, code.size() - offset));
+			m_page_pointers.push_back(m_pages.back().get());
+		}
+		m_program.m_code_blocks = m_page_pointers.data();
+		m_program.m_code_size   = static_cast<uint32_t>(code.size());
+	}
+};
+
+static std::optional<uint32_t> brute_force(const std::vector<uint8_t>& code, const memory::pattern& pattern)
+{
+	for (size_t i = 0; i + pattern.m_bytes.size() <= code.size(); i++)
+	{
+		bool match = true;
+		for (size_t j = 0; j < pattern.m_bytes.size() && match; j++)
+			match = !pattern.m_bytes[j] || *pattern.m_bytes[j] == code[i + j];
+
+		if (match)
+			return static_cast<uint32_t>(i);
+	}
+	return std::nullopt;
+}
+
+// scripts::get_code_location_by_pattern before the index, one walk over the whole program per pattern
+static std::optional<uint32_t> legacy_find(rage::scrProgram* program, const memory::pattern& pattern)
+{
+	uint32_t code_size = program->m_code_size;
+	for (uint32_t i = 0; i < (code_size - pattern.m_bytes.size()); i++)
+	{
+		for (uint32_t j = 0; j < pattern.m_bytes.size(); j++)
+			if (pattern.m_bytes[j].has_value())
+				if (pattern.m_bytes[j].value() != *program->get_code_address(i + j))
+					goto incorrect;
+
+		return i;
+	incorrect:
+		continue;
+	}
+
+	return std::nullopt;
+}
+
+// bytecode like distribution, a few opcodes make up most of the code
+static std::vector<uint8_t> make_code(std::mt19937& rng, size_t size)
+{
+	constexpr uint8_t common_bytes[] = {0x00, 0x01, 0x2C, 0x38, 0x39, 0x43, 0x5D, 0x62, 0x6F, 0x72};
+
+	std::vector<uint8_t> code(size);
+	for (auto& byte : code)
+		byte = rng() % 4 ? common_bytes[rng() % std::size(common_bytes)] : static_cast<uint8_t>(rng());
+	return code;
+}
+
+// taken from the code at a random location with some bytes masked, or random when absent is set
+static memory::pattern make_pattern(std::mt19937& rng, const std::vector<uint8_t>& code, size_t length, size_t location, bool absent)
+{
+	memory::pattern pattern("00");
+	pattern.m_bytes.clear();
+	for (size_t i = 0; i < length; i++)
+	{
+		if (rng() % 4 == 0)
+			pattern.m_bytes.push_back(std::nullopt);
+		else if (absent || location + i >= code.size())
+			pattern.m_bytes.push_back(static_cast<uint8_t>(rng()));
+		else
+			pattern.m_bytes.push_back(code[location + i]);
+	}
+	return pattern;
+}
+
+static void check_locations()
+{
+	std::mt19937 rng(1);
+
+	// page sized programs are the ones where the last page reports a size of 0
+	const size_t sizes[] = {1, 17, PAGE_SIZE - 1, PAGE_SIZE, PAGE_SIZE + 1, 3 * PAGE_SIZE, 5 * PAGE_SIZE + 123, 100'000};
+	for (const auto size : sizes)
+	{
+		for (int round = 0; round < 20; round++)
+		{
+			const auto code = make_code(rng, size);
+			program prog(code);
+
+			std::vector<memory::pattern> patterns;
+			for (int i = 0; i < 24; i++)
+			{
+				// around page boundaries and the end of the code as much as anywhere else
+				size_t location = rng() % size;
+				if (i % 3 == 0)
+					location = std::min<size_t>(size - 1, (rng() % (size / PAGE_SIZE + 1)) * PAGE_SIZE + PAGE_SIZE - 1 - rng() % 4);
+				else if (i % 3 == 1)
+					location = size - 1 - rng() % std::min<size_t>(size, 8);
+
+				patterns.push_back(make_pattern(rng, code, rng() % 12 + 1, location, i % 8 == 7));
+			}
+
+			std::vector<const memory::pattern*> pattern_pointers;
+			for (const auto& pattern : patterns)
+				pattern_pointers.push_back(&pattern);
+
+			const script_code_index from_pages(prog.m_page_pointers.data(), prog.m_program.m_code_size);
+			const script_code_index from_program(&prog.m_program);
+			const auto found_pages   = from_pages.find(pattern_pointers);
+			const auto found_program = from_program.find(pattern_pointers);
+
+			for (size_t i = 0; i < patterns.size(); i++)
+			{
+				const auto expected = brute_force(code, patterns[i]);
+				CHECK(found_pages[i] == expected);
+				CHECK(found_program[i] == expected);
+				CHECK(from_pages.find(patterns[i]) == expected);
+			}
+		}
+	}
+
+	// an empty pattern list and a pattern longer than the code
+	const auto code = make_code(rng, 64);
+	program prog(code);
+	const script_code_index index(&prog.m_program);
+	CHECK(index.find(std::span<const memory::pattern* const>{}).empty());
+	CHECK(!index.find(make_pattern(rng, code, 65, 0, false)));
+}
+
+int main()
+{
+	check_locations();
+
+	// freemode is around 6 MB, with a few dozen patches and script functions to resolve when it loads
+	constexpr size_t CODE_SIZE     = 6 * 1024 * 1024;
+	constexpr size_t PATTERN_COUNT = 48;
+
+	std::mt19937 rng(2);
+	const auto code = make_code(rng, CODE_SIZE);
+	program prog(code);
+
+	std::vector<memory::pattern> patterns;
+	for (size_t i = 0; i < PATTERN_COUNT; i++)
+		patterns.push_back(make_pattern(rng, code, rng() % 16 + 8, rng() % CODE_SIZE, i % 8 == 7));
+
+	std::vector<const memory::pattern*> pattern_pointers;
+	for (const auto& pattern : patterns)
+		pattern_pointers.push_back(&pattern);
+
+	std::vector<std::optional<uint32_t>> legacy(PATTERN_COUNT), indexed;
+	const auto legacy_ns = test::time_ns([&] {
+		for (size_t i = 0; i < PATTERN_COUNT; i++)
+			legacy[i] = legacy_find(&prog.m_program, patterns[i]);
+	});
+	const auto indexed_ns = test::time_ns([&] {
+		const script_code_index index(&prog.m_program);
+		indexed = index.find(pattern_pointers);
+	});
+
+	for (size_t i = 0; i < PATTERN_COUNT; i++)
+	{
+		CHECK(legacy[i] == brute_force(code, patterns[i]));
+		CHECK(indexed[i] == legacy[i]);
+	}
+
+	std::printf("%-24s %12s\n", "resolve 48 patterns", "ms");
+	std::printf("%-24s %12.2f\n", "per pattern scan", legacy_ns / 1e6);
+	std::printf("%-24s %12.2f\n", "script_code_index", indexed_ns / 1e6);
+	std::printf("speedup %.1fx\n", legacy_ns / indexed_ns);
+
+	return test::result();
+}
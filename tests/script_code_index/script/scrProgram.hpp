@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+// Only the code page accessors of rage::scrProgram, with the same page math as the game's.
+
+namespace rage
+{
+	class scrProgram
+	{
+	public:
+		uint8_t** m_code_blocks;
+		uint32_t m_code_size;
+
+		uint32_t get_num_code_pages() const
+		{
+			return (m_code_size + 0x3FFF) >> 14;
+		}
+
+		// like the game's, this is 0 for the last page when the code size is a multiple of the page size
+		uint32_t get_code_page_size(uint32_t page) const
+		{
+			auto num = get_num_code_pages();
+			if (page < num)
+			{
+				if (page == num - 1)
+					return m_code_size & 0x3FFF;
+				return 0x4000;
+			}
+
+			return 0;
+		}
+
+		uint8_t* get_code_page(uint32_t page) const
+		{
+			return m_code_blocks[page];
+		}
+
+		uint8_t* get_code_address(uint32_t index) const
+		{
+			if (index < m_code_size)
+				return &m_code_blocks[index >> 14][index & 0x3FFF];
+
+			return nullptr;
+		}
+	};
+}
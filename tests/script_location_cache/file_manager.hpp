@@ -0,0 +1,16 @@
+#pragma once
+
+// Stand-in for file_manager.hpp, file::move() is the only part of file.cpp that reaches into it.
+
+namespace big
+{
+	class file_manager
+	{
+	public:
+		static std::filesystem::path ensure_file_can_be_created(const std::filesystem::path file_path)
+		{
+			std::filesystem::create_directories(file_path.parent_path());
+			return file_path;
+		}
+	};
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Force included next to the common.hpp stand-in, the script hash type the cache is keyed by.
+
+namespace rage
+{
+	using joaat_t = std::uint32_t;
+}
@@ -0,0 +1,223 @@
+// Checks when script_location_cache reuses a cached location and when it has to scan again, across instances sharing
+// the cache file, and compares resolving a script's patterns from a cold cache against a warm one.
+
+#include "services/script_patcher/script_location_cache.hpp"
+#include "util/script_code_index.hpp"
+#include "test.hpp"
+
+#include <random>
+
+using namespace big;
+
+static const auto cache_path = std::filesystem::temp_directory_path() / "yim_script_location_cache" / "script_locations.bin";
+
+static constexpr rage::joaat_t SCRIPT = 0x5700179C;
+
+// code split into pages the way the game hands it out
+struct code
+{
+	std::vector<uint8_t> m_bytes;
+	std::vector<const uint8_t*> m_pages;
+
+	explicit code(std::vector<uint8_t> bytes) :
+	    m_bytes(std::move(bytes))
+	{
+		for (size_t offset = 0; offset < m_bytes.size(); offset += script_code_index::PAGE_SIZE)
+			m_pages.push_back(m_bytes.data() + offset);
+	}
+
+	uint32_t size() const
+	{
+		return static_cast<uint32_t>(m_bytes.size());
+	}
+
+	uint64_t hash() const
+	{
+		return script_location_cache::get_code_hash(m_pages.data(), size());
+	}
+
+	std::vector<std::optional<uint32_t>> find(script_location_cache& cache, std::span<const memory::pattern* const> patterns, rage::joaat_t script = SCRIPT) const
+	{
+		return cache.find(script, hash(), m_pages.data(), size(), patterns);
+	}
+};
+
+static std::vector<uint8_t> random_bytes(std::mt19937& rng, size_t size)
+{
+	std::vector<uint8_t> bytes(size);
+	for (auto& byte : bytes)
+		byte = static_cast<uint8_t>(rng());
+	return bytes;
+}
+
+// the bytes at location with every fourth one masked
+static memory::pattern pattern_at(const std::vector<uint8_t>& bytes, size_t location, size_t length)
+{
+	memory::pattern pattern("00");
+	pattern.m_bytes.clear();
+	for (size_t i = 0; i < length; i++)
+		pattern.m_bytes.push_back(i % 4 == 3 ? std::nullopt : std::optional<uint8_t>(bytes[location + i]));
+	return pattern;
+}
+
+static void check_reuse()
+{
+	std::mt19937 rng(1);
+	code script(random_bytes(rng, 100'000));
+
+	// the second one crosses from the first page into the second
+	const auto first  = pattern_at(script.m_bytes, 5000, 8);
+	const auto second = pattern_at(script.m_bytes, script_code_index::PAGE_SIZE - 3, 8);
+	const memory::pattern absent("01 02 03 04 05 06 07 08 09");
+	const memory::pattern* patterns[]{&first, &second, &absent};
+
+	const std::vector<std::optional<uint32_t>> expected{5000u, script_code_index::PAGE_SIZE - 3, std::nullopt};
+
+	{
+		script_location_cache cache(cache_path);
+		CHECK(script.find(cache, patterns) == expected);
+		CHECK(std::filesystem::exists(cache_path));
+	}
+
+	// a copy of the first pattern placed earlier, under the old hash, only shows whether the cached location got used
+	auto planted = script.m_bytes;
+	std::memcpy(planted.data() + 100, script.m_bytes.data() + 5000, 8);
+	code same_hash(planted);
+	{
+		script_location_cache cache(cache_path);
+		CHECK(cache.find(SCRIPT, script.hash(), same_hash.m_pages.data(), same_hash.size(), patterns) == expected);
+
+		// other scripts don't share locations
+		CHECK(same_hash.find(cache, patterns, SCRIPT + 1)[0] == 100u);
+	}
+
+	// a script update changes the hash, every pattern gets scanned for again and the new locations replace the old ones
+	CHECK(same_hash.hash() != script.hash());
+	{
+		script_location_cache cache(cache_path);
+		CHECK(same_hash.find(cache, patterns)[0] == 100u);
+	}
+	{
+		script_location_cache cache(cache_path);
+		CHECK(same_hash.find(cache, patterns)[0] == 100u);
+		CHECK(script.find(cache, patterns) == expected);
+	}
+
+	// a cached location that doesn't match in place anymore is never handed out, even if the hash claims the code is the same
+	auto broken = script.m_bytes;
+	broken[5000] ^= 0xFF;
+	code changed_in_place(broken);
+	{
+		script_location_cache cache(cache_path);
+		CHECK(!cache.find(SCRIPT, script.hash(), changed_in_place.m_pages.data(), changed_in_place.size(), patterns)[0]);
+	}
+
+	// patterns running past the end of the code are neither cached nor found
+	const auto tail = pattern_at(script.m_bytes, script.size() - 4, 4);
+	memory::pattern past_end = tail;
+	past_end.m_bytes.push_back(0x00);
+	const memory::pattern* tail_patterns[]{&tail, &past_end};
+	{
+		script_location_cache cache(cache_path);
+		const auto found = script.find(cache, tail_patterns);
+		CHECK(found[0] == script.size() - 4);
+		CHECK(!found[1]);
+	}
+}
+
+static void check_damaged_cache()
+{
+	std::mt19937 rng(2);
+	code script(random_bytes(rng, 20'000));
+	const auto pattern = pattern_at(script.m_bytes, 1234, 8);
+	const memory::pattern* patterns[]{&pattern};
+
+	{
+		script_location_cache cache(cache_path);
+		CHECK(script.find(cache, patterns)[0] == 1234u);
+	}
+
+	// a cache with a size that isn't a whole number of entries is thrown away and rebuilt
+	std::filesystem::resize_file(cache_path, std::filesystem::file_size(cache_path) - 1);
+	{
+		std::fstream file(cache_path, std::ios::in | std::ios::out | std::ios::binary);
+		uint32_t header[4]{};
+		file.read(reinterpret_cast<char*>(header), sizeof(header));
+		header[2] -= 1;
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+	}
+	{
+		script_location_cache cache(cache_path);
+		CHECK(script.find(cache, patterns)[0] == 1234u);
+	}
+
+	// as is one written with another layout of the entries
+	{
+		std::fstream file(cache_path, std::ios::in | std::ios::out | std::ios::binary);
+		const uint32_t other_format = 0xFFFF;
+		file.write(reinterpret_cast<const char*>(&other_format), sizeof(other_format));
+	}
+	{
+		script_location_cache cache(cache_path);
+		CHECK(script.find(cache, patterns)[0] == 1234u);
+	}
+	{
+		std::ifstream file(cache_path, std::ios::binary);
+		uint32_t format{};
+		file.read(reinterpret_cast<char*>(&format), sizeof(format));
+		CHECK(format != 0xFFFF);
+	}
+}
+
+int main()
+{
+	std::filesystem::remove_all(cache_path.parent_path());
+	std::filesystem::create_directories(cache_path.parent_path());
+
+	check_reuse();
+	check_damaged_cache();
+
+	// freemode sized code with a few dozen patches and script functions, as resolved every time it loads
+	constexpr size_t CODE_SIZE     = 6 * 1024 * 1024;
+	constexpr size_t PATTERN_COUNT = 48;
+
+	std::mt19937 rng(3);
+	code script(random_bytes(rng, CODE_SIZE));
+
+	std::vector<memory::pattern> patterns;
+	for (size_t i = 0; i < PATTERN_COUNT; i++)
+		patterns.push_back(pattern_at(script.m_bytes, rng() % (CODE_SIZE - 16), 16));
+
+	std::vector<const memory::pattern*> pattern_pointers;
+	for (const auto& pattern : patterns)
+		pattern_pointers.push_back(&pattern);
+
+	std::filesystem::remove(cache_path);
+
+	uint64_t hash = 0;
+	const auto hash_ns = test::time_ns([&] {
+		hash = script.hash();
+	});
+
+	std::vector<std::optional<uint32_t>> cold, warm;
+	const auto cold_ns = test::time_ns([&] {
+		script_location_cache cache(cache_path);
+		cold = cache.find(SCRIPT, hash, script.m_pages.data(), script.size(), pattern_pointers);
+	});
+	const auto warm_ns = test::time_ns([&] {
+		script_location_cache cache(cache_path);
+		warm = cache.find(SCRIPT, hash, script.m_pages.data(), script.size(), pattern_pointers);
+	});
+
+	CHECK(cold == warm);
+	CHECK(cold == script_code_index(script.m_pages.data(), script.size()).find(pattern_pointers));
+
+	std::printf("%-24s %12s\n", "resolve 48 patterns", "ms");
+	std::printf("%-24s %12.2f\n", "code hash", hash_ns / 1e6);
+	std::printf("%-24s %12.2f\n", "cold cache", cold_ns / 1e6);
+	std::printf("%-24s %12.2f\n", "warm cache", warm_ns / 1e6);
+
+	std::filesystem::remove_all(cache_path.parent_path());
+	return test::result();
+}
@@ -0,0 +1,3 @@
+#pragma once
+// only the code page accessors are used, through script_code_index.hpp
+#include "../../script_code_index/script/scrProgram.hpp"
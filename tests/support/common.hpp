@@ -0,0 +1,124 @@
+#ifndef COMMON_INC
+#define COMMON_INC
+
+// Stand-in for src/common.hpp, force included into every translation unit built by tests/run.sh.
+// It shares the include guard with the real header, so sources that include "../common.hpp" pick this one up instead.
+// Only the standard library, nlohmann::json and a LOG macro writing to stderr are provided,
+// anything else a test needs from the game or the menu is stubbed next to the test itself.
+
+// clang-format off
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <chrono>
+#include <ctime>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include <memory>
+#include <new>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include <array>
+#include <map>
+#include <set>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <stack>
+#include <vector>
+
+#include <typeinfo>
+#include <type_traits>
+
+#include <exception>
+#include <stdexcept>
+
+#include <any>
+#include <source_location>
+#include <optional>
+#include <variant>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if __has_include(<nlohmann/json.hpp>)
+#include <nlohmann/json.hpp>
+#endif
+
+// clang-format on
+
+using DWORD   = unsigned long;
+using DWORD64 = unsigned long long;
+
+namespace big
+{
+	using namespace std::chrono_literals;
+
+	inline std::atomic_bool g_running{true};
+
+	namespace test
+	{
+		// set by benchmarks that would otherwise drown the output in expected warnings
+		inline std::atomic_bool g_mute_log{false};
+	}
+
+	// LOG(LEVEL) << ... writes a line to stderr, VERBOSE lines are dropped
+	class test_log_line
+	{
+		bool m_enabled;
+
+	public:
+		explicit test_log_line(const char* level) :
+		    m_enabled(std::strcmp(level, "VERBOSE") && !test::g_mute_log)
+		{
+			if (m_enabled)
+				std::cerr << '[' << level << "] ";
+		}
+
+		~test_log_line()
+		{
+			if (m_enabled)
+				std::cerr << '\n';
+		}
+
+		template<typename T>
+		test_log_line& operator<<(const T& value)
+		{
+			if (m_enabled)
+				std::cerr << value;
+			return *this;
+		}
+
+		test_log_line& operator<<(std::ostream& (*manipulator)(std::ostream&))
+		{
+			if (m_enabled)
+				std::cerr << manipulator;
+			return *this;
+		}
+	};
+}
+
+#define LOG(level) ::big::test_log_line(#level)
+
+#endif
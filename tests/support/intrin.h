@@ -0,0 +1,19 @@
+#pragma once
+// MSVC intrinsics used by the scan kernels, mapped onto their GCC/Clang equivalents.
+#include <cpuid.h>
+#include <immintrin.h>
+
+#undef __cpuid
+
+inline void __cpuid(int regs[4], int leaf)
+{
+	__cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+}
+
+// newer cpuid.h versions ship __cpuidex themselves
+#if !defined(__clang__) && __GNUC__ < 11
+inline void __cpuidex(int regs[4], int leaf, int sub_leaf)
+{
+	__cpuid_count(leaf, sub_leaf, regs[0], regs[1], regs[2], regs[3]);
+}
+#endif
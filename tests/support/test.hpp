@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Minimal check and timing helpers shared by the standalone tests.
+
+namespace big::test
+{
+	inline int g_failures = 0;
+
+	inline int result()
+	{
+		if (g_failures)
+			std::printf("%d check(s) failed\n", g_failures);
+		else
+			std::printf("all checks passed\n");
+
+		return g_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	// Runs func `iterations` times and returns the average wall time per iteration in nanoseconds.
+	template<typename F>
+	double time_ns(F&& func, std::size_t iterations = 1)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i)
+			func();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+	}
+}
+
+#define CHECK(expr)                                                                      \
+	do                                                                                   \
+	{                                                                                    \
+		if (!(expr))                                                                     \
+		{                                                                                \
+			std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr);         \
+			++::big::test::g_failures;                                                   \
+		}                                                                                \
+	} while (false)
+
+#define CHECK_THROWS(expr)                                                               \
+	do                                                                                   \
+	{                                                                                    \
+		bool threw = false;                                                              \
+		try                                                                              \
+		{                                                                                \
+			(void)(expr);                                                                \
+		}                                                                                \
+		catch (...)                                                                      \
+		{                                                                                \
+			threw = true;                                                                \
+		}                                                                                \
+		if (!threw)                                                                      \
+		{                                                                                \
+			std::printf("%s:%d: expected an exception: %s\n", __FILE__, __LINE__, #expr); \
+			++::big::test::g_failures;                                                   \
+		}                                                                                \
+	} while (false)
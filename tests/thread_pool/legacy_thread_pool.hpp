@@ -0,0 +1,111 @@
+#pragma once
+
+// The thread pool as it was before the work-stealing rewrite: one mutex guarded LIFO stack,
+// notify_all on every push and one thread added at a time. Only kept as the benchmark baseline.
+
+namespace big
+{
+	class legacy_thread_pool
+	{
+		struct job
+		{
+			std::function<void()> m_func;
+			std::source_location m_source_location;
+		};
+
+		std::atomic<bool> m_accept_jobs;
+		std::condition_variable m_data_condition;
+
+		std::stack<job> m_job_stack;
+		std::mutex m_lock;
+		std::vector<std::thread> m_thread_pool;
+
+		std::atomic<size_t> m_allocated_thread_count;
+		std::atomic<size_t> m_busy_threads;
+
+	public:
+		legacy_thread_pool(const std::size_t preallocated_thread_count = 4) :
+		    m_accept_jobs(true),
+		    m_allocated_thread_count(preallocated_thread_count),
+		    m_busy_threads(0)
+		{
+			rescale_thread_pool();
+		}
+
+		void destroy()
+		{
+			{
+				std::unique_lock lock(m_lock);
+				m_accept_jobs = false;
+			}
+			m_data_condition.notify_all();
+
+			for (auto& thread : m_thread_pool)
+				thread.join();
+
+			m_thread_pool.clear();
+		}
+
+		void push(std::function<void()> func, std::source_location location = std::source_location::current())
+		{
+			if (func)
+			{
+				{
+					std::unique_lock lock(m_lock);
+					m_job_stack.push({func, location});
+
+					if (m_allocated_thread_count - m_busy_threads < m_job_stack.size()) [[unlikely]]
+					{
+						if (m_accept_jobs && m_allocated_thread_count + 1 <= MAX_POOL_SIZE)
+						{
+							++m_allocated_thread_count;
+							rescale_thread_pool();
+						}
+					}
+				}
+				m_data_condition.notify_all();
+			}
+		}
+
+		std::pair<size_t, size_t> usage() const
+		{ return { m_busy_threads, m_allocated_thread_count }; }
+
+	private:
+		void run()
+		{
+			for (;;)
+			{
+				std::unique_lock lock(m_lock);
+				m_data_condition.wait(lock, [this]() {
+					return !m_job_stack.empty() || !m_accept_jobs;
+				});
+
+				if (!m_accept_jobs) [[unlikely]]
+					break;
+				if (m_job_stack.empty()) [[likely]]
+					continue;
+
+				job job = m_job_stack.top();
+				m_job_stack.pop();
+				lock.unlock();
+
+				++m_busy_threads;
+				try
+				{
+					std::invoke(job.m_func);
+				}
+				catch (const std::exception&)
+				{
+				}
+				--m_busy_threads;
+			}
+		}
+
+		void rescale_thread_pool()
+		{
+			m_thread_pool.reserve(m_allocated_thread_count);
+			for (auto i = m_thread_pool.size(); i < m_allocated_thread_count; i++)
+				m_thread_pool.emplace_back(std::thread(&legacy_thread_pool::run, this));
+		}
+	};
+}
@@ -0,0 +1,171 @@
+// Compares push-to-run latency and throughput of the work-stealing thread_pool against the pool it replaced,
+// and checks futures, continuations and exception handling of the new one.
+
+#include "thread_pool.hpp"
+#include "legacy_thread_pool.hpp"
+#include "test.hpp"
+
+using namespace big;
+using clock_type = std::chrono::steady_clock;
+
+static void wait_for(const std::atomic<size_t>& counter, size_t value)
+{
+	while (counter.load(std::memory_order_acquire) < value)
+		std::this_thread::yield();
+}
+
+// Pushes one job at a time into an idle pool and measures how long it takes to start running.
+template<typename pool_t>
+static std::pair<double, double> push_to_run_latency(pool_t& pool)
+{
+	constexpr size_t SAMPLES = 2000;
+
+	std::vector<double> samples;
+	samples.reserve(SAMPLES);
+	for (size_t i = 0; i < SAMPLES; ++i)
+	{
+		std::atomic<clock_type::rep> started{0};
+
+		const auto pushed = clock_type::now();
+		pool.push([&started] {
+			started.store(clock_type::now().time_since_epoch().count(), std::memory_order_release);
+		});
+		while (!started.load(std::memory_order_acquire))
+			std::this_thread::yield();
+
+		samples.push_back(std::chrono::duration<double, std::micro>(clock_type::duration(started.load()) - pushed.time_since_epoch()).count());
+
+		// let the workers go back to sleep so every sample includes the wakeup
+		std::this_thread::sleep_for(50us);
+	}
+
+	std::sort(samples.begin(), samples.end());
+	double sum = 0;
+	for (auto sample : samples)
+		sum += sample;
+
+	return {sum / SAMPLES, samples[SAMPLES * 99 / 100]};
+}
+
+// Tiny jobs pushed from outside the pool in bursts.
+template<typename pool_t>
+static double external_throughput(pool_t& pool)
+{
+	constexpr size_t JOBS = 200'000;
+	constexpr size_t BURST = 256;
+
+	std::atomic<size_t> done{0};
+	const auto ns = test::time_ns([&] {
+		for (size_t i = 0; i < JOBS; i += BURST)
+		{
+			for (size_t j = 0; j < BURST; ++j)
+				pool.push([&done] {
+					done.fetch_add(1, std::memory_order_release);
+				});
+			wait_for(done, i + BURST);
+		}
+	});
+
+	return JOBS / (ns / 1e9);
+}
+
+// Jobs that fan out into more jobs from inside the pool.
+template<typename pool_t>
+static double nested_throughput(pool_t& pool)
+{
+	constexpr size_t OUTER = 64;
+	constexpr size_t INNER = 1024;
+
+	std::atomic<size_t> done{0};
+	const auto ns = test::time_ns([&] {
+		for (size_t i = 0; i < OUTER; ++i)
+			pool.push([&pool, &done] {
+				for (size_t j = 0; j < INNER; ++j)
+					pool.push([&done] {
+						done.fetch_add(1, std::memory_order_release);
+					});
+			});
+		wait_for(done, OUTER * INNER);
+	});
+
+	return OUTER * INNER / (ns / 1e9);
+}
+
+template<typename pool_t>
+static void benchmark(const char* name, pool_t& pool)
+{
+	const auto [latency_avg, latency_p99] = push_to_run_latency(pool);
+	const auto external                   = external_throughput(pool);
+	const auto nested                     = nested_throughput(pool);
+
+	std::printf("%-14s %10.1f %10.1f %14.0f %14.0f %8zu\n", name, latency_avg, latency_p99, external, nested, pool.usage().second);
+}
+
+static void check_results(thread_pool& pool)
+{
+	std::vector<std::future<int>> futures;
+	for (int i = 0; i < 1000; ++i)
+		futures.push_back(pool.push([i] {
+			return i;
+		}));
+
+	int sum = 0;
+	for (auto& future : futures)
+		sum += future.get();
+	CHECK(sum == 999 * 1000 / 2);
+
+	auto chained = pool.push(
+	    [] {
+		    return 21;
+	    },
+	    [](int value) {
+		    return value * 2;
+	    });
+	CHECK(chained.get() == 42);
+
+	auto failing = pool.push([]() -> int {
+		throw std::runtime_error("job failed");
+	});
+	CHECK_THROWS(failing.get());
+
+	// anything thrown has to end up in the future instead of taking the worker down
+	auto failing_unknown = pool.push([] {
+		throw 5;
+	});
+	CHECK_THROWS(failing_unknown.get());
+
+	auto failing_continuation = pool.push([] {}, []() -> int {
+		throw 5;
+	});
+	CHECK_THROWS(failing_continuation.get());
+
+	CHECK(pool.push([] {
+		return 1;
+	}).get() == 1);
+}
+
+int main()
+{
+	{
+		thread_pool pool;
+		check_results(pool);
+		pool.destroy();
+	}
+
+	// both pools grow while bursts are queued and warn about it, which isn't what's being measured
+	test::g_mute_log = true;
+
+	std::printf("%-14s %10s %10s %14s %14s %8s\n", "pool", "avg us", "p99 us", "external/s", "nested/s", "threads");
+	{
+		legacy_thread_pool pool;
+		benchmark("legacy", pool);
+		pool.destroy();
+	}
+	{
+		thread_pool pool;
+		benchmark("work-stealing", pool);
+		pool.destroy();
+	}
+
+	return test::result();
+}